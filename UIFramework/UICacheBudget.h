@@ -0,0 +1,92 @@
+/* mbed
+ * Copyright (c) 2006-2015 ARM Limited
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#ifndef __UICACHEBUDGET_H__
+#define __UICACHEBUDGET_H__
+
+#include <stdint.h>
+
+class UICellCache;
+
+/**
+ * @brief Memory budget shared by the cell caches of one or more tables.
+ * @details Each cache adds the bytes its cells retain, as reported by
+ *          UIView::getRetainedBytes, together with the cells in its
+ *          UICellPool, and drops pooled cells and then its least recently
+ *          used cells while the total is over the limit. Sharing one budget
+ *          between all tables in a UIViewStack bounds the memory held by
+ *          cached cells, whatever mix of cells the tables show. A cache
+ *          that cannot get under the limit by itself makes the other
+ *          caches give up cells outside their visible rows, so tables in
+ *          the background do not hold on to the budget.
+ */
+class UICacheBudget
+{
+public:
+    /**
+     * @brief Create budget.
+     *
+     * @param limit Bytes the caches may retain in total.
+     */
+    UICacheBudget(uint32_t limit);
+
+    void setLimit(uint32_t limit);
+    uint32_t getLimit(void) const;
+
+    /**
+     * @brief Bytes currently retained by all caches.
+     */
+    uint32_t getUsed(void) const;
+
+    /**
+     * @brief Highest number of bytes retained since the last reset.
+     */
+    uint32_t getPeak(void) const;
+    void resetPeak(void);
+
+    /**
+     * @brief Are the caches retaining more than the limit.
+     */
+    bool isExceeded(void) const;
+
+    /**
+     * @brief Account for bytes retained or released by a cache.
+     */
+    void add(uint32_t bytes);
+    void remove(uint32_t bytes);
+
+    /**
+     * @brief Caches sharing the budget.
+     */
+    void attach(UICellCache* cache);
+    void detach(UICellCache* cache);
+
+    /**
+     * @brief Shrink the caches other than the given one while the budget
+     *        is exceeded.
+     */
+    void reclaim(UICellCache* requester);
+
+private:
+    /* attached caches, linked through UICellCache::nextInBudget */
+    UICellCache* caches;
+
+    uint32_t limit;
+    uint32_t used;
+    uint32_t peak;
+};
+
+#endif // __UICACHEBUDGET_H__
@@ -0,0 +1,204 @@
+/* mbed
+ * Copyright (c) 2006-2015 ARM Limited
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#ifndef __UICELLCACHE_H__
+#define __UICELLCACHE_H__
+
+#include "UIFramework/UIView.h"
+#include "UIFramework/UICacheBudget.h"
+#include "UIFramework/UICellPool.h"
+
+#include <stdint.h>
+
+
+#define DEFAULT_CACHE_WAYS 4
+
+
+/**
+ * @brief Set-associative cache of table cells, keyed by row.
+ * @details Rows map to a set by index modulo the number of sets, and within
+ *          a set the least recently used cell is replaced first. With one way
+ *          per set this is the old direct-mapped cache; with as many ways as
+ *          slots it is fully associative.
+ *
+ *          Lookups are counted, so the cache can be sized from the hit rate
+ *          of a real workload.
+ *
+ *          With a UICacheBudget the cache also tracks the bytes its cells
+ *          retain, and trim() evicts the least recently used cells of the
+ *          whole cache while the budget is exceeded.
+ */
+class UICellCache
+{
+public:
+    /**
+     * @brief Create cache.
+     *
+     * @param size Number of cells held.
+     * @param ways Cells per set. Rounded up so all slots are used.
+     */
+    UICellCache(uint32_t size, uint32_t ways = DEFAULT_CACHE_WAYS);
+    ~UICellCache(void);
+
+    /**
+     * @brief Valid cell for the row, or a NULL pointer.
+     * @details Counted as a hit, a miss, or a refetch when the cached cell
+     *          has been invalidated. Hits become the most recently used.
+     */
+    SharedPointer<UIView>& lookup(uint32_t index);
+
+    /**
+     * @brief Cached cell for the row, or a NULL pointer, whether valid or not.
+     * @details Neither counted nor marked as used.
+     */
+    SharedPointer<UIView>& peek(uint32_t index);
+
+    /**
+     * @brief Store cell for the row, replacing the least recently used cell
+     *        of its set when the set is full.
+     *
+     * @param prefetched Cell was fetched ahead of being drawn. If it leaves
+     *                   the cache without being looked up, it was wasted.
+     */
+    void insert(uint32_t index, SharedPointer<UIView>& cell, bool prefetched = false);
+
+    /**
+     * @brief Drop the cell for the row, if cached.
+     */
+    void remove(uint32_t index);
+
+    /**
+     * @brief Drop all cells. Statistics are kept.
+     */
+    void clear(void);
+
+    /**
+     * @brief Move the cells of rows at and after first by delta rows, after
+     *        rows were inserted or deleted in front of them.
+     * @details With a negative delta the cells of the rows
+     *          [first + delta, first) are dropped first, as those rows were
+     *          deleted. Cells whose new set is full replace its least
+     *          recently used cell, or are dropped if they are older.
+     */
+    void shift(uint32_t first, int32_t delta);
+
+    /**
+     * @brief Hand cells leaving the cache to the pool for reuse.
+     *
+     * @param pool Pool, or NULL to drop cells.
+     */
+    void setPool(UICellPool* pool);
+
+    /**
+     * @brief Account the retained bytes of the cells against the budget.
+     *
+     * @param budget Budget, possibly shared with other caches, or a NULL
+     *               pointer to limit the cache by number of cells only.
+     */
+    void setBudget(SharedPointer<UICacheBudget>& budget);
+
+    /**
+     * @brief Read the retained bytes of every cell again, as cells can
+     *        render or release buffers after they are inserted.
+     */
+    void refresh(void);
+
+    /**
+     * @brief Evict the least recently used cells while the budget is
+     *        exceeded, sparing the rows in [keepFirst, keepEnd). If that is
+     *        not enough, the other caches sharing the budget are shrunk.
+     *
+     * @return Number of cells evicted from this cache.
+     */
+    uint32_t trim(uint32_t keepFirst, uint32_t keepEnd);
+
+    /**
+     * @brief Drop pooled cells, then evict the least recently used cells,
+     *        while the budget is exceeded, sparing the rows given to the
+     *        last trim().
+     *
+     * @return Number of cells evicted.
+     */
+    uint32_t shrink(void);
+
+    /**
+     * @brief Bytes retained by the cached cells when last counted.
+     */
+    uint32_t getRetainedBytes(void) const;
+
+    /**
+     * @brief Number of slots, for visiting every cached cell with getSlot.
+     */
+    uint32_t getSize(void) const;
+
+    /**
+     * @brief Cell in the given slot. NULL when the slot is empty.
+     */
+    SharedPointer<UIView>& getSlot(uint32_t slot);
+
+    /**
+     * @brief Cells per set.
+     */
+    uint32_t getWays(void) const;
+
+    /**
+     * @brief Statistics.
+     */
+    uint32_t getHits(void) const;
+    uint32_t getMisses(void) const;
+    uint32_t getEvictions(void) const;
+    uint32_t getRefetches(void) const;
+    uint32_t getWastedPrefetches(void) const;
+    uint32_t getTrimmed(void) const;
+    void resetStatistics(void);
+
+private:
+    friend class UICacheBudget;
+
+    uint32_t findSlot(uint32_t index) const;
+    void release(uint32_t slot);
+    void swapSlots(uint32_t slot, uint32_t other);
+    void account(uint32_t slot);
+
+    uint32_t size;
+    uint32_t sets;
+    uint32_t ways;
+
+    /* per slot */
+    uint32_t* keys;
+    uint32_t* lastUse;
+    bool* unused;
+    uint32_t* bytes;
+    SharedPointer<UIView>* cells;
+
+    uint32_t useCounter;
+    SharedPointer<UIView> none;
+    UICellPool* pool;
+    SharedPointer<UICacheBudget> budget;
+    UICellCache* nextInBudget;
+    uint32_t retainedBytes;
+    uint32_t keepFirst;
+    uint32_t keepEnd;
+
+    uint32_t hits;
+    uint32_t misses;
+    uint32_t evictions;
+    uint32_t refetches;
+    uint32_t wastedPrefetches;
+    uint32_t trimmed;
+};
+
+#endif // __UICELLCACHE_H__
@@ -0,0 +1,126 @@
+/* mbed
+ * Copyright (c) 2006-2015 ARM Limited
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#ifndef __UICELLPOOL_H__
+#define __UICELLPOOL_H__
+
+#include "UIFramework/UIView.h"
+#include "UIFramework/UICacheBudget.h"
+
+#include <stdint.h>
+
+
+#define DEFAULT_POOL_SIZE 4
+
+
+/**
+ * @brief Cells that have left a table's cache, kept for reuse.
+ * @details Instead of allocating a new view, and whatever buffers it owns,
+ *          for every row scrolled into view, a data source can take an
+ *          evicted cell of the same reuse type from the pool and rebind it
+ *          to the new row. Only cells with a reuse type that nothing else
+ *          references are kept; the rest are dropped as before.
+ *
+ *          With a budget, the bytes pooled cells retain are counted with
+ *          the cached cells, and UICellCache::shrink drops pooled cells
+ *          before it evicts cached ones.
+ */
+class UICellPool
+{
+public:
+    /**
+     * @brief Create pool.
+     *
+     * @param capacity Number of cells kept at most.
+     */
+    UICellPool(uint32_t capacity = DEFAULT_POOL_SIZE);
+    ~UICellPool(void);
+
+    /**
+     * @brief Keep the cell for reuse, if it has a reuse type, is not
+     *        referenced elsewhere and the pool has room.
+     *
+     * @return Whether the cell was kept.
+     */
+    bool recycle(SharedPointer<UIView>& cell);
+
+    /**
+     * @brief Take a cell of the given type out of the pool.
+     * @details The cell is valid and marked as changed, see
+     *          UIView::prepareForReuse.
+     *
+     * @return The cell, or a NULL pointer if there is none of that type.
+     */
+    SharedPointer<UIView> dequeue(uint32_t type);
+
+    /**
+     * @brief Drop all cells. Statistics are kept.
+     */
+    void clear(void);
+
+    /**
+     * @brief Drop the cell that was recycled first.
+     *
+     * @return Whether there was a cell to drop.
+     */
+    bool drop(void);
+
+    /**
+     * @brief Account the retained bytes of pooled cells against the budget.
+     *        Set by the cache the pool is attached to.
+     *
+     * @param budget Budget, or a NULL pointer.
+     */
+    void setBudget(SharedPointer<UICacheBudget>& budget);
+
+    /**
+     * @brief Bytes retained by the pooled cells, counted when they were
+     *        recycled.
+     */
+    uint32_t getRetainedBytes(void) const;
+
+    /**
+     * @brief Number of cells in the pool.
+     */
+    uint32_t getSize(void) const;
+
+    uint32_t getCapacity(void) const;
+
+    /**
+     * @brief Statistics.
+     */
+    uint32_t getRecycled(void) const;
+    uint32_t getReused(void) const;
+    uint32_t getDropped(void) const;
+    void resetStatistics(void);
+
+private:
+    void removeAt(uint32_t index);
+
+    SharedPointer<UIView>* cells;
+    uint32_t* bytes;
+    uint32_t capacity;
+    uint32_t size;
+
+    SharedPointer<UICacheBudget> budget;
+    uint32_t retainedBytes;
+
+    uint32_t recycled;
+    uint32_t reused;
+    uint32_t dropped;
+};
+
+#endif // __UICELLPOOL_H__
@@ -0,0 +1,108 @@
+/* mbed
+ * Copyright (c) 2006-2015 ARM Limited
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#ifndef __UICLOCK_H__
+#define __UICLOCK_H__
+
+#include <stdint.h>
+
+
+/**
+ * @brief Monotonic microsecond clock shared by the views and the framework.
+ * @details Time is a free running 32-bit microsecond counter that wraps
+ *          roughly every 71 minutes. Always compare times through elapsed()
+ *          and isBefore(), which are correct across the wrap as long as the
+ *          two times are less than 35 minutes apart.
+ *
+ *          On mbed targets the counter is the us_ticker, on host builds it is
+ *          the scheduler's virtual clock. Either can be replaced, e.g. by a
+ *          virtual clock that a test advances by hand.
+ */
+class UIClock
+{
+public:
+    typedef uint32_t (*source_t)(void);
+
+    /**
+     * @brief Current time in microseconds.
+     */
+    static uint32_t getTime(void);
+
+    /**
+     * @brief Current time in milliseconds.
+     * @details Derived from the microsecond counter without resetting at its
+     *          wrap, so the result is monotonic as long as it is read at
+     *          least once per wrap of the microsecond counter. Wraps after
+     *          roughly 49 days.
+     */
+    static uint32_t getTimeInMilliseconds(void);
+
+    /**
+     * @brief Microseconds elapsed since the given time.
+     */
+    static uint32_t elapsed(uint32_t since)
+    {
+        return getTime() - since;
+    }
+
+    /**
+     * @brief Microseconds from one time to another, modulo the wrap.
+     */
+    static uint32_t elapsed(uint32_t from, uint32_t to)
+    {
+        return to - from;
+    }
+
+    /**
+     * @brief Is time a before time b.
+     */
+    static bool isBefore(uint32_t a, uint32_t b)
+    {
+        return (int32_t)(a - b) < 0;
+    }
+
+    /**
+     * @brief Has the deadline been reached.
+     */
+    static bool hasPassed(uint32_t deadline)
+    {
+        return !isBefore(getTime(), deadline);
+    }
+
+    /**
+     * @brief Replace the time source.
+     *
+     * @param source Function returning a 32-bit microsecond counter,
+     *               NULL restores the platform source.
+     */
+    static void setSource(source_t source);
+
+    /**
+     * @brief Switch to a virtual clock that only moves when advanced.
+     *
+     * @param time Start time in microseconds.
+     */
+    static void setVirtualTime(uint32_t time);
+
+    /**
+     * @brief Advance the virtual clock.
+     *
+     * @param time Microseconds to advance.
+     */
+    static void advanceVirtualTime(uint32_t time);
+};
+
+#endif // __UICLOCK_H__
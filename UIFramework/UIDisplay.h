@@ -0,0 +1,143 @@
+/* mbed
+ * Copyright (c) 2006-2015 ARM Limited
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#ifndef __UIDISPLAY_H__
+#define __UIDISPLAY_H__
+
+#include "UIFramework/UIPlatform.h"
+
+#include "core-util/FunctionPointer.h"
+#include "core-util/SharedPointer.h"
+
+#include "uif-framebuffer/FrameBuffer.h"
+
+using namespace mbed::util;
+using namespace uif;
+
+/**
+ * @brief Display interface used by UIFramework.
+ * @details Abstracts the screen the rendered frame buffers are sent to.
+ */
+class UIDisplay
+{
+public:
+    /**
+     * @brief Optional destructor.
+     */
+    virtual ~UIDisplay(void) { };
+
+    /**
+     * @brief Get frame buffer not currently in use by the display.
+     * @details Called for every frame. The buffer must not be one that is
+     *          being sent, or one that was handed out for a frame that has
+     *          not been sent yet.
+     *
+     * @return FrameBuffer-object wrapped inside a SharedPointer.
+     */
+    virtual SharedPointer<FrameBuffer> getFrameBuffer(void) = 0;
+
+    /**
+     * @brief Number of distinct frame buffers the display hands out.
+     * @details Limits how many frames can be rendered ahead of the
+     *          display. With two buffers, a frame can be rendered while the
+     *          previous one is being sent.
+     *
+     * @return Number of buffers.
+     */
+    virtual uint32_t getBufferCount(void) const
+    {
+        return 1;
+    }
+
+    /**
+     * @brief Transfer the entire frame buffer to the display.
+     *
+     * @param buffer FrameBuffer-object to transfer.
+     * @param onStart Callback for when the transfer has started. Can be NULL.
+     * @param onFinish Callback for when the transfer has completed.
+     */
+    virtual void sendFrameBuffer(SharedPointer<FrameBuffer>& buffer,
+                                 FunctionPointer onStart,
+                                 FunctionPointer onFinish) = 0;
+
+    /**
+     * @brief Transfer selected lines of the frame buffer to the display.
+     * @details Memory LCDs are addressed line by line so only the lines that
+     *          have changed need to be sent. Displays that cannot address
+     *          individual lines send the entire frame buffer instead.
+     *
+     * @param buffer FrameBuffer-object to transfer.
+     * @param lines Bitmap with one bit per line, LSB first. The bitmap is only
+     *              valid for the duration of the call.
+     * @param onStart Callback for when the transfer has started. Can be NULL.
+     * @param onFinish Callback for when the transfer has completed.
+     */
+    virtual void sendFrameBufferLines(SharedPointer<FrameBuffer>& buffer,
+                                      const uint8_t* lines,
+                                      FunctionPointer onStart,
+                                      FunctionPointer onFinish)
+    {
+        (void) lines;
+
+        sendFrameBuffer(buffer, onStart, onFinish);
+    }
+
+    /**
+     * @brief Whether sendFrameBufferLines only sends the selected lines.
+     *
+     * @return True if individual lines are sent, false if the entire frame
+     *         buffer is sent instead.
+     */
+    virtual bool canSendLines(void) const
+    {
+        return false;
+    }
+
+    /**
+     * @brief Get the memory of one line of the frame buffer.
+     * @details Used to find the lines that changed between frames. Displays
+     *          without direct access to the buffer memory return NULL, and
+     *          frames are then sent without comparing them.
+     *
+     * @param buffer FrameBuffer-object handed out by this display.
+     * @param line Line to get.
+     * @return (width + 7) / 8 bytes of packed pixels, LSB first, or NULL.
+     *         Bits beyond the width of the buffer are undefined.
+     */
+    virtual const uint8_t* getLine(SharedPointer<FrameBuffer>& buffer, uint16_t line) const
+    {
+        (void) buffer;
+        (void) line;
+
+        return NULL;
+    }
+
+    /**
+     * @brief Number of bytes on the wire for transferring the given lines.
+     * @details Default is the memory LCD protocol: one mode byte, an address
+     *          byte and a trailer byte per line, and a final trailer byte.
+     *
+     * @param width Line width in pixels.
+     * @param lines Number of lines transferred.
+     * @return Number of bytes.
+     */
+    virtual uint32_t getTransferSize(uint16_t width, uint32_t lines) const
+    {
+        return 2 + lines * (((width + 7) / 8) + 2);
+    }
+};
+
+#endif // __UIDISPLAY_H__
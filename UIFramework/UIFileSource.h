@@ -0,0 +1,59 @@
+/* mbed
+ * Copyright (c) 2006-2015 ARM Limited
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#ifndef __UIFILESOURCE_H__
+#define __UIFILESOURCE_H__
+
+#include "UIFramework/UIStreamArray.h"
+
+#include <stdio.h>
+
+
+/**
+ * @brief Records read from a file through stdio.
+ * @details Works with any file system mounted on the target, and with
+ *          regular files on the host build.
+ */
+class UIFileSource : public UIStreamArray::Source
+{
+public:
+    /**
+     * @brief Open the file for reading.
+     */
+    UIFileSource(const char* path);
+
+    /**
+     * @brief Read from an open file, which is closed with the source.
+     */
+    UIFileSource(FILE* file);
+
+    virtual ~UIFileSource(void);
+
+    /**
+     * @brief Was the file opened.
+     */
+    bool isOpen(void) const;
+
+    // from UIStreamArray::Source
+    virtual uint32_t getLength(void);
+    virtual uint32_t read(uint32_t offset, uint8_t* buffer, uint32_t length);
+
+private:
+    FILE* file;
+    uint32_t length;
+};
+
+#endif // __UIFILESOURCE_H__
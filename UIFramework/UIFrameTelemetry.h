@@ -0,0 +1,129 @@
+/* mbed
+ * Copyright (c) 2006-2015 ARM Limited
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#ifndef __UIFRAMETELEMETRY_H__
+#define __UIFRAMETELEMETRY_H__
+
+#include <stdint.h>
+
+
+/* number of frames kept in the ring buffer */
+#define TELEMETRY_RING_SIZE 32
+
+/*  Histogram bucket n counts values below (1 << n) milliseconds,
+    the last bucket counts everything else.
+*/
+#define TELEMETRY_HISTOGRAM_BUCKETS 12
+
+
+/**
+ * @brief Per-frame timing records and histograms collected by UIFramework.
+ * @details All storage is fixed-size so telemetry can stay enabled on
+ *          devices in the field.
+ */
+class UIFrameTelemetry
+{
+public:
+    typedef enum {
+        FRAME_COALESCED = 0x01, // more than one wakeup was served by this frame
+        FRAME_DROPPED   = 0x02, // rendering started at least one frame period late,
+                                // not counting time spent waiting for a free buffer
+        FRAME_UNCHANGED = 0x04  // nothing changed, frame was not transferred
+    } flag_t;
+
+    typedef enum {
+        HISTOGRAM_RENDER,
+        HISTOGRAM_TRANSFER,
+        HISTOGRAM_LATENCY,
+        HISTOGRAM_COUNT
+    } histogram_t;
+
+    /**
+     * @brief Timing record for a single frame. Times are in microseconds.
+     */
+    typedef struct {
+        uint32_t sequence;
+        uint32_t renderTime;
+        uint32_t transferTime;
+        uint32_t latency;       // wakeup to end of transfer
+        uint32_t callInterval;  // requested by the view tree, in milliseconds
+        uint16_t wakeups;
+        uint8_t  flags;
+    } frame_t;
+
+    UIFrameTelemetry(void);
+
+    /**
+     * @brief Add completed frame to ring buffer, histograms and counters.
+     *
+     * @param frame Frame record. The sequence number is assigned here.
+     */
+    void addFrame(frame_t& frame);
+
+    /**
+     * @brief Count a wakeup request.
+     */
+    void addWakeup(void);
+
+    /**
+     * @brief Get frame from ring buffer.
+     *
+     * @param age 0 is the most recent frame.
+     * @param frame Frame record to fill in.
+     * @return true if a frame with the given age is in the ring buffer.
+     */
+    bool getFrame(uint32_t age, frame_t& frame) const;
+
+    /**
+     * @brief Get histogram bucket count.
+     *
+     * @param histogram [HISTOGRAM_RENDER, HISTOGRAM_TRANSFER, HISTOGRAM_LATENCY]
+     * @param bucket Bucket index, 0 to TELEMETRY_HISTOGRAM_BUCKETS - 1.
+     * @return Number of frames in bucket.
+     */
+    uint32_t getHistogram(histogram_t histogram, uint32_t bucket) const;
+
+    /**
+     * @brief Get worst value recorded in histogram, in microseconds.
+     */
+    uint32_t getMaximum(histogram_t histogram) const;
+
+    uint32_t getFrames(void) const;
+    uint32_t getDroppedFrames(void) const;
+    uint32_t getCoalescedFrames(void) const;
+    uint32_t getUnchangedFrames(void) const;
+    uint32_t getWakeups(void) const;
+
+    /**
+     * @brief Clear ring buffer, histograms and counters.
+     */
+    void reset(void);
+
+private:
+    void addToHistogram(histogram_t histogram, uint32_t value);
+
+    frame_t ring[TELEMETRY_RING_SIZE];
+    uint32_t histograms[HISTOGRAM_COUNT][TELEMETRY_HISTOGRAM_BUCKETS];
+    uint32_t maximum[HISTOGRAM_COUNT];
+
+    uint32_t frames;
+    uint32_t droppedFrames;
+    uint32_t coalescedFrames;
+    uint32_t unchangedFrames;
+    uint32_t wakeups;
+};
+
+#endif // __UIFRAMETELEMETRY_H__
@@ -17,23 +17,47 @@
 #ifndef __UIFRAMEWORK_H__
 #define __UIFRAMEWORK_H__
 
-#include "mbed-drivers/mbed.h"
+#include "UIFramework/UIPlatform.h"
 
 #include "uif-framebuffer/FrameBuffer.h"
 
+#if !UIF_HOST
 #include "uif-matrixlcd/MatrixLCD.h"
+#endif
+
+#include "UIFramework/UIDisplay.h"
+#include "UIFramework/UIFrameTelemetry.h"
+#include "UIFramework/UISubCanvas.h"
 #include "UIFramework/UIView.h"
 
 
+#define DEFAULT_FRAME_BUFFERS 2
+
+
 class UIFramework
 {
 public:
     /*  Framework for updating screen buffers based on UIView base object
         and transfer the result to the LCD screen.
+
+        Rendering and screen transfer are pipelined through a pool of
+        bufferCount frames. Each frame is rendered into the buffer the
+        screen hands out for it, so the pool is limited by the number of
+        buffers the screen has, see UIDisplay::getBufferCount.
     */
+#if !UIF_HOST
     UIFramework(uif::MatrixLCD& screen,
                 SharedPointer<UIView>& baseView,
-                uint32_t frameLimit = 0);
+                uint32_t frameLimit = 0,
+                uint32_t bufferCount = DEFAULT_FRAME_BUFFERS);
+#endif
+
+    UIFramework(UIDisplay& screen,
+                SharedPointer<UIView>& baseView,
+                uint32_t frameLimit = 0,
+                uint32_t bufferCount = DEFAULT_FRAME_BUFFERS);
+
+    ~UIFramework();
 
     /*  Request screen update.
     */
@@ -44,22 +68,144 @@ public:
     void setFrameLimit(uint32_t limit);
     uint32_t getFrameLimit(void) const;
 
+    /*  Frame timing telemetry. Records render time, transfer time and
+        wakeup-to-screen latency for every frame.
+    */
+    const UIFrameTelemetry& getTelemetry(void) const;
+    void resetTelemetry(void);
+
+    /*  Number of frame buffers in the pool.
+    */
+    uint32_t getBufferCount(void) const;
+
+    /*  Enable/disable dirty line tracking. Disabled by default. When
+        enabled, only the lines that changed since the previous frame are
+        sent to the screen, if the screen can send individual lines, and
+        unchanged frames are not sent at all. Costs a copy of the last
+        frame, one bit per pixel, and a comparison of every line per frame.
+        Has no effect on screens without direct access to their buffer
+        memory, see UIDisplay::getLine.
+    */
+    void setDirtyLineTracking(bool enable);
+    bool getDirtyLineTracking(void) const;
+
+    /*  Enable/disable idle frame elision. Disabled by default. When enabled,
+        wakeups are ignored while the view tree reports no change
+        (UIView::isDirty), so neither rendering nor transfer takes place.
+        Only enable for view trees where every view marks itself dirty when
+        its content changes; a view that animates without doing so stops
+        after one frame.
+    */
+    void setIdleFrameElision(bool enable);
+    bool getIdleFrameElision(void) const;
+
+    /*  Enable/disable partial rendering. Disabled by default. When enabled,
+        only the lines that intersect the area reported by
+        UIView::getDirtyRect are rendered, together with the lines each
+        buffer in the pool has missed. The band is drawn by passing a
+        negative yOffset to the base view, so every view in the tree must
+        honour its offsets. The next wakeup follows the interval returned
+        for the band alone, so animating views must mark their area dirty.
+    */
+    void setPartialRendering(bool enable);
+    bool getPartialRendering(void) const;
+
+    /*  Transfer statistics. Frames without changed lines are counted as
+        rendered but not as transferred. Wakeups skipped because nothing
+        changed are counted as elided. Rendered lines counts the lines drawn
+        by partial and full renders.
+    */
+    uint32_t getRenderedFrames(void) const;
+    uint32_t getTransferredFrames(void) const;
+    uint32_t getTransferredLines(void) const;
+    uint32_t getTransferredBytes(void) const;
+    uint32_t getElidedFrames(void) const;
+    uint32_t getRenderedLines(void) const;
+    void resetStatistics(void);
+
 private:
+    /*  Ownership of a frame buffer in the pool. A buffer is handed from the
+        renderer to the screen when it is READY and back to the renderer
+        when the transfer has finished.
+    */
+    typedef enum {
+        BUFFER_FREE,
+        BUFFER_READY,
+        BUFFER_SENDING
+    } buffer_state_t;
+
+    typedef struct {
+        SharedPointer<FrameBuffer> canvas;
+        buffer_state_t state;
+        uint32_t sequence;
+        bool tracked;
+        uint8_t* dirtyLines;
+        uint32_t dirtyLineCount;
+
+        /* lines that changed since the canvas was last rendered */
+        UIView::Rect damage;
+
+        /* telemetry */
+        UIFrameTelemetry::frame_t frame;
+        uint32_t wakeupTime;
+        uint32_t transferStart;
+    } buffer_t;
+
+    void constructor(uint32_t bufferCount);
     void renderViewToCurrentBuffer(void);
     void copyBufferToScreenDone(void);
     void updateScreen(void);
+    void postRenderTask(void);
+    void transferBuffer(void);
+    void findDirtyLines(buffer_t& buffer);
+    buffer_t* getBuffer(buffer_state_t state);
+    buffer_t* takeCanvas(buffer_t* buffer);
 
 private:
-    uif::MatrixLCD& screen;
+    SharedPointer<UIDisplay> matrixLCD;
+    UIDisplay& screen;
     SharedPointer<UIView> baseView;
 
-    SharedPointer<FrameBuffer> canvas;
+    /* buffer pool */
+    buffer_t* buffers;
+    uint32_t bufferCount;
+    uint32_t bufferSequence;
+    buffer_t* sendingBuffer;
+
+    /* window for partial renders, owned by bandCanvas */
+    UISubCanvas* bandWindow;
+    SharedPointer<FrameBuffer> bandCanvas;
+
+    /* copy of the last frame queued for the screen */
+    uint8_t* lastFrame;
+    uint16_t numberOfLines;
+    uint16_t lineWidth;
+    bool dirtyLineTracking;
+    bool forceAllLines;
+    bool idleFrameElision;
+    bool partialRendering;
+
+    uint32_t renderedFrames;
+    uint32_t transferredFrames;
+    uint32_t transferredLines;
+    uint32_t transferredBytes;
+    uint32_t elidedFrames;
+    uint32_t renderedLines;
+
+    /* telemetry */
+    UIFrameTelemetry telemetry;
+    uint32_t wakeupTime;
+    uint16_t pendingWakeups;
+    uint32_t frameDue;
+    uint32_t framePeriod;
+    bool frameDueValid;
+    uint32_t lastTransferTime;
 
     uint32_t callInterval;
     bool screenBusy;
     bool screenUpdateTaskNotPosted;
     bool renderBufferTaskNotPosted;
-    bool frameReady;
+    bool renderRequested;
 
     uint32_t frameLimit;
 };
@@ -0,0 +1,173 @@
+/* mbed
+ * Copyright (c) 2006-2015 ARM Limited
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#ifndef __UIGRIDVIEW_H__
+#define __UIGRIDVIEW_H__
+
+#include "UIFramework/UIView.h"
+#include "UIFramework/UICellCache.h"
+#include "UIFramework/UIHeightIndex.h"
+#include "UIFramework/UIPrefetchQueue.h"
+#include "UIFramework/UISubCanvas.h"
+
+
+#define DEFAULT_GRID_CACHE_SIZE 32
+#define DEFAULT_GRID_PREFETCH_CELLS 16
+#define DEFAULT_GRID_PREFETCH_TIME_MS 2
+
+
+/**
+ * @brief Grid of cells scrolling in both directions.
+ * @details Cell i of the array is placed in row i / columns, column
+ *          i % columns. Row heights are taken from the first cell of each
+ *          row and column widths from the cells of the first row, so the
+ *          cells line up. With columns set to 0 all cells are placed in one
+ *          row, which makes a horizontal list.
+ *
+ *          Like UITableView, only the cells that intersect the view are
+ *          created and drawn, found through prefix sums of the row heights
+ *          and column widths. Cells are kept in a UICellCache, reused
+ *          through a UICellPool, and the next row or column in the direction
+ *          of scrolling is prefetched between frames.
+ *
+ *          The grid listens to its array, see UIView::Array::Listener.
+ *          Cached cells move along with inserted and deleted cells, and
+ *          updated cells are fetched again. Unlike UITableView the grid has
+ *          no blit scrolling: every visible cell is drawn each frame.
+ */
+class UIGridView : public UIView, public UIView::Array::Listener
+{
+public:
+    /**
+     * @brief Create grid.
+     *
+     * @param array Cells, with their heights and widths.
+     * @param columns Cells per row, 0 for a single row.
+     * @param cacheSize Number of cells cached.
+     * @param cacheWays Cells per cache set.
+     */
+    UIGridView(SharedPointer<UIView::Array>& array,
+               uint32_t columns = 0,
+               uint32_t cacheSize = DEFAULT_GRID_CACHE_SIZE,
+               uint32_t cacheWays = DEFAULT_CACHE_WAYS);
+    ~UIGridView();
+
+    /**
+     * @brief Scroll by the given number of pixels. Negative values move
+     *        towards the end, as with UITableView::scrollPx.
+     */
+    void scrollPx(int32_t x, int32_t y);
+
+    /**
+     * @brief Scroll to the given pixel position of the top left corner.
+     */
+    void setPosition(uint32_t x, uint32_t y);
+    uint32_t getPositionX(void);
+    uint32_t getPositionY(void);
+
+    uint32_t getRows(void);
+    uint32_t getColumns(void);
+
+    /**
+     * @brief Read all sizes again and drop all cells, after the array
+     *        has changed without telling its listeners.
+     */
+    void reloadGrid(void);
+
+    /**
+     * @brief Changes to the array, see UIView::Array::Listener. Row and
+     *        column positions are built again on the next frame, since
+     *        inserting or deleting a cell moves the cells after it to other
+     *        rows and columns.
+     */
+    virtual void rowsInserted(uint32_t first, uint32_t count);
+    virtual void rowsDeleted(uint32_t first, uint32_t count);
+    virtual void rowsUpdated(uint32_t first, uint32_t count);
+
+    /**
+     * @brief Cached cells, the pool of evicted cells and the prefetch queue.
+     */
+    UICellCache& getCellCache(void);
+    UICellPool& getCellPool(void);
+    UIPrefetchQueue& getPrefetchQueue(void);
+
+    /**
+     * @brief Cells drawn, for profiling.
+     */
+    uint32_t getRenderedCells(void) const;
+
+    // UIView
+    virtual uint32_t fillFrameBuffer(SharedPointer<FrameBuffer>& canvas, int16_t xOffset, int16_t yOffset);
+    virtual void setWakeupCallback(FunctionPointer& wakeup);
+    virtual bool isDirty(void);
+    virtual void clearDirty(void);
+    virtual void suspend(void);
+    virtual uint32_t getRetainedBytes(void) const;
+    virtual void setCacheBudget(SharedPointer<UICacheBudget>& budget);
+
+protected:
+    SharedPointer<UIView::Array> array;
+
+private:
+    void updateIndex(void);
+    void cellsMoved(uint32_t first, int32_t delta);
+    void applyScroll(void);
+    void findVisible(uint32_t* firstRow, uint32_t* endRow, uint32_t* firstColumn, uint32_t* endColumn);
+    void updateVisibleRange(uint32_t firstRow, uint32_t endRow, uint32_t firstColumn, uint32_t endColumn);
+    SharedPointer<UIView> getCell(uint32_t index);
+    void fetchCell(uint32_t index);
+    void updatePrefetchWindow(void);
+    void runPrefetchQueue(void);
+
+    uint32_t columns;
+
+    /* pixel position of every row and column */
+    UIHeightIndex rowIndex;
+    UIHeightIndex columnIndex;
+    uint32_t indexedSize;
+
+    /* top left corner, and scrolling not applied yet */
+    uint32_t positionX;
+    uint32_t positionY;
+    int32_t outstandingX;
+    int32_t outstandingY;
+
+    /* distance moved by the last frame, sets the prefetch direction */
+    int32_t velocityX;
+    int32_t velocityY;
+
+    /* cells evicted from the cache, for the array to reuse */
+    UICellPool cellPool;
+    UICellCache cellCache;
+
+    /* reusable window for drawing cells, owned by cellCanvas */
+    UISubCanvas* cellWindow;
+    SharedPointer<FrameBuffer> cellCanvas;
+
+    /* cells in the direction of scrolling waiting to be fetched */
+    UIPrefetchQueue prefetchQueue;
+    minar::callback_handle_t prefetchCallbackHandle;
+
+    /* cells drawn in the last frame, their cells are resumed */
+    uint32_t visibleFirstRow;
+    uint32_t visibleEndRow;
+    uint32_t visibleFirstColumn;
+    uint32_t visibleEndColumn;
+
+    uint32_t renderedCells;
+};
+
+#endif // __UIGRIDVIEW_H__
@@ -0,0 +1,125 @@
+/* mbed
+ * Copyright (c) 2006-2015 ARM Limited
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#ifndef __UIHEIGHTINDEX_H__
+#define __UIHEIGHTINDEX_H__
+
+#include "UIFramework/UIView.h"
+
+#include <stdint.h>
+
+
+/**
+ * @brief Prefix sums of the row heights of a table.
+ * @details Fenwick tree over the heights returned by UIView::Array, so the
+ *          pixel position of a row and the row at a pixel position are found
+ *          in O(log n) instead of by summing every row above it. Building
+ *          the index reads every height once; a changed row is updated in
+ *          O(log n).
+ *
+ *          Arrays with a uniform row height need no tree; positions are
+ *          computed directly until a row is given a different height. This
+ *          also applies when the array does not report a uniform height but
+ *          all rows turn out to have the same height when the index is
+ *          built.
+ *
+ *          Otherwise the tree costs one uint32_t per row, e.g. 20 KB for
+ *          5000 rows, and building it is O(n). Rows added or removed at the
+ *          end cost O(log n) each; elsewhere the rows after them are moved,
+ *          without reading their heights again.
+ */
+class UIHeightIndex
+{
+public:
+    UIHeightIndex(void);
+    ~UIHeightIndex(void);
+
+    /**
+     * @brief Read all row heights from the array.
+     */
+    void build(const UIView::Array& array);
+
+    /**
+     * @brief Add rows [first, first + count), reading only their heights
+     *        from the array. The array must already contain them.
+     */
+    void insert(uint32_t first, uint32_t count, const UIView::Array& array);
+
+    /**
+     * @brief Remove the count rows starting at first.
+     */
+    void remove(uint32_t first, uint32_t count);
+
+    /**
+     * @brief Number of rows in the index.
+     */
+    uint32_t getSize(void) const;
+
+    /**
+     * @brief Change the height of a single row.
+     */
+    void setHeight(uint32_t index, uint32_t height);
+
+    /**
+     * @brief Height of a single row.
+     */
+    uint32_t getHeight(uint32_t index) const;
+
+    /**
+     * @brief Pixel position of the top of the row, i.e. the sum of the
+     *        heights of all rows above it. Indices past the end give the
+     *        total height.
+     */
+    uint32_t getPosition(uint32_t index) const;
+
+    /**
+     * @brief Height shared by all rows, or 0 if rows differ in height.
+     */
+    uint32_t getUniformHeight(void) const;
+
+    /**
+     * @brief Sum of all row heights.
+     */
+    uint32_t getTotalHeight(void) const;
+
+    /**
+     * @brief Row covering the given pixel position.
+     *
+     * @param position Pixel position from the top of the first row.
+     * @param offset Set to the position relative to the top of the row.
+     * @return Index of the last row starting at or above the position. The
+     *         last row is returned for positions past the end.
+     */
+    uint32_t findRow(uint32_t position, uint32_t* offset) const;
+
+private:
+    void allocate(void);
+    void reserve(uint32_t rows);
+    void release(void);
+    void findTopBit(void);
+    void expand(void);
+    void fold(void);
+    void unfold(void);
+
+    /* 1-based Fenwick tree, tree[i] covers rows [i - (i & -i), i) */
+    uint32_t* tree;
+    uint32_t size;
+    uint32_t capacity;
+    uint32_t topBit;
+    uint32_t uniformHeight;
+};
+
+#endif // __UIHEIGHTINDEX_H__
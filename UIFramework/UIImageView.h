@@ -24,11 +24,16 @@ class UIImageView : public UIView
 public:
     UIImageView(const struct CompBuf* image);
 
+    // replace the image, sizing the view to it
+    void setImage(const struct CompBuf* image);
+
     // from UIView
     virtual ~UIImageView();
     virtual uint32_t fillFrameBuffer(SharedPointer<FrameBuffer>& canvas,
                                      int16_t xOffset,
                                      int16_t yOffset);
+    virtual bool isOpaque(void) const;
+    virtual uint32_t getRetainedBytes(void) const;
 
 private:
     const struct CompBuf* image;
@@ -0,0 +1,118 @@
+/* mbed
+ * Copyright (c) 2006-2015 ARM Limited
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#ifndef __UIKINETICPHYSICS_H__
+#define __UIKINETICPHYSICS_H__
+
+#include <stdint.h>
+
+
+/* frame time the speeds and the friction are given in */
+#define KINETIC_FRAME_US 16000
+
+/* integration step, the trajectory is the same for any frame rate */
+#define KINETIC_STEP_US 1000
+
+/* longest stall integrated in one go, the rest is dropped */
+#define KINETIC_MAX_ELAPSED_US 1000000
+
+/* 0.5 ^ (1 / 16) in Q16, halving once per frame in 16 steps */
+#define KINETIC_DECAY_Q16 62757
+
+
+/**
+ * @brief Time stepped scroll physics for kinetic tables.
+ * @details Coasting slows down by a constant friction, and by half per
+ *          frame while outside the bounds, as a rubber band. Snapping
+ *          covers half the remaining distance per frame. Instead of
+ *          applying these once per rendered frame, the motion is
+ *          integrated in fixed 1 ms steps for the time that has passed, in
+ *          Q16 fixed point. The position at any time is therefore the same
+ *          whether frames come quickly, slowly or irregularly, and frames
+ *          can be skipped under load without drifting.
+ *
+ *          Offsets follow UITableView::getPixels, 0 at the top and negative
+ *          further down; movement is returned with the sign of
+ *          UITableView::scrollPx.
+ */
+class UIKineticPhysics
+{
+public:
+    UIKineticPhysics(void);
+
+    /**
+     * @brief Offsets outside of which coasting is damped.
+     *
+     * @param first Offset of the top of the table.
+     * @param last Offset of the bottom of the table, at most first.
+     */
+    void setBounds(int32_t first, int32_t last);
+
+    /**
+     * @brief Loss of speed per frame while coasting, in pixels per frame.
+     */
+    void setFriction(uint32_t friction);
+
+    /**
+     * @brief Start coasting.
+     *
+     * @param speed Pixels per frame.
+     */
+    void fling(int32_t speed);
+
+    /**
+     * @brief Move the given number of pixels, quickly at first and then
+     *        slowing down. Time left over from a coast that ended in the
+     *        last advance is used first.
+     */
+    void snap(int32_t distance);
+
+    /**
+     * @brief Stop all motion, e.g. when the table is touched.
+     */
+    void stop(void);
+
+    /**
+     * @brief Is the table coasting or snapping.
+     */
+    bool isMoving(void) const;
+
+    /**
+     * @brief Integrate the motion over the elapsed time.
+     *
+     * @param elapsed Microseconds since the last call.
+     * @param offset Current offset of the table.
+     * @return Whole pixels to scroll by. Fractions are kept for later.
+     */
+    int32_t advance(uint32_t elapsed, int32_t offset);
+
+    /**
+     * @brief Current coasting speed in pixels per frame.
+     */
+    int32_t getSpeed(void) const;
+
+private:
+    int32_t velocity;   // Q16 pixels per step
+    int32_t remaining;  // Q16 pixels left to snap
+    int32_t residue;    // Q16 fraction of a pixel moved but not returned yet
+    uint32_t pendingUs; // time shorter than a step, integrated later
+    uint32_t spareUs;   // time left when the motion ended in the last advance
+    int32_t first;
+    int32_t last;
+    uint32_t friction;
+};
+
+#endif // __UIKINETICPHYSICS_H__
@@ -0,0 +1,89 @@
+/* mbed
+ * Copyright (c) 2006-2015 ARM Limited
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#ifndef __UILAYERVIEW_H__
+#define __UILAYERVIEW_H__
+
+#include "UIFramework/UIView.h"
+#include "UIFramework/UIMemoryFrameBuffer.h"
+
+
+/*  Retained layer. Keeps the rendered pixels of a cacheable view in an
+    offscreen bitmap and blits them on later frames, so the view is only
+    rendered again after it has changed, e.g. after invalidate().
+
+    While the view is changing it is rendered directly onto the canvas. The
+    bitmap is captured on the first frame the view is unchanged, by
+    rendering it twice onto a white and a black background; pixels that
+    differ were not drawn and are left transparent. Views that are not
+    cacheable are always rendered directly.
+
+    Useful for expensive composite views that rarely change, such as text
+    heavy table cells or nested tables.
+*/
+class UILayerView : public UIView
+{
+public:
+    UILayerView(SharedPointer<UIView>& view);
+    virtual ~UILayerView();
+
+    /*  View rendered by the layer.
+    */
+    SharedPointer<UIView>& getView(void);
+
+    /*  Is the bitmap currently retained.
+    */
+    bool isRetained(void) const;
+
+    /*  Number of times the view has been rendered through the layer.
+    */
+    uint32_t getRenderCount(void) const;
+
+    // from UIView
+    virtual uint32_t fillFrameBuffer(SharedPointer<FrameBuffer>& canvas,
+                                     int16_t xOffset,
+                                     int16_t yOffset);
+    virtual void prefetch(int16_t xOffset, int16_t yOffset);
+    virtual void setWakeupCallback(FunctionPointer& wakeup);
+    virtual void suspend(void);
+    virtual void resume(void);
+    virtual SharedPointer<UIView::Action> getAction(void);
+    virtual bool isOpaque(void) const;
+    virtual bool isDirty(void);
+    virtual UIView::Rect getDirtyRect(void);
+    virtual void clearDirty(void);
+    virtual uint32_t getRetainedBytes(void) const;
+    virtual void setCacheBudget(SharedPointer<UICacheBudget>& budget);
+
+private:
+    void updateView(void);
+    void capture(void);
+    void release(void);
+
+private:
+    SharedPointer<UIView> view;
+
+    /* retained bitmap, mask is NULL when the view covers every pixel */
+    SharedPointer<FrameBuffer> layer;
+    UIMemoryFrameBuffer* layerBuffer;
+    uint8_t* mask;
+    struct CompBuf image;
+
+    uint32_t callInterval;
+    uint32_t renderCount;
+};
+
+#endif // __UILAYERVIEW_H__
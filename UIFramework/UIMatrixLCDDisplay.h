@@ -0,0 +1,50 @@
+/* mbed
+ * Copyright (c) 2006-2015 ARM Limited
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#ifndef __UIMATRIXLCDDISPLAY_H__
+#define __UIMATRIXLCDDISPLAY_H__
+
+#include "UIFramework/UIDisplay.h"
+
+#if !UIF_HOST
+#include "uif-matrixlcd/MatrixLCD.h"
+
+
+/*  UIDisplay adapter for uif::MatrixLCD.
+    The MatrixLCD driver only exposes full frame transfers, so line transfers
+    fall back to sending the whole frame. Frames without changed lines are
+    never sent. The driver is double buffered and hands out the buffer that
+    is not being sent, wrapped in a new FrameBuffer-object every time.
+*/
+class UIMatrixLCDDisplay : public UIDisplay
+{
+public:
+    UIMatrixLCDDisplay(uif::MatrixLCD& screen);
+
+    // from UIDisplay
+    virtual SharedPointer<FrameBuffer> getFrameBuffer(void);
+    virtual uint32_t getBufferCount(void) const;
+    virtual void sendFrameBuffer(SharedPointer<FrameBuffer>& buffer,
+                                 FunctionPointer onStart,
+                                 FunctionPointer onFinish);
+
+private:
+    uif::MatrixLCD& screen;
+};
+
+#endif // !UIF_HOST
+
+#endif // __UIMATRIXLCDDISPLAY_H__
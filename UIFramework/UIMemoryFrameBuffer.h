@@ -0,0 +1,112 @@
+/* mbed
+ * Copyright (c) 2006-2015 ARM Limited
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#ifndef __UIMEMORYFRAMEBUFFER_H__
+#define __UIMEMORYFRAMEBUFFER_H__
+
+#include "UIFramework/UIPlatform.h"
+
+#include "core-util/SharedPointer.h"
+
+#include "uif-framebuffer/FrameBuffer.h"
+
+using namespace mbed::util;
+using namespace uif;
+
+/*  1-bit frame buffer in RAM. Pixels are stored row by row, LSB first,
+    with 1 being white. Sub frame buffers share the memory of the buffer
+    they were created from and must not outlive it.
+*/
+class UIMemoryFrameBuffer : public FrameBuffer
+{
+public:
+    UIMemoryFrameBuffer(uint16_t width, uint16_t height);
+    virtual ~UIMemoryFrameBuffer();
+
+    // from FrameBuffer
+    virtual void drawPixel(uint16_t x, uint16_t y, uint8_t color);
+    virtual uint8_t getPixel(uint16_t x, uint16_t y) const;
+    virtual void drawRectangle(uint16_t x0, uint16_t x1, uint16_t y0, uint16_t y1, uint8_t color);
+    virtual bool drawImage(const struct CompBuf& image, int16_t x, int16_t y, uint8_t rotation);
+    virtual SharedPointer<FrameBuffer> getFrameBuffer(int16_t x, int16_t y, uint16_t width, uint16_t height);
+    virtual uint16_t getWidth(void) const;
+    virtual uint16_t getHeight(void) const;
+
+    /*  Raw access to the pixel memory. The data pointer and stride refer
+        to the root buffer.
+    */
+    uint8_t* getData(void) const;
+    uint16_t getStride(void) const;
+
+    /*  Fill the whole buffer with the given color.
+    */
+    void fill(uint8_t color);
+
+    /*  Move the contents down by the given number of lines, or up if
+        negative. Lines moved into view keep their old contents. Whole lines
+        of memory are moved, so sub frame buffers move the full width of the
+        root buffer.
+    */
+    void scroll(int16_t lines);
+
+#if UIF_HOST
+    /*  Overdraw tracking. Counts pixel writes, and writes to pixels that
+        have already been written since the last reset. Shared with all sub
+        frame buffers.
+    */
+    void setOverdrawTracking(bool enable);
+    void resetOverdraw(void);
+    uint32_t getPixelWrites(void) const;
+    uint32_t getOverdraw(void) const;
+#endif
+
+private:
+    UIMemoryFrameBuffer(const UIMemoryFrameBuffer& parent,
+                        int32_t xOrigin,
+                        int32_t yOrigin,
+                        uint16_t width,
+                        uint16_t height);
+
+    void fillSpan(int32_t row, int32_t xStart, int32_t xEnd, uint8_t color);
+    void track(int32_t row, int32_t xStart, int32_t xEnd);
+    bool clip(int32_t& x0, int32_t& x1, int32_t& y0, int32_t& y1) const;
+
+private:
+    uint8_t* data;
+    bool ownsData;
+    uint16_t stride;
+
+    /* visible area in root coordinates, [x0, x1) x [y0, y1) */
+    int32_t clipX0;
+    int32_t clipX1;
+    int32_t clipY0;
+    int32_t clipY1;
+
+    int32_t xOrigin;
+    int32_t yOrigin;
+    uint16_t width;
+    uint16_t height;
+
+#if UIF_HOST
+    /* one bit per pixel, set when written. Kept by the root buffer */
+    UIMemoryFrameBuffer* root;
+    uint8_t* written;
+    uint32_t pixelWrites;
+    uint32_t overdraw;
+#endif
+};
+
+#endif // __UIMEMORYFRAMEBUFFER_H__
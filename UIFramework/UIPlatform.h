@@ -0,0 +1,44 @@
+/* mbed
+ * Copyright (c) 2006-2015 ARM Limited
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#ifndef __UIPLATFORM_H__
+#define __UIPLATFORM_H__
+
+/*  Platform selection.
+    On mbed targets the framework runs on mbed-drivers and the minar
+    scheduler. On Linux (or when UIF_HOST is defined) a deterministic
+    stand-in for minar with a virtual clock is used instead, so the render
+    paths can be profiled and run under sanitizers on a workstation.
+*/
+#if !defined(UIF_HOST)
+#if defined(TARGET_LIKE_LINUX)
+#define UIF_HOST 1
+#else
+#define UIF_HOST 0
+#endif
+#endif
+
+#if UIF_HOST
+#include "UIFramework/host/HostScheduler.h"
+
+#include <assert.h>
+
+#define MBED_ASSERT(expr) assert(expr)
+#else
+#include "mbed-drivers/mbed.h"
+#endif
+
+#endif // __UIPLATFORM_H__
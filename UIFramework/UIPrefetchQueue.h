@@ -0,0 +1,92 @@
+/* mbed
+ * Copyright (c) 2006-2015 ARM Limited
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#ifndef __UIPREFETCHQUEUE_H__
+#define __UIPREFETCHQUEUE_H__
+
+#include <stdint.h>
+
+
+/**
+ * @brief Queue of table rows waiting to be prefetched.
+ * @details Each row is queued at most once. Rows that leave the range worth
+ *          prefetching are dropped before any work is spent on them. The
+ *          queue is a fixed array, so queueing does not allocate.
+ */
+class UIPrefetchQueue
+{
+public:
+    UIPrefetchQueue(uint32_t capacity);
+    ~UIPrefetchQueue(void);
+
+    /**
+     * @brief Change the number of rows the queue can hold. Queued rows are
+     *        dropped.
+     */
+    void setCapacity(uint32_t capacity);
+
+    /**
+     * @brief Queue row at the back.
+     *
+     * @return False if the row was already queued or the queue is full.
+     */
+    bool push(uint32_t index);
+
+    /**
+     * @brief Take the row at the front.
+     *
+     * @return False if the queue is empty.
+     */
+    bool pop(uint32_t& index);
+
+    /**
+     * @brief Drop queued rows outside [first, end).
+     */
+    void retain(uint32_t first, uint32_t end);
+
+    /**
+     * @brief Drop all queued rows.
+     */
+    void clear(void);
+
+    /**
+     * @brief Number of queued rows.
+     */
+    uint32_t getDepth(void) const;
+
+    /**
+     * @brief Statistics: deepest the queue has been, rows queued, rows
+     *        ignored because they were queued already, and rows dropped
+     *        without being prefetched.
+     */
+    uint32_t getMaxDepth(void) const;
+    uint32_t getPushed(void) const;
+    uint32_t getDuplicates(void) const;
+    uint32_t getDropped(void) const;
+    void resetStatistics(void);
+
+private:
+    uint32_t* rows;
+    uint32_t capacity;
+    uint32_t depth;
+
+    uint32_t maxDepth;
+    uint32_t pushed;
+    uint32_t duplicates;
+    uint32_t dropped;
+};
+
+#endif // __UIPREFETCHQUEUE_H__
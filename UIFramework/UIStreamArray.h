@@ -0,0 +1,157 @@
+/* mbed
+ * Copyright (c) 2006-2015 ARM Limited
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#ifndef __UISTREAMARRAY_H__
+#define __UISTREAMARRAY_H__
+
+#include "UIFramework/UIView.h"
+
+#include "uif-tools-1bit/font.h"
+
+#include <stdint.h>
+
+
+#define DEFAULT_STREAM_INDEX_STRIDE 64
+#define DEFAULT_STREAM_BLOCK_SIZE 512
+#define DEFAULT_STREAM_RECORD_LENGTH 64
+#define STREAM_BLOCKS 2
+#define STREAM_CELL_REUSE_TYPE 1
+
+
+/**
+ * @brief Table contents read on demand from a file of text records.
+ * @details Records are lines, separated by '\n'. Instead of keeping every
+ *          record in RAM, the array keeps the offset of every stride-th
+ *          record and reads the file in blocks through a small cache, so
+ *          only the rows a table asks for are read and turned into views.
+ *          Memory use is one index entry per stride records plus the block
+ *          cache, however far the table scrolls.
+ *
+ *          Finding a record scans at most stride - 1 records from the
+ *          nearest index entry. Consecutive records, as fetched by a
+ *          scrolling table, continue from the end of the previous one.
+ */
+class UIStreamArray : public UIView::Array
+{
+public:
+    /**
+     * @brief Block device, file or memory holding the records.
+     */
+    class Source
+    {
+    public:
+        virtual ~Source(void) { };
+
+        /**
+         * @brief Number of bytes in the source.
+         */
+        virtual uint32_t getLength(void) = 0;
+
+        /**
+         * @brief Read bytes from the source.
+         *
+         * @param offset Byte offset to read from.
+         * @param buffer Buffer to fill.
+         * @param length Number of bytes to read.
+         * @return Number of bytes read.
+         */
+        virtual uint32_t read(uint32_t offset, uint8_t* buffer, uint32_t length) = 0;
+    };
+
+    /**
+     * @brief Index the records in the source.
+     * @details Reads the source once, block by block.
+     *
+     * @param source Records separated by '\n'.
+     * @param font Font used for the text cells.
+     * @param rowHeight Height of every row.
+     * @param rowWidth Width of every row.
+     * @param title Table title.
+     * @param stride Number of records per index entry.
+     */
+    UIStreamArray(SharedPointer<Source>& source,
+                  const struct FontData* font,
+                  uint32_t rowHeight,
+                  uint32_t rowWidth,
+                  const char* title = NULL,
+                  uint32_t stride = DEFAULT_STREAM_INDEX_STRIDE);
+
+    virtual ~UIStreamArray(void);
+
+    /**
+     * @brief Copy a record into the buffer.
+     * @details Records longer than the buffer are cut off. The buffer is
+     *          always zero terminated.
+     *
+     * @return Number of characters copied, not counting the terminator.
+     */
+    uint32_t getRecord(uint32_t index, char* buffer, uint32_t length) const;
+
+    /**
+     * @brief Bytes used by the record index.
+     */
+    uint32_t getIndexBytes(void) const;
+
+    /**
+     * @brief Statistics.
+     */
+    uint32_t getBlockReads(void) const;
+    uint32_t getScannedRecords(void) const;
+
+    // from UIView::Array
+    virtual uint32_t getSize(void) const;
+    virtual SharedPointer<UIView> viewAtIndex(uint32_t index) const;
+    virtual SharedPointer<UIView> viewAtIndex(uint32_t index, UICellPool& pool) const;
+    virtual uint32_t heightAtIndex(uint32_t index) const;
+    virtual uint32_t widthAtIndex(uint32_t index) const;
+    virtual uint32_t getUniformHeight(void) const;
+    virtual const char* getTitle(void) const;
+
+private:
+    void buildIndex(void);
+    uint32_t findRecord(uint32_t index) const;
+    const uint8_t* getBlock(uint32_t offset, uint32_t* valid) const;
+
+    SharedPointer<Source> source;
+    const struct FontData* font;
+    uint32_t rowHeight;
+    uint32_t rowWidth;
+    const char* title;
+    uint32_t stride;
+
+    uint32_t length;
+    uint32_t records;
+
+    /* offset of every stride-th record */
+    uint32_t* index;
+    uint32_t indexSize;
+
+    /* blocks read from the source, least recently used is replaced */
+    mutable uint8_t blocks[STREAM_BLOCKS][DEFAULT_STREAM_BLOCK_SIZE];
+    mutable uint32_t blockOffset[STREAM_BLOCKS];
+    mutable uint32_t blockValid[STREAM_BLOCKS];
+    mutable uint32_t blockUsed[STREAM_BLOCKS];
+    mutable uint32_t blockClock;
+
+    /* record following the last one read, and where it starts */
+    mutable uint32_t cursorRecord;
+    mutable uint32_t cursorOffset;
+
+    mutable uint32_t blockReads;
+    mutable uint32_t scannedRecords;
+};
+
+#endif // __UISTREAMARRAY_H__
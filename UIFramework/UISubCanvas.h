@@ -0,0 +1,71 @@
+/* mbed
+ * Copyright (c) 2006-2015 ARM Limited
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#ifndef __UISUBCANVAS_H__
+#define __UISUBCANVAS_H__
+
+#include "core-util/SharedPointer.h"
+
+#include "uif-framebuffer/FrameBuffer.h"
+
+using namespace mbed::util;
+using namespace uif;
+
+/*  Clipped window onto a parent frame buffer. Drawing is translated by the
+    window origin and cut off at the window edges.
+
+    Unlike FrameBuffer::getFrameBuffer a sub canvas does not allocate: a
+    container keeps one for its children and moves it with setWindow before
+    each child is drawn. The window is only valid while the parent is, so
+    views must not keep the canvas they are given beyond fillFrameBuffer.
+
+    Windows starting above or left of the parent are cut off at its edge,
+    as with getFrameBuffer. Views account for the part that is cut off
+    through their offsets. Windows are also cut off at the right and
+    bottom edges of the parent, so the parent does not need to clip.
+*/
+class UISubCanvas : public FrameBuffer
+{
+public:
+    UISubCanvas();
+
+    /*  Point the window at the given area of the parent.
+    */
+    void setWindow(FrameBuffer* parent, int16_t x, int16_t y, uint16_t width, uint16_t height);
+
+    /*  Detach from the parent. Drawing is ignored until the next setWindow.
+    */
+    void clearWindow(void);
+
+    // from FrameBuffer
+    virtual void drawPixel(uint16_t x, uint16_t y, uint8_t color);
+    virtual uint8_t getPixel(uint16_t x, uint16_t y) const;
+    virtual void drawRectangle(uint16_t x0, uint16_t x1, uint16_t y0, uint16_t y1, uint8_t color);
+    virtual bool drawImage(const struct CompBuf& image, int16_t x, int16_t y, uint8_t rotation);
+    virtual SharedPointer<FrameBuffer> getFrameBuffer(int16_t x, int16_t y, uint16_t width, uint16_t height);
+    virtual uint16_t getWidth(void) const;
+    virtual uint16_t getHeight(void) const;
+
+private:
+    FrameBuffer* parent;
+
+    int16_t xOrigin;
+    int16_t yOrigin;
+    uint16_t width;
+    uint16_t height;
+};
+
+#endif // __UISUBCANVAS_H__
@@ -19,6 +19,7 @@
 #define __UITABLEKINETICVIEW_H__
 
 #include "UIFramework/UITableView.h"
+#include "UIFramework/UIKineticPhysics.h"
 
 
 class UITableKineticView : public UITableView
@@ -27,7 +28,8 @@ public:
     UITableKineticView(SharedPointer<UIView::Array>& table,
                        uint32_t width,
                        uint32_t height,
-                       int32_t  offset);
+                       int32_t  offset,
+                       uint32_t cacheSize = DEFAULT_CACHE_SIZE);
 
     void sliderPressed();
 
@@ -41,18 +43,26 @@ public:
     virtual uint32_t fillFrameBuffer(SharedPointer<FrameBuffer>& buffer,
                                      int16_t xOffset,
                                      int16_t yOffset);
+    virtual bool isDirty(void);
+    virtual UIView::Rect getDirtyRect(void);
 
 protected:
     uint32_t friction;
 
 private:
     bool findMagnetism();
+    bool isMoving();
+    void startMotion();
+    void move(int32_t pixels);
 
 private:
     int32_t magnetism;
-    int32_t coasting;
     bool sliderNotPressed;
 
+    /* coasting and snapping, integrated over the time since frameTime */
+    UIKineticPhysics physics;
+    uint32_t frameTime;
+
     /* offsets are always negative because the screen coordinate system is opposite the table coordinate system */
     int32_t firstOffset;
     int32_t lastOffset;
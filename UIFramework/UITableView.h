@@ -18,15 +18,27 @@
 #define __UITABLEVIEW_H__
 
 #include "UIFramework/UIView.h"
+#include "UIFramework/UICellCache.h"
+#include "UIFramework/UIHeightIndex.h"
+#include "UIFramework/UIMemoryFrameBuffer.h"
+#include "UIFramework/UIPrefetchQueue.h"
+#include "UIFramework/UISubCanvas.h"
 
 
 #define DEFAULT_CACHE_SIZE 10
+#define DEFAULT_PREFETCH_ROWS 8
+#define DEFAULT_PREFETCH_TIME_MS 2
+#define PREFETCH_LOOKAHEAD_FRAMES 2
+#define FETCH_BATCH_ROWS 4
+#define LAYOUT_SLOTS 3
 
 
-class UITableView : public UIView
+class UITableView : public UIView, public UIView::Array::Listener
 {
 public:
-    UITableView(SharedPointer<UIView::Array>& table, uint32_t cacheSize = DEFAULT_CACHE_SIZE);
+    UITableView(SharedPointer<UIView::Array>& table,
+                uint32_t cacheSize = DEFAULT_CACHE_SIZE,
+                uint32_t cacheWays = DEFAULT_CACHE_WAYS);
     ~UITableView();
 
     void scrollPx(int32_t speed);
@@ -45,29 +57,143 @@ public:
     void setPixels(int32_t pixels);
     int32_t getPixels();
 
+    void reloadRow(uint32_t index);
+    void reloadTable();
+
+    /* cached cells and their hit statistics */
+    UICellCache& getCellCache();
+
+    /* evicted cells for the table-object to reuse, see UIView::Array */
+    UICellPool& getCellPool();
+
+    /*  Scroll speed in pixels per frame, with the sign used by scrollPx.
+        Rows are prefetched further ahead in the direction of scrolling.
+    */
+    void setScrollVelocity(int32_t pixelsPerFrame);
+
+    /*  Limit prefetching to the given number of rows on either side of the
+        visible rows, and to the given time per scheduler slot. Zero rows
+        turns prefetching off.
+    */
+    void setPrefetchBudget(uint32_t rows, uint32_t timeInMilliseconds);
+
+    /* rows waiting to be prefetched and their statistics */
+    UIPrefetchQueue& getPrefetchQueue();
+
+    /*  Keep the drawn rows in a layer the size of the table and move them
+        when scrolling, so only the rows scrolled into view and the cells
+        that changed are drawn. Costs one bit per pixel of the table.
+    */
+    void setBlitScrolling(bool enable);
+    bool getBlitScrolling(void) const;
+
+    /* lines drawn by cells and background, for profiling */
+    uint32_t getRenderedLines(void) const;
+
+    /* row lookups by pixel distance that missed the layout cache, for profiling */
+    uint32_t getLayoutPasses(void) const;
+
+    /*  Changes to the table-object, see UIView::Array::Listener. Cached
+        cells move with their rows, and rows inserted or deleted above the
+        visible ones move the scroll position along, so the same rows stay
+        on screen and nothing is fetched again.
+    */
+    virtual void rowsInserted(uint32_t first, uint32_t count);
+    virtual void rowsDeleted(uint32_t first, uint32_t count);
+    virtual void rowsUpdated(uint32_t first, uint32_t count);
+
     // UIView
     virtual uint32_t fillFrameBuffer(SharedPointer<FrameBuffer>& buffer, int16_t xOffset, int16_t yOffset);
     virtual void prefetch(int16_t xOffset, int16_t yOffset);
     void setWakeupCallback(FunctionPointer& wakeup);
+    virtual bool isDirty(void);
+    virtual UIView::Rect getDirtyRect(void);
+    virtual void suspend(void);
+    virtual uint32_t getRetainedBytes(void) const;
+    virtual void setCacheBudget(SharedPointer<UICacheBudget>& budget);
+    virtual void clearDirty(void);
 
 protected:
+    uint32_t rowHeight(uint32_t index);
+    uint32_t getRowAtDistance(int32_t distance, int32_t* bottom);
+
     SharedPointer<UIView::Array> table;
 
 private:
-    void insertCell(SharedPointer<UIView>& cell, uint32_t index);
-    SharedPointer<UIView>& getCellAtCacheIndex(uint32_t index);
-    void prefetch(uint32_t index, minar::callback_handle_t* handle);
+    void insertCell(SharedPointer<UIView>& cell, uint32_t index, bool prefetched = false);
+    void fillBackground(SharedPointer<FrameBuffer>& canvas, int32_t top, int32_t bottom);
+    bool coversRow(SharedPointer<UIView>& cell, int32_t cellHeight) const;
+    bool isCached(uint32_t index);
+    void updateIndex();
+    void setPosition(uint32_t position);
+    uint32_t renderRows(SharedPointer<FrameBuffer>& canvas, int16_t xOffset, int16_t yOffset);
+    uint32_t blitRows(SharedPointer<FrameBuffer>& canvas, uint16_t first);
+    uint32_t renderBand(int32_t top, int32_t bottom);
+    void fetchRow(uint32_t index);
+    void updateVisibleRange(void);
+    SharedPointer<UIView> getCell(uint32_t row, uint32_t lastRow);
+    void updatePrefetchWindow(uint32_t bottomRow);
+    void runPrefetchQueue(void);
+    void rowsMoved(uint32_t first, int32_t delta);
+    uint32_t getTopPosition(void);
+    void invalidateLayout(void);
 
     uint32_t topRow;
     uint32_t topCellOverflow;
 
-    uint32_t cacheSize;
-    uint32_t* lookUpTable;
-    SharedPointer<UIView>* cache;
-    SharedPointer<UIView> cacheMiss;
-
-    minar::callback_handle_t cacheTopCallbackHandle;
-    minar::callback_handle_t cacheBottomCallbackHandle;
+    /* pixel position of every row */
+    UIHeightIndex heightIndex;
+
+    /* cells evicted from the cache, for the table-object to reuse */
+    UICellPool cellPool;
+    UICellCache cellCache;
+
+    /* reusable window for drawing cells, owned by cellCanvas */
+    UISubCanvas* cellWindow;
+    SharedPointer<FrameBuffer> cellCanvas;
+
+    /* visible rows fetched together but not drawn yet, first at batchFirst */
+    SharedPointer<UIView> batch[FETCH_BATCH_ROWS];
+    uint32_t batchFirst;
+    uint32_t batchCount;
+
+    /*  Rows found by getRowAtDistance and their pixel extents from the top
+        of the first row, kept until the heights change. A slot is used again
+        while its row still covers the distance, so scrolling within a row
+        needs no lookup. The position of topRow is kept the same way.
+    */
+    int32_t layoutDistance[LAYOUT_SLOTS];
+    uint32_t layoutRow[LAYOUT_SLOTS];
+    uint32_t layoutTop[LAYOUT_SLOTS];
+    uint32_t layoutBottom[LAYOUT_SLOTS];
+    uint32_t layoutCount;
+    uint32_t layoutNext;
+    uint32_t layoutPasses;
+    uint32_t positionRow;
+    uint32_t positionTop;
+    bool positionValid;
+
+    /* rows drawn in the last frame, [visibleFirst, visibleEnd), their cells are resumed */
+    uint32_t visibleFirst;
+    uint32_t visibleEnd;
+
+    /* rows around the visible ones waiting to be fetched */
+    UIPrefetchQueue prefetchQueue;
+    minar::callback_handle_t prefetchCallbackHandle;
+    uint32_t prefetchRows;
+    uint32_t prefetchTime; // microseconds
+    int32_t scrollVelocity;
+
+    /* retained rows for blit scrolling, owned by layer */
+    bool blitScrolling;
+    UIMemoryFrameBuffer* layerBuffer;
+    SharedPointer<FrameBuffer> layer;
+    UISubCanvas* layerWindow;
+    SharedPointer<FrameBuffer> layerCanvas;
+    bool layerValid;
+    uint32_t layerPosition;
+    uint32_t layerInterval;
+    uint32_t renderedLines;
 
     int32_t outstandingScrollPx;
 };
@@ -114,26 +114,7 @@ public:
 
     virtual uint32_t fillFrameBuffer(SharedPointer<FrameBuffer>& canvas, int16_t xOffset, int16_t yOffset)
     {
-        /* use current time to evaluate whether image needs to be updated */
-        uint32_t now = UIView::getTimeInMilliseconds();
-
-        if ((now - callCounter) > intervalInMilliseconds)
-        {
-            /* read current value of variable */
-            T currentValue = getCurrentValue.call();
-
-            /* update image cell if value has changed */
-            if (currentValue != previousValue)
-            {
-                updateImage(currentValue);
-
-                /* store current value in cache */
-                previousValue = currentValue;
-            }
-
-            /* reset counter */
-            callCounter = now;
-        }
+        uint32_t now = poll();
 
         /* copy image to canvas */
         if (variableCell)
@@ -151,12 +132,95 @@ public:
         return intervalInMilliseconds + (now - callCounter);
     }
 
+    virtual bool isDirty()
+    {
+        poll();
+
+        return UIView::isDirty() || (variableCell && variableCell->isDirty());
+    }
+
+    virtual void clearDirty()
+    {
+        UIView::clearDirty();
+
+        if (variableCell)
+        {
+            variableCell->clearDirty();
+        }
+    }
+
+    /*
+        Release the text bitmap while out of view.
+    */
+    virtual void suspend()
+    {
+        if (variableCell)
+        {
+            variableCell->suspend();
+        }
+    }
+
+    /*
+        Read the value on the next poll, it has not been watched while suspended.
+    */
+    virtual void resume()
+    {
+        callCounter = UIView::getTimeInMilliseconds() - intervalInMilliseconds - 1;
+
+        if (variableCell)
+        {
+            variableCell->resume();
+        }
+    }
+
+    virtual uint32_t getRetainedBytes() const
+    {
+        uint32_t bytes = sizeof(UITextMonitorView<T>) + variableString.capacity();
+
+        if (variableCell)
+        {
+            bytes += variableCell->getRetainedBytes();
+        }
+
+        return bytes;
+    }
+
     void setInterval(uint32_t interval)
     {
         intervalInMilliseconds = interval;
     }
 
 private:
+    /*
+        Read the variable if the interval has elapsed and update the image
+        if the value has changed. Returns the current time.
+    */
+    uint32_t poll()
+    {
+        /* use current time to evaluate whether image needs to be updated */
+        uint32_t now = UIView::getTimeInMilliseconds();
+
+        if ((now - callCounter) > intervalInMilliseconds)
+        {
+            /* read current value of variable */
+            T currentValue = getCurrentValue.call();
+
+            /* update image cell if value has changed */
+            if (currentValue != previousValue)
+            {
+                updateImage(currentValue);
+
+                /* store current value in cache */
+                previousValue = currentValue;
+            }
+
+            /* reset counter */
+            callCounter = now;
+        }
+
+        return now;
+    }
+
     /*
         Internal callback function when monitoring a pointer.
     */
@@ -176,7 +240,17 @@ private:
         snprintf(buffer, 12, format, value);
         variableString = std::string(buffer);
 
-        variableCell = SharedPointer<UITextView>(new UITextView(variableString.c_str(), font));
+        /* reuse the text view and its bitmap after the first value */
+        if (variableCell)
+        {
+            variableCell->setText(variableString.c_str());
+        }
+        else
+        {
+            variableCell = SharedPointer<UITextView>(new UITextView(variableString.c_str(), font));
+        }
+
+        UIView::markDirty();
     }
 
 private:
@@ -31,6 +31,12 @@ public:
     UITextView(std::string& text, const struct FontData* font);
     UITextView(const char* text, const struct FontData* font);
 
+    /*  Show other text, e.g. when the view is reused for another table row.
+        The bitmap is reused if the new text fits in it.
+    */
+    void setText(const char* text);
+    void setText(std::string& text);
+
     // from UIView
     virtual ~UITextView();
     virtual uint32_t fillFrameBuffer(SharedPointer<FrameBuffer>& buffer,
@@ -38,6 +44,10 @@ public:
                                      int16_t yOffset);
 
     virtual void prefetch(int16_t xOffset, int16_t yOffset);
+    virtual void suspend(void);
+    virtual uint32_t getRetainedBytes(void) const;
+    virtual bool isDirty(void);
+    virtual void clearDirty(void);
 
 private:
     void constructor();
@@ -52,6 +62,8 @@ private:
 
     std::string textString;
     uint8_t* mallocBuffer;
+    uint32_t mallocSize;
+    bool rendered;
     struct CompBuf cacheBuffer;
     UIImageView* cacheImage;
 };
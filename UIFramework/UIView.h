@@ -18,7 +18,7 @@
 #define __UIVIEW_H__
 
 
-#include "mbed-drivers/mbed.h"
+#include "UIFramework/UIPlatform.h"
 
 #include "core-util/FunctionPointer.h"
 #include "core-util/SharedPointer.h"
@@ -26,11 +26,15 @@
 #include "uif-framebuffer/FrameBuffer.h"
 
 #include <climits>
+#include <stdint.h>
 #include <string>
 
 using namespace mbed::util;
 using namespace uif;
 
+class UICacheBudget;
+class UICellPool;
+
 class UIView
 {
 public:
@@ -48,6 +52,45 @@ public:
 
     class Array;
 
+    /**
+     * @brief Rectangle in view coordinates, [x0, x1) x [y0, y1).
+     */
+    class Rect
+    {
+    public:
+        /**
+         * @brief Empty rectangle.
+         */
+        Rect(void);
+
+        Rect(int16_t x0, int16_t y0, int16_t x1, int16_t y1);
+
+        /**
+         * @brief Does the rectangle cover no pixels.
+         */
+        bool isEmpty(void) const;
+
+        /**
+         * @brief Grow rectangle to include the other rectangle.
+         */
+        void unite(const Rect& other);
+
+        /**
+         * @brief Shrink rectangle to the part inside the other rectangle.
+         */
+        void intersect(const Rect& other);
+
+        /**
+         * @brief Move rectangle by the given amount.
+         */
+        void translate(int16_t x, int16_t y);
+
+        int16_t x0;
+        int16_t y0;
+        int16_t x1;
+        int16_t y1;
+    };
+
     /**
      * @brief Return type for when the default action is invoked on a cell.
      */
@@ -116,9 +159,118 @@ public:
     {
     public:
         /**
-         * @brief Optional destructor.
+         * @brief Receives changes to the contents of an array.
+         * @details Rows are numbered as after the change. Tables use this
+         *          to move their cached cells along with the rows instead
+         *          of fetching every row again.
+         */
+        class Listener
+        {
+        public:
+            Listener(void) : listenedArray(NULL), nextListener(NULL) { };
+
+            /**
+             * @brief Copies are not registered with the array of the original.
+             */
+            Listener(const Listener&) : listenedArray(NULL), nextListener(NULL) { };
+
+            Listener& operator=(const Listener&)
+            {
+                return *this;
+            }
+
+            /**
+             * @brief Unregisters from the array, if still registered.
+             */
+            virtual ~Listener(void);
+
+            /**
+             * @brief Rows [first, first + count) were added.
+             */
+            virtual void rowsInserted(uint32_t first, uint32_t count) = 0;
+
+            /**
+             * @brief The count rows starting at first were removed, the rows
+             *        after them now start at first.
+             */
+            virtual void rowsDeleted(uint32_t first, uint32_t count) = 0;
+
+            /**
+             * @brief Rows [first, first + count) have new content or height.
+             */
+            virtual void rowsUpdated(uint32_t first, uint32_t count) = 0;
+
+        private:
+            friend class Array;
+
+            /* array registered with, and the next listener of that array */
+            Array* listenedArray;
+            Listener* nextListener;
+        };
+
+        Array(void) : listeners(NULL) { };
+
+        /**
+         * @brief Copies start without listeners.
+         */
+        Array(const Array&) : listeners(NULL) { };
+
+        Array& operator=(const Array&)
+        {
+            return *this;
+        }
+
+        /**
+         * @brief Optional destructor. Listeners still registered are
+         *        unregistered.
          */
-        virtual ~Array(void) { };
+        virtual ~Array(void);
+
+        /**
+         * @brief Add an object told about changes. Tables showing the array
+         *        register themselves, so one array can back several tables.
+         * @details A listener belongs to at most one array at a time, it
+         *          must be removed before it is added to another one. Adding
+         *          it twice to the same array has no effect. Listeners are
+         *          kept in a list linked through the listeners, so this does
+         *          not allocate.
+         *
+         * @param listener Listener to add.
+         */
+        void addListener(Listener* listener);
+
+        /**
+         * @brief Stop telling an object about changes.
+         *
+         * @param listener Listener to remove, ignored if not added.
+         */
+        void removeListener(Listener* listener);
+
+        /**
+         * @brief Check whether an object is told about changes.
+         *
+         * @param listener Listener to look for.
+         * @return true if the listener was added.
+         */
+        bool hasListener(const Listener* listener) const;
+
+        /**
+         * @brief Tell the listeners that rows were added, after changing the
+         *        contents.
+         */
+        void notifyInserted(uint32_t first, uint32_t count);
+
+        /**
+         * @brief Tell the listeners that rows were removed, after changing
+         *        the contents.
+         */
+        void notifyDeleted(uint32_t first, uint32_t count);
+
+        /**
+         * @brief Tell the listeners that rows changed, after changing the
+         *        contents.
+         */
+        void notifyUpdated(uint32_t first, uint32_t count);
 
         /**
          * @brief Get number of elements in the menu.
@@ -136,6 +288,25 @@ public:
          */
         virtual SharedPointer<UIView> viewAtIndex(uint32_t index) const = 0;
 
+        /**
+         * @brief Get UIView object at the given index, reusing a cell from
+         *        the pool if possible.
+         * @details Tables ask for cells through this call. Cells of the
+         *          right type taken from the pool with UICellPool::dequeue
+         *          must be given the new content, and size if it differs,
+         *          before being returned. The default ignores the pool.
+         *
+         * @param index Cell to retrieve.
+         * @param pool Cells no longer used by the table.
+         * @return UIView-object wrapped inside a SharedPointer
+         */
+        virtual SharedPointer<UIView> viewAtIndex(uint32_t index, UICellPool& pool) const
+        {
+            (void) pool;
+
+            return viewAtIndex(index);
+        }
+
         /**
          * @brief Get pixel height of the cell at the given index.
          *
@@ -154,6 +325,48 @@ public:
          */
         virtual uint32_t widthAtIndex(uint32_t index) const = 0;
 
+        /**
+         * @brief Get the height shared by all cells, if there is one.
+         * @details Tables with a uniform row height are laid out with plain
+         *          arithmetic instead of asking for the height of each row.
+         *
+         * @return Height in number of pixels, or 0 if cells differ in height.
+         */
+        virtual uint32_t getUniformHeight(void) const { return 0; }
+
+        /**
+         * @brief Get UIView objects for the cells in [first, last).
+         * @details The default asks viewAtIndex for each cell. Arrays that
+         *          can create several cells in one pass, e.g. from a single
+         *          database query, should override it.
+         *
+         * @param first First cell to retrieve.
+         * @param last One past the last cell to retrieve.
+         * @param views Filled with last - first views.
+         * @param pool Cells no longer used by the table, for reuse.
+         */
+        virtual void viewsInRange(uint32_t first, uint32_t last, SharedPointer<UIView>* views, UICellPool& pool) const;
+
+        /**
+         * @brief Get pixel heights of the cells in [first, last).
+         * @details The default asks heightAtIndex for each cell.
+         *
+         * @param first First cell to get height of.
+         * @param last One past the last cell.
+         * @param heights Filled with last - first heights.
+         */
+        virtual void heightsInRange(uint32_t first, uint32_t last, uint32_t* heights) const;
+
+        /**
+         * @brief Get pixel widths of the cells in [first, last).
+         * @details The default asks widthAtIndex for each cell.
+         *
+         * @param first First cell to get width of.
+         * @param last One past the last cell.
+         * @param widths Filled with last - first widths.
+         */
+        virtual void widthsInRange(uint32_t first, uint32_t last, uint32_t* widths) const;
+
         /**
          * @brief Get the table's title.
          *
@@ -195,6 +408,9 @@ public:
 
             return SharedPointer<UIView::Action>(new UIView::Action());
         }
+
+    private:
+        Listener* listeners;
     };
 
     /**
@@ -345,10 +561,28 @@ public:
      */
     void setInverse(bool inverse);
 
+    /**
+     * @brief Declare that the object draws every pixel within its bounds.
+     * @details Containers skip drawing the background, and anything else,
+     *          underneath opaque objects.
+     *
+     * @param opaque Boolean flag.
+     */
+    void setOpaque(bool opaque);
+
+    /**
+     * @brief Does the object draw every pixel within its bounds.
+     *
+     * @return Boolean opacity.
+     */
+    virtual bool isOpaque(void) const;
+
     /**
      * @brief Cache control. Set cache permission.
      * @details Static and slow changing objects can be marked as cacheable
-     *          so they do not have to be recomputed every time.
+     *          so they do not have to be recomputed every time. Wrapped in a
+     *          UILayerView, the rendered pixels of cacheable objects are
+     *          retained as well.
      *
      * @param cacheable Boolean flag.
      */
@@ -357,7 +591,8 @@ public:
     /**
      * @brief Cache control. Mark object as invalid.
      * @details Mark object as stale. Any cached versions should be discarded
-     *          and a new object should be retrieved.
+     *          and a new object should be retrieved. Also marks the object
+     *          as changed.
      */
     void invalidate(void);
 
@@ -375,6 +610,98 @@ public:
      */
     bool isValid(void) const;
 
+    /**
+     * @brief Cache control. Set reuse type.
+     * @details Cells evicted from a table's cache are kept in its
+     *          UICellPool under this type, so the data source can reuse
+     *          them for other rows instead of allocating new ones. 0, the
+     *          default, means the object is never reused.
+     *
+     * @param type Reuse type, shared by cells that can be rebound to each
+     *             other's content.
+     */
+    void setReuseType(uint32_t type);
+
+    /**
+     * @brief Cache control. Get reuse type.
+     *
+     * @return Reuse type, 0 if not reusable.
+     */
+    uint32_t getReuseType(void) const;
+
+    /**
+     * @brief Cache control. Called when the object is taken from a pool.
+     * @details Makes the object valid and changed again. Objects holding
+     *          state of their previous use should reset it.
+     */
+    virtual void prepareForReuse(void);
+
+    /**
+     * @brief Cache control. Approximate memory held by the object.
+     * @details Caches evict against a byte budget using this figure.
+     *          Objects owning buffers, e.g. rendered text or images, should
+     *          add their size to the size of the object itself.
+     *
+     * @return Bytes retained.
+     */
+    virtual uint32_t getRetainedBytes(void) const;
+
+    /**
+     * @brief Cache control. Share a memory budget for cached objects.
+     * @details Containers pass the budget on to their children; tables
+     *          evict cached cells against it.
+     *
+     * @param budget Budget, or a NULL pointer for none.
+     */
+    virtual void setCacheBudget(SharedPointer<UICacheBudget>& budget);
+
+    /**
+     * @brief Change tracking. Mark object as changed.
+     * @details The setters mark the object when a value actually changes.
+     *          Objects whose appearance depends on other state must call
+     *          this, or override isDirty, when that state changes.
+     */
+    void markDirty(void);
+
+    /**
+     * @brief Change tracking. Mark part of the object as changed.
+     * @details Unlike invalidate() the object is not marked as stale, only
+     *          the given area has to be drawn again. Call the wakeup
+     *          callback afterwards to have the screen updated.
+     *
+     * @param rect Changed area in the object's coordinates.
+     */
+    void invalidate(const Rect& rect);
+
+    /**
+     * @brief Change tracking. Has the object changed since it was last drawn.
+     * @details Containers include the visible children they draw, so calling
+     *          this on the root tells whether a new frame would differ from
+     *          the last one. Animating objects report true until the
+     *          animation has finished.
+     *
+     * @return Boolean change status.
+     */
+    virtual bool isDirty(void);
+
+    /**
+     * @brief Change tracking. Area that has changed since the object was
+     *        last drawn.
+     * @details Containers translate the areas of their children into their
+     *          own coordinates, so the result for the root is the area of the
+     *          screen that has to be drawn again. The whole object is
+     *          reported if it has changed without a specific area.
+     *
+     * @return Changed area in the object's coordinates, empty if unchanged.
+     */
+    virtual Rect getDirtyRect(void);
+
+    /**
+     * @brief Change tracking. Called after the object has been drawn.
+     * @details Containers must clear their children as well.
+     */
+    virtual void clearDirty(void);
+
 protected:
     /**
      * @brief UIView constructor.
@@ -400,20 +727,34 @@ protected:
     /**
      * @brief Get current time in milliseconds.
      * @details Function can be used for controlling animation and progress.
+     *          The time is monotonic and wraps at 2^32, compare times by
+     *          subtraction. Use UIClock directly for finer resolution.
      *
      * @return Current time in milliseconds.
      */
     uint32_t getTimeInMilliseconds(void) const;
 
+    /**
+     * @brief Area covered by the object.
+     * @details Unbounded in directions where the size is not set yet.
+     */
+    Rect getBounds(void) const;
+
     align_t  align;
     valign_t valign;
     uint16_t width;
     uint16_t height;
     bool     inverse;
+    bool     opaque;
 
     /* Is UIView cacheable and is it still valid. */
     bool cacheable;
     bool valid;
+    uint32_t reuseType;
+
+    /* Has the object, or part of it, changed since it was last drawn. */
+    bool dirty;
+    Rect dirtyRect;
 
     // Callback function for requesting screen update
     FunctionPointer wakeupCallback;
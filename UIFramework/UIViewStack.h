@@ -19,6 +19,8 @@
 
 
 #include "UIFramework/UIView.h"
+#include "UIFramework/UICacheBudget.h"
+#include "UIFramework/UISubCanvas.h"
 
 #include "core-util/Array.h"
 
@@ -41,22 +43,35 @@ public:
     virtual uint32_t fillFrameBuffer(SharedPointer<FrameBuffer>& buffer, int16_t xOffset, int16_t yOffset);
     virtual void prefetch(int16_t xOffset, int16_t yOffset);
     virtual void setWakeupCallback(FunctionPointer& wakeup);
+    virtual void setCacheBudget(SharedPointer<UICacheBudget>& budget);
+    virtual bool isDirty(void);
+    virtual UIView::Rect getDirtyRect(void);
+    virtual void clearDirty(void);
 
     virtual SharedPointer<UIView::Action> getAction();
 
 private:
+    uint32_t getScrollOffset(void) const;
+
     uint32_t transitionTimeInMilliSeconds;
 
     bool scrollLeftToRight;
     bool scrollRightToLeft;
     uint32_t scrollOffset;
-    uint32_t scrollStartTime;
+    uint32_t scrollStartTime; // UIClock microseconds
 
     mbed::util::Array<SharedPointer<UIView> > stack;
 
+    /* shared by the caches of all views in the stack */
+    SharedPointer<UICacheBudget> cacheBudget;
+
     SharedPointer<UIView> mainCell;
     SharedPointer<UIView> leftCell;
     SharedPointer<UIView> rightCell;
+
+    /* reusable window for the two halves of a transition, owned by transitionCanvas */
+    UISubCanvas* transitionWindow;
+    SharedPointer<FrameBuffer> transitionCanvas;
 };
 
 #endif // __UIVIEWSTACK_H__
@@ -0,0 +1,134 @@
+/* mbed
+ * Copyright (c) 2006-2015 ARM Limited
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#ifndef __HOSTSCHEDULER_H__
+#define __HOSTSCHEDULER_H__
+
+#include "core-util/Event.h"
+#include "core-util/FunctionPointer.h"
+
+#include <stdint.h>
+#include <climits>
+
+/*  Deterministic stand-in for the minar scheduler on host builds.
+    Callbacks are dispatched in order of due time, and in posting order for
+    equal due times. Time is virtual: when no callback is due the clock jumps
+    straight to the next one, so a run is independent of the speed of the
+    host. One tick is one microsecond.
+
+    Every dispatched callback advances the clock by a fixed cost, so code
+    that keeps rescheduling itself without a delay (e.g. an animation frame
+    that renders identically) still lets time move on, as it would on a
+    device.
+*/
+namespace minar {
+
+typedef uint32_t tick_t;
+typedef void* callback_handle_t;
+
+#define HOST_SCHEDULER_DISPATCH_TIME_US 100
+
+inline tick_t milliseconds(uint32_t ms)
+{
+    return ms * 1000;
+}
+
+namespace platform {
+
+/**
+ * @brief Get virtual time in ticks.
+ */
+tick_t getTime(void);
+
+/**
+ * @brief Advance the virtual clock, e.g. to model time spent computing.
+ */
+void advanceTime(tick_t ticks);
+
+} // namespace platform
+
+class Scheduler;
+
+class CallbackAdder
+{
+public:
+    CallbackAdder& delay(tick_t delay);
+    CallbackAdder& tolerance(tick_t tolerance);
+    CallbackAdder& period(tick_t period);
+    callback_handle_t getHandle(void) const;
+
+private:
+    friend class Scheduler;
+
+    CallbackAdder(uint32_t id);
+
+    uint32_t id;
+};
+
+class Scheduler
+{
+public:
+    static CallbackAdder postCallback(const mbed::util::Event& callback);
+    static CallbackAdder postCallback(void (*callback)(void));
+
+    template <class T>
+    static CallbackAdder postCallback(T* object, void (T::*member)(void))
+    {
+        mbed::util::FunctionPointer0<void> callback(object, member);
+
+        return postCallback(callback.bind());
+    }
+
+    static int cancelCallback(callback_handle_t handle);
+
+    /**
+     * @brief Dispatch callbacks until stop() is called or none are left.
+     */
+    static int start(void);
+
+    /**
+     * @brief Make start() return after the current callback.
+     */
+    static void stop(void);
+
+    /**
+     * @brief Dispatch callbacks due before or at the given virtual time and
+     *        advance the clock to it.
+     *
+     * @return Number of callbacks dispatched.
+     */
+    static uint32_t runUntil(tick_t time);
+
+    /**
+     * @brief Number of callbacks waiting to be dispatched.
+     */
+    static uint32_t getPendingCallbacks(void);
+
+    /**
+     * @brief Set the virtual time each dispatched callback takes.
+     */
+    static void setDispatchTime(tick_t time);
+
+    /**
+     * @brief Drop all callbacks, reset the clock to zero and restore the
+     *        default dispatch time.
+     */
+    static void reset(void);
+};
+
+} // namespace minar
+
+#endif // __HOSTSCHEDULER_H__
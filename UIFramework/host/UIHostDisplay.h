@@ -0,0 +1,113 @@
+/* mbed
+ * Copyright (c) 2006-2015 ARM Limited
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#ifndef __UIHOSTDISPLAY_H__
+#define __UIHOSTDISPLAY_H__
+
+#include "UIFramework/UIDisplay.h"
+#include "UIFramework/UIMemoryFrameBuffer.h"
+
+
+/* transfer time of a single 128 pixel line at 1 MHz SPI */
+#define HOST_DISPLAY_LINE_TIME_US 144
+
+/*  Simulated memory LCD for host builds. Frame buffers are kept in RAM,
+    transfers take virtual time proportional to the number of lines, and
+    every received frame can be written to disk as a PBM image.
+*/
+class UIHostDisplay : public UIDisplay
+{
+public:
+    UIHostDisplay(uint16_t width = 128,
+                  uint16_t height = 128,
+                  uint32_t bufferCount = 2);
+    virtual ~UIHostDisplay();
+
+    // from UIDisplay
+    virtual SharedPointer<FrameBuffer> getFrameBuffer(void);
+    virtual uint32_t getBufferCount(void) const;
+    virtual void sendFrameBuffer(SharedPointer<FrameBuffer>& buffer,
+                                 FunctionPointer onStart,
+                                 FunctionPointer onFinish);
+    virtual void sendFrameBufferLines(SharedPointer<FrameBuffer>& buffer,
+                                      const uint8_t* lines,
+                                      FunctionPointer onStart,
+                                      FunctionPointer onFinish);
+    virtual bool canSendLines(void) const;
+    virtual const uint8_t* getLine(SharedPointer<FrameBuffer>& buffer, uint16_t line) const;
+
+    /*  Set simulated transfer time per line in microseconds.
+    */
+    void setLineTime(uint32_t lineTimeUs);
+
+    /*  Write every frame received as <prefix><frame number>.pbm.
+        Set to NULL to disable.
+    */
+    void setDumpPrefix(const char* prefix);
+
+    /*  Write the current screen content to a PBM file.
+    */
+    bool writePBM(const char* filename) const;
+
+    /*  Current screen content.
+    */
+    uint8_t getPixel(uint16_t x, uint16_t y) const;
+
+    /*  Statistics.
+    */
+    uint32_t getFrames(void) const;
+    uint32_t getLines(void) const;
+    bool isBusy(void) const;
+
+    /*  Overdraw statistics. Pixels written by the renderer and pixels written
+        more than once within a frame, summed over all transferred frames.
+        Frames that are not transferred count towards the next one.
+    */
+    uint32_t getPixelWrites(void) const;
+    uint32_t getOverdraw(void) const;
+    uint32_t getLastOverdraw(void) const;
+
+private:
+    void transfer(SharedPointer<FrameBuffer>& buffer,
+                  const uint8_t* lines,
+                  FunctionPointer onStart,
+                  FunctionPointer onFinish);
+    void transferDone(void);
+
+private:
+    uint16_t width;
+    uint16_t height;
+
+    UIMemoryFrameBuffer screen;
+
+    SharedPointer<FrameBuffer>* buffers;
+    uint32_t bufferCount;
+    uint32_t nextBuffer;
+
+    FunctionPointer onFinish;
+    bool busy;
+
+    uint32_t lineTime;
+    const char* dumpPrefix;
+
+    uint32_t frames;
+    uint32_t lines;
+    uint32_t pixelWrites;
+    uint32_t overdraw;
+    uint32_t lastOverdraw;
+};
+
+#endif // __UIHOSTDISPLAY_H__
@@ -0,0 +1,106 @@
+/* mbed
+ * Copyright (c) 2006-2015 ARM Limited
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#include "UIFramework/UICacheBudget.h"
+#include "UIFramework/UICellCache.h"
+
+
+UICacheBudget::UICacheBudget(uint32_t _limit)
+    :   caches(NULL),
+        limit(_limit),
+        used(0),
+        peak(0)
+{
+}
+
+void UICacheBudget::setLimit(uint32_t _limit)
+{
+    limit = _limit;
+}
+
+uint32_t UICacheBudget::getLimit() const
+{
+    return limit;
+}
+
+uint32_t UICacheBudget::getUsed() const
+{
+    return used;
+}
+
+uint32_t UICacheBudget::getPeak() const
+{
+    return peak;
+}
+
+void UICacheBudget::resetPeak()
+{
+    peak = used;
+}
+
+bool UICacheBudget::isExceeded() const
+{
+    return (used > limit);
+}
+
+void UICacheBudget::add(uint32_t bytes)
+{
+    used += bytes;
+
+    if (used > peak)
+    {
+        peak = used;
+    }
+}
+
+void UICacheBudget::remove(uint32_t bytes)
+{
+    used = (bytes < used) ? used - bytes : 0;
+}
+
+void UICacheBudget::attach(UICellCache* cache)
+{
+    cache->nextInBudget = caches;
+    caches = cache;
+}
+
+void UICacheBudget::detach(UICellCache* cache)
+{
+    UICellCache** link = &caches;
+
+    while (*link != NULL)
+    {
+        if (*link == cache)
+        {
+            *link = cache->nextInBudget;
+            cache->nextInBudget = NULL;
+            break;
+        }
+
+        link = &((*link)->nextInBudget);
+    }
+}
+
+void UICacheBudget::reclaim(UICellCache* requester)
+{
+    for (UICellCache* cache = caches; (cache != NULL) && isExceeded(); cache = cache->nextInBudget)
+    {
+        if (cache != requester)
+        {
+            cache->shrink();
+        }
+    }
+}
@@ -0,0 +1,534 @@
+/* mbed
+ * Copyright (c) 2006-2015 ARM Limited
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#include "UIFramework/UICellCache.h"
+
+
+#define EMPTY_SLOT 0xFFFFFFFF
+
+UICellCache::UICellCache(uint32_t _size, uint32_t _ways)
+    :   size(_size),
+        sets(1),
+        ways(_ways),
+        keys(NULL),
+        lastUse(NULL),
+        unused(NULL),
+        bytes(NULL),
+        cells(NULL),
+        useCounter(0),
+        none(),
+        pool(NULL),
+        budget(),
+        nextInBudget(NULL),
+        retainedBytes(0),
+        keepFirst(0),
+        keepEnd(0),
+        hits(0),
+        misses(0),
+        evictions(0),
+        refetches(0),
+        wastedPrefetches(0),
+        trimmed(0)
+{
+    if (size == 0)
+    {
+        size = 1;
+    }
+
+    if ((ways == 0) || (ways > size))
+    {
+        ways = size;
+    }
+
+    /* fewer, larger sets rather than leaving slots unused */
+    sets = size / ways;
+    ways = size / sets;
+    size = sets * ways;
+
+    keys = new uint32_t[size];
+    lastUse = new uint32_t[size];
+    unused = new bool[size];
+    bytes = new uint32_t[size];
+    cells = new SharedPointer<UIView>[size];
+
+    for (uint32_t slot = 0; slot < size; slot++)
+    {
+        keys[slot] = EMPTY_SLOT;
+        lastUse[slot] = 0;
+        unused[slot] = false;
+        bytes[slot] = 0;
+    }
+}
+
+UICellCache::~UICellCache()
+{
+    if (budget != NULL)
+    {
+        budget->remove(retainedBytes);
+        budget->detach(this);
+    }
+
+    delete[] keys;
+    delete[] lastUse;
+    delete[] unused;
+    delete[] bytes;
+    delete[] cells;
+}
+
+uint32_t UICellCache::findSlot(uint32_t index) const
+{
+    uint32_t first = (index % sets) * ways;
+
+    for (uint32_t slot = first; slot < first + ways; slot++)
+    {
+        if (keys[slot] == index)
+        {
+            return slot;
+        }
+    }
+
+    return EMPTY_SLOT;
+}
+
+SharedPointer<UIView>& UICellCache::lookup(uint32_t index)
+{
+    uint32_t slot = findSlot(index);
+
+    if (slot == EMPTY_SLOT)
+    {
+        misses++;
+
+        return none;
+    }
+
+    if (!cells[slot]->isValid())
+    {
+        refetches++;
+
+        return none;
+    }
+
+    hits++;
+    lastUse[slot] = ++useCounter;
+    unused[slot] = false;
+
+    return cells[slot];
+}
+
+SharedPointer<UIView>& UICellCache::peek(uint32_t index)
+{
+    uint32_t slot = findSlot(index);
+
+    return (slot == EMPTY_SLOT) ? none : cells[slot];
+}
+
+/*  Empty the slot, counting prefetched cells that were never used and
+    passing the cell on to the pool. Pooled cells are suspended, they are
+    resumed when they are handed out for a visible row.
+*/
+void UICellCache::release(uint32_t slot)
+{
+    if (unused[slot])
+    {
+        wastedPrefetches++;
+        unused[slot] = false;
+    }
+
+    if ((pool != NULL) && (cells[slot] != NULL))
+    {
+        cells[slot]->suspend();
+        pool->recycle(cells[slot]);
+    }
+
+    keys[slot] = EMPTY_SLOT;
+    cells[slot] = SharedPointer<UIView>();
+
+    account(slot);
+}
+
+/*  Bring the retained bytes of the slot, and the budget, up to date.
+*/
+void UICellCache::account(uint32_t slot)
+{
+    uint32_t current = (cells[slot] != NULL) ? cells[slot]->getRetainedBytes() : 0;
+
+    if (budget != NULL)
+    {
+        budget->remove(bytes[slot]);
+        budget->add(current);
+    }
+
+    retainedBytes = retainedBytes - bytes[slot] + current;
+    bytes[slot] = current;
+}
+
+void UICellCache::insert(uint32_t index, SharedPointer<UIView>& cell, bool prefetched)
+{
+    uint32_t slot = findSlot(index);
+
+    if (slot == EMPTY_SLOT)
+    {
+        /* pick an empty slot, or else the one unused for the longest time */
+        uint32_t first = (index % sets) * ways;
+        uint32_t oldest = 0;
+
+        for (uint32_t candidate = first; candidate < first + ways; candidate++)
+        {
+            if (keys[candidate] == EMPTY_SLOT)
+            {
+                slot = candidate;
+                break;
+            }
+
+            /* wrap-safe age */
+            uint32_t age = useCounter - lastUse[candidate];
+
+            if ((slot == EMPTY_SLOT) || (age > oldest))
+            {
+                slot = candidate;
+                oldest = age;
+            }
+        }
+
+        if (keys[slot] != EMPTY_SLOT)
+        {
+            evictions++;
+        }
+    }
+
+    release(slot);
+
+    keys[slot] = index;
+    lastUse[slot] = ++useCounter;
+    unused[slot] = prefetched;
+    cells[slot] = cell;
+
+    account(slot);
+}
+
+void UICellCache::remove(uint32_t index)
+{
+    uint32_t slot = findSlot(index);
+
+    if (slot != EMPTY_SLOT)
+    {
+        release(slot);
+    }
+}
+
+void UICellCache::clear()
+{
+    for (uint32_t slot = 0; slot < size; slot++)
+    {
+        release(slot);
+    }
+}
+
+/*  Exchange the contents of two slots, including empty ones. The retained
+    bytes move with the cells, so the totals are unchanged.
+*/
+void UICellCache::swapSlots(uint32_t slot, uint32_t other)
+{
+    uint32_t key = keys[slot];
+    uint32_t use = lastUse[slot];
+    bool wasUnused = unused[slot];
+    uint32_t retained = bytes[slot];
+    SharedPointer<UIView> cell = cells[slot];
+
+    keys[slot] = keys[other];
+    lastUse[slot] = lastUse[other];
+    unused[slot] = unused[other];
+    bytes[slot] = bytes[other];
+    cells[slot] = cells[other];
+
+    keys[other] = key;
+    lastUse[other] = use;
+    unused[other] = wasUnused;
+    bytes[other] = retained;
+    cells[other] = cell;
+}
+
+void UICellCache::shift(uint32_t first, int32_t delta)
+{
+    if (delta == 0)
+    {
+        return;
+    }
+
+    uint32_t removed = (delta < 0) ? -delta : 0;
+    uint32_t removedFirst = (first > removed) ? first - removed : 0;
+
+    /* renumber in place, leaving cells in the set of their old row */
+    for (uint32_t slot = 0; slot < size; slot++)
+    {
+        uint32_t key = keys[slot];
+
+        if (key == EMPTY_SLOT)
+        {
+            continue;
+        }
+
+        if ((key >= removedFirst) && (key < first))
+        {
+            release(slot);
+        }
+        else if (key >= first)
+        {
+            keys[slot] = key + delta;
+        }
+    }
+
+    /*  Move misplaced cells to their set: into an empty slot, by swapping
+        with a cell that is misplaced too, or else by replacing the least
+        recently used cell there. Every step settles one cell.
+    */
+    for (uint32_t slot = 0; slot < size; slot++)
+    {
+        while ((keys[slot] != EMPTY_SLOT) && ((keys[slot] % sets) != (slot / ways)))
+        {
+            uint32_t target = (keys[slot] % sets) * ways;
+            uint32_t empty = EMPTY_SLOT;
+            uint32_t misplaced = EMPTY_SLOT;
+            uint32_t oldest = EMPTY_SLOT;
+
+            for (uint32_t candidate = target; candidate < target + ways; candidate++)
+            {
+                if (keys[candidate] == EMPTY_SLOT)
+                {
+                    empty = candidate;
+                    break;
+                }
+
+                if ((keys[candidate] % sets) != (candidate / ways))
+                {
+                    misplaced = candidate;
+                }
+                else if ((oldest == EMPTY_SLOT)
+                         || (useCounter - lastUse[candidate] > useCounter - lastUse[oldest]))
+                {
+                    oldest = candidate;
+                }
+            }
+
+            if (empty != EMPTY_SLOT)
+            {
+                swapSlots(slot, empty);
+            }
+            else if (misplaced != EMPTY_SLOT)
+            {
+                swapSlots(slot, misplaced);
+            }
+            else if (useCounter - lastUse[slot] < useCounter - lastUse[oldest])
+            {
+                evictions++;
+                release(oldest);
+                swapSlots(slot, oldest);
+            }
+            else
+            {
+                evictions++;
+                release(slot);
+            }
+        }
+    }
+}
+
+/*  The pool shares the budget of the cache.
+*/
+void UICellCache::setPool(UICellPool* _pool)
+{
+    SharedPointer<UICacheBudget> noBudget;
+
+    if (pool != NULL)
+    {
+        pool->setBudget(noBudget);
+    }
+
+    pool = _pool;
+
+    if (pool != NULL)
+    {
+        pool->setBudget(budget);
+    }
+}
+
+void UICellCache::setBudget(SharedPointer<UICacheBudget>& _budget)
+{
+    if (budget != NULL)
+    {
+        budget->remove(retainedBytes);
+        budget->detach(this);
+    }
+
+    budget = _budget;
+
+    if (budget != NULL)
+    {
+        budget->add(retainedBytes);
+        budget->attach(this);
+    }
+
+    if (pool != NULL)
+    {
+        pool->setBudget(budget);
+    }
+}
+
+void UICellCache::refresh()
+{
+    for (uint32_t slot = 0; slot < size; slot++)
+    {
+        account(slot);
+    }
+}
+
+uint32_t UICellCache::trim(uint32_t _keepFirst, uint32_t _keepEnd)
+{
+    if (budget == NULL)
+    {
+        return 0;
+    }
+
+    keepFirst = _keepFirst;
+    keepEnd = _keepEnd;
+
+    refresh();
+
+    uint32_t evicted = shrink();
+
+    /* the rest of the budget is held by other caches */
+    if (budget->isExceeded())
+    {
+        budget->reclaim(this);
+    }
+
+    return evicted;
+}
+
+uint32_t UICellCache::shrink()
+{
+    if (budget == NULL)
+    {
+        return 0;
+    }
+
+    uint32_t evicted = 0;
+
+    while (budget->isExceeded())
+    {
+        /* pooled cells are not shown anywhere, they go first */
+        if ((pool != NULL) && pool->drop())
+        {
+            continue;
+        }
+
+        /* least recently used cell of the whole cache, not just one set */
+        uint32_t slot = EMPTY_SLOT;
+        uint32_t oldest = 0;
+
+        for (uint32_t candidate = 0; candidate < size; candidate++)
+        {
+            uint32_t key = keys[candidate];
+
+            if ((key == EMPTY_SLOT) || ((key >= keepFirst) && (key < keepEnd)))
+            {
+                continue;
+            }
+
+            /* wrap-safe age */
+            uint32_t age = useCounter - lastUse[candidate];
+
+            if ((slot == EMPTY_SLOT) || (age > oldest))
+            {
+                slot = candidate;
+                oldest = age;
+            }
+        }
+
+        /* only spared rows left */
+        if (slot == EMPTY_SLOT)
+        {
+            break;
+        }
+
+        release(slot);
+        evicted++;
+    }
+
+    trimmed += evicted;
+
+    return evicted;
+}
+
+uint32_t UICellCache::getRetainedBytes() const
+{
+    return retainedBytes;
+}
+
+uint32_t UICellCache::getSize() const
+{
+    return size;
+}
+
+SharedPointer<UIView>& UICellCache::getSlot(uint32_t slot)
+{
+    return (slot < size) ? cells[slot] : none;
+}
+
+uint32_t UICellCache::getWays() const
+{
+    return ways;
+}
+
+uint32_t UICellCache::getHits() const
+{
+    return hits;
+}
+
+uint32_t UICellCache::getMisses() const
+{
+    return misses;
+}
+
+uint32_t UICellCache::getEvictions() const
+{
+    return evictions;
+}
+
+uint32_t UICellCache::getRefetches() const
+{
+    return refetches;
+}
+
+uint32_t UICellCache::getWastedPrefetches() const
+{
+    return wastedPrefetches;
+}
+
+uint32_t UICellCache::getTrimmed() const
+{
+    return trimmed;
+}
+
+void UICellCache::resetStatistics()
+{
+    hits = 0;
+    misses = 0;
+    evictions = 0;
+    refetches = 0;
+    wastedPrefetches = 0;
+    trimmed = 0;
+}
@@ -0,0 +1,194 @@
+/* mbed
+ * Copyright (c) 2006-2015 ARM Limited
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#include "UIFramework/UICellPool.h"
+
+
+UICellPool::UICellPool(uint32_t _capacity)
+    :   cells(NULL),
+        bytes(NULL),
+        capacity(_capacity),
+        size(0),
+        budget(),
+        retainedBytes(0),
+        recycled(0),
+        reused(0),
+        dropped(0)
+{
+    if (capacity > 0)
+    {
+        cells = new SharedPointer<UIView>[capacity];
+        bytes = new uint32_t[capacity];
+    }
+}
+
+UICellPool::~UICellPool()
+{
+    if (budget != NULL)
+    {
+        budget->remove(retainedBytes);
+    }
+
+    delete[] cells;
+    delete[] bytes;
+}
+
+bool UICellPool::recycle(SharedPointer<UIView>& cell)
+{
+    /* cells still drawn or held by someone else cannot be handed out */
+    if ((cell == NULL) || (cell->getReuseType() == 0) || (cell.use_count() > 1))
+    {
+        return false;
+    }
+
+    if (size == capacity)
+    {
+        dropped++;
+
+        return false;
+    }
+
+    /* cells are suspended before they are pooled, this is what is left */
+    cells[size] = cell;
+    bytes[size] = cell->getRetainedBytes();
+    retainedBytes += bytes[size];
+
+    if (budget != NULL)
+    {
+        budget->add(bytes[size]);
+    }
+
+    size++;
+    recycled++;
+
+    return true;
+}
+
+/*  Take the cell at index out of the pool, keeping the rest in the order
+    they were recycled.
+*/
+void UICellPool::removeAt(uint32_t index)
+{
+    retainedBytes -= bytes[index];
+
+    if (budget != NULL)
+    {
+        budget->remove(bytes[index]);
+    }
+
+    for (uint32_t next = index + 1; next < size; next++)
+    {
+        cells[next - 1] = cells[next];
+        bytes[next - 1] = bytes[next];
+    }
+
+    cells[size - 1] = SharedPointer<UIView>();
+    size--;
+}
+
+SharedPointer<UIView> UICellPool::dequeue(uint32_t type)
+{
+    /* most recently recycled first */
+    for (uint32_t index = size; index > 0; index--)
+    {
+        if (cells[index - 1]->getReuseType() == type)
+        {
+            SharedPointer<UIView> cell = cells[index - 1];
+
+            removeAt(index - 1);
+            reused++;
+
+            cell->prepareForReuse();
+
+            return cell;
+        }
+    }
+
+    return SharedPointer<UIView>();
+}
+
+void UICellPool::clear()
+{
+    while (size > 0)
+    {
+        removeAt(size - 1);
+    }
+}
+
+bool UICellPool::drop()
+{
+    if (size == 0)
+    {
+        return false;
+    }
+
+    removeAt(0);
+    dropped++;
+
+    return true;
+}
+
+void UICellPool::setBudget(SharedPointer<UICacheBudget>& _budget)
+{
+    if (budget != NULL)
+    {
+        budget->remove(retainedBytes);
+    }
+
+    budget = _budget;
+
+    if (budget != NULL)
+    {
+        budget->add(retainedBytes);
+    }
+}
+
+uint32_t UICellPool::getRetainedBytes() const
+{
+    return retainedBytes;
+}
+
+uint32_t UICellPool::getSize() const
+{
+    return size;
+}
+
+uint32_t UICellPool::getCapacity() const
+{
+    return capacity;
+}
+
+uint32_t UICellPool::getRecycled() const
+{
+    return recycled;
+}
+
+uint32_t UICellPool::getReused() const
+{
+    return reused;
+}
+
+uint32_t UICellPool::getDropped() const
+{
+    return dropped;
+}
+
+void UICellPool::resetStatistics()
+{
+    recycled = 0;
+    reused = 0;
+    dropped = 0;
+}
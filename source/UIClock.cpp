@@ -0,0 +1,91 @@
+/* mbed
+ * Copyright (c) 2006-2015 ARM Limited
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#include "UIFramework/UIClock.h"
+#include "UIFramework/UIPlatform.h"
+
+#if !UIF_HOST
+#include "mbed-hal/us_ticker_api.h"
+#endif
+
+
+namespace {
+
+uint32_t platformTime(void)
+{
+#if UIF_HOST
+    return minar::platform::getTime();
+#else
+    return us_ticker_read();
+#endif
+}
+
+uint32_t virtualTime = 0;
+
+uint32_t getVirtualTime(void)
+{
+    return virtualTime;
+}
+
+UIClock::source_t source = platformTime;
+
+/*  Millisecond counter is kept as whole milliseconds plus the microsecond
+    remainder, so no time is lost between reads.
+*/
+uint32_t lastMicroseconds = 0;
+uint32_t remainder = 0;
+uint32_t milliseconds = 0;
+
+} // namespace
+
+uint32_t UIClock::getTime()
+{
+    return source();
+}
+
+uint32_t UIClock::getTimeInMilliseconds()
+{
+    uint32_t now = source();
+
+    remainder += now - lastMicroseconds;
+    lastMicroseconds = now;
+
+    milliseconds += remainder / 1000;
+    remainder %= 1000;
+
+    return milliseconds;
+}
+
+void UIClock::setSource(source_t _source)
+{
+    source = (_source) ? _source : platformTime;
+
+    /* restart the millisecond counter from the new source */
+    lastMicroseconds = source();
+    remainder = 0;
+}
+
+void UIClock::setVirtualTime(uint32_t time)
+{
+    virtualTime = time;
+
+    setSource(getVirtualTime);
+}
+
+void UIClock::advanceVirtualTime(uint32_t time)
+{
+    virtualTime += time;
+}
@@ -0,0 +1,73 @@
+/* mbed
+ * Copyright (c) 2006-2015 ARM Limited
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#include "UIFramework/UIFileSource.h"
+
+
+UIFileSource::UIFileSource(const char* path)
+    :   file(fopen(path, "rb")),
+        length(0)
+{
+    if (file != NULL)
+    {
+        fseek(file, 0, SEEK_END);
+        length = ftell(file);
+    }
+}
+
+UIFileSource::UIFileSource(FILE* _file)
+    :   file(_file),
+        length(0)
+{
+    if (file != NULL)
+    {
+        fseek(file, 0, SEEK_END);
+        length = ftell(file);
+    }
+}
+
+UIFileSource::~UIFileSource()
+{
+    if (file != NULL)
+    {
+        fclose(file);
+    }
+}
+
+bool UIFileSource::isOpen() const
+{
+    return (file != NULL);
+}
+
+uint32_t UIFileSource::getLength()
+{
+    return length;
+}
+
+uint32_t UIFileSource::read(uint32_t offset, uint8_t* buffer, uint32_t size)
+{
+    if ((file == NULL) || (offset >= length))
+    {
+        return 0;
+    }
+
+    if (fseek(file, offset, SEEK_SET) != 0)
+    {
+        return 0;
+    }
+
+    return fread(buffer, 1, size, file);
+}
@@ -0,0 +1,165 @@
+/* mbed
+ * Copyright (c) 2006-2015 ARM Limited
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#include "UIFramework/UIFrameTelemetry.h"
+
+
+UIFrameTelemetry::UIFrameTelemetry()
+{
+    reset();
+}
+
+void UIFrameTelemetry::reset()
+{
+    for (uint32_t idx = 0; idx < TELEMETRY_RING_SIZE; idx++)
+    {
+        ring[idx].sequence = 0;
+        ring[idx].renderTime = 0;
+        ring[idx].transferTime = 0;
+        ring[idx].latency = 0;
+        ring[idx].callInterval = 0;
+        ring[idx].wakeups = 0;
+        ring[idx].flags = 0;
+    }
+
+    for (uint32_t histogram = 0; histogram < HISTOGRAM_COUNT; histogram++)
+    {
+        for (uint32_t bucket = 0; bucket < TELEMETRY_HISTOGRAM_BUCKETS; bucket++)
+        {
+            histograms[histogram][bucket] = 0;
+        }
+
+        maximum[histogram] = 0;
+    }
+
+    frames = 0;
+    droppedFrames = 0;
+    coalescedFrames = 0;
+    unchangedFrames = 0;
+    wakeups = 0;
+}
+
+void UIFrameTelemetry::addFrame(frame_t& frame)
+{
+    frame.sequence = frames;
+
+    ring[frames % TELEMETRY_RING_SIZE] = frame;
+    frames++;
+
+    addToHistogram(HISTOGRAM_RENDER, frame.renderTime);
+    addToHistogram(HISTOGRAM_LATENCY, frame.latency);
+
+    /* unchanged frames are not transferred */
+    if (frame.flags & FRAME_UNCHANGED)
+    {
+        unchangedFrames++;
+    }
+    else
+    {
+        addToHistogram(HISTOGRAM_TRANSFER, frame.transferTime);
+    }
+
+    if (frame.flags & FRAME_DROPPED)
+    {
+        droppedFrames++;
+    }
+
+    if (frame.flags & FRAME_COALESCED)
+    {
+        coalescedFrames++;
+    }
+}
+
+void UIFrameTelemetry::addWakeup()
+{
+    wakeups++;
+}
+
+void UIFrameTelemetry::addToHistogram(histogram_t histogram, uint32_t value)
+{
+    /* find first bucket with an upper bound above value */
+    uint32_t milliseconds = value / 1000;
+    uint32_t bucket = 0;
+
+    while ((bucket < (TELEMETRY_HISTOGRAM_BUCKETS - 1)) && (milliseconds >= (1UL << bucket)))
+    {
+        bucket++;
+    }
+
+    histograms[histogram][bucket]++;
+
+    if (value > maximum[histogram])
+    {
+        maximum[histogram] = value;
+    }
+}
+
+bool UIFrameTelemetry::getFrame(uint32_t age, frame_t& frame) const
+{
+    if ((age < frames) && (age < TELEMETRY_RING_SIZE))
+    {
+        frame = ring[(frames - 1 - age) % TELEMETRY_RING_SIZE];
+
+        return true;
+    }
+
+    return false;
+}
+
+uint32_t UIFrameTelemetry::getHistogram(histogram_t histogram, uint32_t bucket) const
+{
+    if ((histogram < HISTOGRAM_COUNT) && (bucket < TELEMETRY_HISTOGRAM_BUCKETS))
+    {
+        return histograms[histogram][bucket];
+    }
+
+    return 0;
+}
+
+uint32_t UIFrameTelemetry::getMaximum(histogram_t histogram) const
+{
+    if (histogram < HISTOGRAM_COUNT)
+    {
+        return maximum[histogram];
+    }
+
+    return 0;
+}
+
+uint32_t UIFrameTelemetry::getFrames() const
+{
+    return frames;
+}
+
+uint32_t UIFrameTelemetry::getDroppedFrames() const
+{
+    return droppedFrames;
+}
+
+uint32_t UIFrameTelemetry::getCoalescedFrames() const
+{
+    return coalescedFrames;
+}
+
+uint32_t UIFrameTelemetry::getUnchangedFrames() const
+{
+    return unchangedFrames;
+}
+
+uint32_t UIFrameTelemetry::getWakeups() const
+{
+    return wakeups;
+}
@@ -15,8 +15,11 @@
  */
 
 #include "UIFramework/UIFramework.h"
+#include "UIFramework/UIMatrixLCDDisplay.h"
 
-#include <sys/time.h>
+#include "UIFramework/UIClock.h"
+
+#include <string.h>
 
 #if (YOTTA_CFG_HARDWARE_WRD_SWO_PRESENT \
   && YOTTA_CFG_HARDWARE_WRD_SWO_ENABLED)
@@ -26,18 +29,95 @@
 #define UIF_PRINTF(...)
 #endif
 
+#if !UIF_HOST
 UIFramework::UIFramework(uif::MatrixLCD& _screen,
                          SharedPointer<UIView>& _baseView,
-                         uint32_t _frameLimit)
+                         uint32_t _frameLimit,
+                         uint32_t _bufferCount)
+    :   matrixLCD(new UIMatrixLCDDisplay(_screen)),
+        screen(*matrixLCD),
+        baseView(_baseView),
+        frameLimit(_frameLimit)
+{
+    // call helper function to initialise object
+    constructor(_bufferCount);
+}
+#endif
+
+UIFramework::UIFramework(UIDisplay& _screen,
+                         SharedPointer<UIView>& _baseView,
+                         uint32_t _frameLimit,
+                         uint32_t _bufferCount)
     :   screen(_screen),
         baseView(_baseView),
-        callInterval(ULONG_MAX),
-        screenBusy(false),
-        screenUpdateTaskNotPosted(true),
-        renderBufferTaskNotPosted(true),
-        frameReady(false),
         frameLimit(_frameLimit)
 {
+    // call helper function to initialise object
+    constructor(_bufferCount);
+}
+
+void UIFramework::constructor(uint32_t _bufferCount)
+{
+    callInterval = UINT32_MAX;
+    screenBusy = false;
+    screenUpdateTaskNotPosted = true;
+    renderBufferTaskNotPosted = true;
+    renderRequested = false;
+
+    /* telemetry */
+    pendingWakeups = 0;
+    wakeupTime = 0;
+    frameDue = 0;
+    framePeriod = 0;
+    frameDueValid = false;
+    lastTransferTime = 0;
+
+    /* reusable window for partial renders */
+    bandWindow = new UISubCanvas();
+    bandCanvas = SharedPointer<FrameBuffer>(bandWindow);
+
+    /*  Set up buffer pool. The canvas of each frame is taken from the
+        screen when the frame is rendered, so the pool cannot hold more
+        frames than the screen has buffers.
+    */
+    if (_bufferCount > screen.getBufferCount())
+    {
+        _bufferCount = screen.getBufferCount();
+    }
+
+    if (_bufferCount == 0)
+    {
+        _bufferCount = 1;
+    }
+
+    buffers = new buffer_t[_bufferCount];
+    bufferCount = _bufferCount;
+    bufferSequence = 0;
+    sendingBuffer = NULL;
+
+    for (uint32_t idx = 0; idx < bufferCount; idx++)
+    {
+        buffers[idx].state = BUFFER_FREE;
+        buffers[idx].sequence = 0;
+        buffers[idx].tracked = false;
+        buffers[idx].dirtyLines = NULL;
+        buffers[idx].dirtyLineCount = 0;
+        buffers[idx].damage = UIView::Rect(0, 0, SHRT_MAX, SHRT_MAX);
+    }
+
+    UIF_PRINTF("Framework: buffers: %lu\r\n", bufferCount);
+
+    /* line buffers are allocated when the first frame has been rendered */
+    lastFrame = NULL;
+    numberOfLines = 0;
+    lineWidth = 0;
+    dirtyLineTracking = false;
+    forceAllLines = true;
+    idleFrameElision = false;
+    partialRendering = false;
+
+    resetStatistics();
+
     /* Post once to get the screen started. This call starts the initial screen drawing.
     */
     minar::Scheduler::postCallback(this, &UIFramework::wakeupTask);
@@ -48,41 +128,249 @@ UIFramework::UIFramework(uif::MatrixLCD& _screen,
     baseView->setWakeupCallback(wakeup);
 }
 
+UIFramework::~UIFramework()
+{
+    for (uint32_t idx = 0; idx < bufferCount; idx++)
+    {
+        delete[] buffers[idx].dirtyLines;
+    }
+
+    delete[] buffers;
+    delete[] lastFrame;
+}
+
+/*  Find buffer in the given state. For READY buffers the oldest one is
+    returned so frames are sent in the order they were rendered.
+*/
+UIFramework::buffer_t* UIFramework::getBuffer(buffer_state_t state)
+{
+    buffer_t* found = NULL;
+
+    for (uint32_t idx = 0; idx < bufferCount; idx++)
+    {
+        if (buffers[idx].state == state)
+        {
+            if ((found == NULL) || ((int32_t)(buffers[idx].sequence - found->sequence) < 0))
+            {
+                found = &buffers[idx];
+            }
+        }
+    }
+
+    return found;
+}
+
+/*  Get the canvas for the next frame from the screen. The lines each canvas
+    has missed are only known for canvases the screen has handed out before,
+    so the canvas is given to the free buffer that last used it. A canvas
+    that has not been seen before, such as a new object wrapping the same
+    memory, is rendered in full.
+*/
+UIFramework::buffer_t* UIFramework::takeCanvas(buffer_t* buffer)
+{
+    SharedPointer<FrameBuffer> canvas = screen.getFrameBuffer();
+
+    buffer_t* previous = NULL;
+    buffer_t* unused = NULL;
+
+    for (uint32_t idx = 0; idx < bufferCount; idx++)
+    {
+        if (buffers[idx].canvas.get() == canvas.get())
+        {
+            /* the screen must not hand out a buffer that is still in use */
+            MBED_ASSERT(buffers[idx].state == BUFFER_FREE);
+
+            previous = &buffers[idx];
+        }
+        else if ((buffers[idx].canvas.get() == NULL) && (buffers[idx].state == BUFFER_FREE))
+        {
+            unused = &buffers[idx];
+        }
+    }
+
+    if (previous)
+    {
+        buffer = previous;
+    }
+    else
+    {
+        /* keep the canvases seen so far for as long as possible */
+        if (unused)
+        {
+            buffer = unused;
+        }
+
+        buffer->damage = UIView::Rect(0, 0, SHRT_MAX, SHRT_MAX);
+    }
+
+    buffer->canvas = canvas;
+
+    return buffer;
+}
+
+/*  Post render task if a buffer is available. Otherwise the task is posted
+    when the screen returns a buffer to the pool.
+*/
+void UIFramework::postRenderTask()
+{
+    if (renderBufferTaskNotPosted)
+    {
+        if (getBuffer(BUFFER_FREE))
+        {
+            renderBufferTaskNotPosted = false;
+            renderRequested = false;
+
+            minar::Scheduler::postCallback(this, &UIFramework::renderViewToCurrentBuffer)
+                .tolerance(minar::milliseconds(0));
+        }
+        else
+        {
+            renderRequested = true;
+        }
+    }
+}
+
 void UIFramework::renderViewToCurrentBuffer()
 {
     renderBufferTaskNotPosted = true;
 
+    /*  Nothing in the view tree has changed since the last frame. Skip both
+        rendering and transfer, but keep polling at the requested interval
+        since views like UITextMonitorView only notice changes when asked.
+    */
+    if (idleFrameElision && !baseView->isDirty())
+    {
+        UIF_PRINTF("Framework: render: idle\r\n");
+
+        elidedFrames++;
+        pendingWakeups = 0;
+        frameDueValid = false;
+
+        /* animating views are dirty, so an animation has come to an end */
+        if (callInterval == 0)
+        {
+            callInterval = UINT32_MAX;
+        }
+
+        /* while the screen is busy the next wakeup is posted when it is done */
+        if (!screenBusy && (callInterval != UINT32_MAX))
+        {
+            minar::Scheduler::postCallback(this, &UIFramework::wakeupTask)
+                .tolerance(minar::milliseconds(0))
+                .delay(minar::milliseconds((callInterval > frameLimit) ? callInterval : frameLimit));
+        }
+
+        return;
+    }
+
+    /* Grab buffer not owned by the screen */
+    buffer_t* buffer = getBuffer(BUFFER_FREE);
+
+    if (buffer == NULL)
+    {
+        renderRequested = true;
+        return;
+    }
+
+    buffer = takeCanvas(buffer);
+
     /* calculate frame to screen time */
-    uint32_t renderStart = 0;
+    uint32_t renderStart = UIClock::getTime();
     uint32_t frameRate = 0;
-    struct timeval now;
-
-    /* start timer */
-    gettimeofday(&now, NULL);
-    renderStart = (now.tv_sec * 1000) + (now.tv_usec / 1000);
-
-    /* Grab buffer not used by screen */
-/*
-    struct CompBuf canvas = {
-      .buf  = screen.getBuffer(),
-      .mask = (uint8_t*)Comp_Fill_Ones,
-      .bit_offset = 0,
-      .stride_bytes = stride,
-      .width_bits   = width,
-      .height_strides = height
-    };
-*/
-    canvas = screen.getFrameBuffer();
+
+    /*  Start telemetry record. Wakeups that arrived since the last render
+        are all served by this frame.
+    */
+    buffer->frame.flags = 0;
+    buffer->frame.wakeups = pendingWakeups;
+    buffer->wakeupTime = (pendingWakeups > 0) ? wakeupTime : renderStart;
+
+    if (pendingWakeups > 1)
+    {
+        buffer->frame.flags |= UIFrameTelemetry::FRAME_COALESCED;
+    }
+
+    /* late by at least one frame period */
+    if (frameDueValid && !UIClock::isBefore(renderStart, frameDue + framePeriod))
+    {
+        buffer->frame.flags |= UIFrameTelemetry::FRAME_DROPPED;
+    }
+
+    pendingWakeups = 0;
+
+    /*  Find the lines to render: the area that changed in the view tree,
+        plus the lines that changed while this buffer was not in use.
+    */
+    int16_t canvasWidth = buffer->canvas->getWidth();
+    int16_t canvasHeight = buffer->canvas->getHeight();
+    int16_t top = 0;
+    int16_t bottom = canvasHeight;
+
+    UIView::Rect changed(0, 0, canvasWidth, canvasHeight);
+
+    if (partialRendering)
+    {
+        UIView::Rect region = baseView->getDirtyRect();
+
+        region.intersect(changed);
+
+        /* the tree reports no change when it is not tracking changes */
+        if (!region.isEmpty())
+        {
+            changed = region;
+
+            region.unite(buffer->damage);
+            region.intersect(UIView::Rect(0, 0, canvasWidth, canvasHeight));
+
+            top = region.y0;
+            bottom = region.y1;
+        }
+    }
 
     /* fill canvas. return value is the requested refresh rate in millisecond. */
-    callInterval = baseView->fillFrameBuffer(canvas, 0, 0);
+    if ((top == 0) && (bottom == canvasHeight))
+    {
+        callInterval = baseView->fillFrameBuffer(buffer->canvas, 0, 0);
+    }
+    else
+    {
+        UIF_PRINTF("Framework: render: lines %d %d\r\n", top, bottom);
+
+        /*  Render the band of lines by translating the view tree. The
+            interval is the one requested by the views drawn in this frame;
+            views outside the band did not change, see UIView::getDirtyRect.
+        */
+        bandWindow->setWindow(buffer->canvas.get(), 0, top, canvasWidth, bottom - top);
+
+        callInterval = baseView->fillFrameBuffer(bandCanvas, 0, -top);
+
+        bandWindow->clearWindow();
+    }
+
+    baseView->clearDirty();
+
+    renderedLines += bottom - top;
+
+    /* the other buffers are now out of date where the tree changed */
+    buffer->damage = UIView::Rect();
+
+    for (uint32_t idx = 0; idx < bufferCount; idx++)
+    {
+        if (&buffers[idx] != buffer)
+        {
+            buffers[idx].damage.unite(changed);
+        }
+    }
 
     /* end timer */
-    gettimeofday(&now, NULL);
-    frameRate = (now.tv_sec * 1000) + (now.tv_usec / 1000) - renderStart;
+    uint32_t renderEnd = UIClock::getTime();
+
+    buffer->frame.renderTime = renderEnd - renderStart;
+    buffer->frame.callInterval = callInterval;
+    frameRate = buffer->frame.renderTime / 1000;
 
-    /* adjust call interval to account for rendering time if not ULONG_MAX */
-    if (callInterval != ULONG_MAX)
+    /* adjust call interval to account for rendering time if not UINT32_MAX */
+    if (callInterval != UINT32_MAX)
     {
         callInterval = (callInterval < frameRate) ? 0 : callInterval - frameRate;
 
@@ -95,36 +383,192 @@ void UIFramework::renderViewToCurrentBuffer()
 
     UIF_PRINTF("Framework: render: %lu %u\r\n", frameRate, callInterval);
 
-    /*  If a frame is already being sent, wait. Otherwise initiate screen
-        transfer.
+    /*  Frame period is the requested interval, but never shorter than what
+        the screen can transfer.
     */
-    if (screenBusy)
+    if (callInterval != UINT32_MAX)
     {
-        frameReady = true;
+        frameDue = renderEnd + (callInterval * 1000);
+        framePeriod = (callInterval * 1000 > lastTransferTime) ? callInterval * 1000 : lastTransferTime;
+        frameDueValid = true;
     }
     else
+    {
+        frameDueValid = false;
+    }
+
+    /* compare the new frame with the one already queued for the screen */
+    buffer->tracked = dirtyLineTracking;
+
+    if (dirtyLineTracking)
+    {
+        findDirtyLines(*buffer);
+    }
+
+    /* hand buffer over to the screen */
+    buffer->state = BUFFER_READY;
+    buffer->sequence = bufferSequence++;
+
+    renderedFrames++;
+
+    /*  If a frame is already being sent, it is queued. Otherwise initiate
+        screen transfer.
+    */
+    if (!screenBusy)
     {
         screenBusy = true;
 
-        /*  If animation is in progress schedule the next screen calculation to
-            start when transfer starts.
-        */
-        if (callInterval == 0)
+        transferBuffer();
+    }
+
+    /*  If animation is in progress render the next frame into a free buffer
+        while this one is being sent.
+    */
+    if (callInterval == 0)
+    {
+        postRenderTask();
+    }
+}
+
+/*  Send the oldest READY buffer to the screen.
+*/
+void UIFramework::transferBuffer()
+{
+    buffer_t* buffer = getBuffer(BUFFER_READY);
+
+    if (buffer == NULL)
+    {
+        screenBusy = false;
+        return;
+    }
+
+    buffer->state = BUFFER_SENDING;
+    buffer->transferStart = UIClock::getTime();
+    sendingBuffer = buffer;
+
+    FunctionPointer onStart;
+    FunctionPointer onFinish(this, &UIFramework::copyBufferToScreenDone);
+
+    if (buffer->tracked && (buffer->dirtyLineCount == 0))
+    {
+        UIF_PRINTF("Framework: screen: unchanged\r\n");
+
+        buffer->frame.flags |= UIFrameTelemetry::FRAME_UNCHANGED;
+
+        /* Nothing changed, skip the transfer and return the buffer. */
+        minar::Scheduler::postCallback(this, &UIFramework::copyBufferToScreenDone)
+            .tolerance(minar::milliseconds(0));
+    }
+    else if (buffer->tracked && screen.canSendLines())
+    {
+        transferredFrames++;
+        transferredLines += buffer->dirtyLineCount;
+        transferredBytes += screen.getTransferSize(lineWidth, buffer->dirtyLineCount);
+
+        screen.sendFrameBufferLines(buffer->canvas, buffer->dirtyLines, onStart, onFinish);
+    }
+    else
+    {
+        /* untracked, or the screen cannot address individual lines */
+        uint16_t width = buffer->canvas->getWidth();
+        uint16_t height = buffer->canvas->getHeight();
+
+        transferredFrames++;
+        transferredLines += height;
+        transferredBytes += screen.getTransferSize(width, height);
+
+        screen.sendFrameBuffer(buffer->canvas, onStart, onFinish);
+    }
+}
+
+/*  Compare each line in the canvas with the same line in the previous frame
+    and keep a copy of the lines that differ. Sets a bit in dirtyLines for
+    every line that differs. Frames on screens without access to the line
+    memory are left untracked.
+*/
+void UIFramework::findDirtyLines(buffer_t& buffer)
+{
+    SharedPointer<FrameBuffer>& canvas = buffer.canvas;
+
+    if (screen.getLine(canvas, 0) == NULL)
+    {
+        buffer.tracked = false;
+        forceAllLines = true;
+        return;
+    }
+
+    uint16_t height = canvas->getHeight();
+    uint16_t width = canvas->getWidth();
+    uint16_t lineBytes = (width + 7) / 8;
+
+    /* compare whole bytes, and only the used bits of the last one */
+    uint16_t fullBytes = width / 8;
+    uint8_t tailMask = (1 << (width % 8)) - 1;
+
+    /* (re)allocate the frame copy if the screen dimensions changed */
+    if ((lastFrame == NULL) || (height != numberOfLines) || (width != lineWidth))
+    {
+        delete[] lastFrame;
+
+        lastFrame = new uint8_t[height * lineBytes];
+    }
+
+    if (height != numberOfLines)
+    {
+        numberOfLines = height;
+
+        uint32_t bitmapSize = (numberOfLines + 7) / 8;
+
+        for (uint32_t idx = 0; idx < bufferCount; idx++)
         {
-            renderBufferTaskNotPosted = false;
+            delete[] buffers[idx].dirtyLines;
+            buffers[idx].dirtyLines = new uint8_t[bitmapSize];
+
+            /* frames already queued must be sent in full */
+            for (uint32_t byte = 0; byte < bitmapSize; byte++)
+            {
+                buffers[idx].dirtyLines[byte] = 0xFF;
+            }
+
+            buffers[idx].dirtyLineCount = numberOfLines;
+        }
+
+        forceAllLines = true;
+    }
+
+    /* a change in width invalidates the previous frame */
+    bool forceAll = forceAllLines || (width != lineWidth);
+
+    forceAllLines = false;
+    lineWidth = width;
+
+    uint8_t* dirtyLines = buffer.dirtyLines;
+    uint32_t dirtyLineCount = 0;
+
+    for (uint16_t line = 0; line < numberOfLines; line++)
+    {
+        uint8_t* previous = &lastFrame[line * lineBytes];
+        const uint8_t* current = screen.getLine(canvas, line);
 
-            FunctionPointer onStart(this, &UIFramework::renderViewToCurrentBuffer);
-            FunctionPointer onFinish(this, &UIFramework::copyBufferToScreenDone);
+        bool changed = forceAll
+                       || (memcmp(current, previous, fullBytes) != 0)
+                       || ((tailMask != 0) && ((current[fullBytes] ^ previous[fullBytes]) & tailMask));
 
-            screen.sendFrameBuffer(canvas, onStart, onFinish);
+        if (changed)
+        {
+            memcpy(previous, current, lineBytes);
+            dirtyLines[line / 8] |= (1 << (line % 8));
+            dirtyLineCount++;
         }
         else
         {
-            FunctionPointer onFinish(this, &UIFramework::copyBufferToScreenDone);
-
-            screen.sendFrameBuffer(canvas, 0, onFinish);
+            dirtyLines[line / 8] &= ~(1 << (line % 8));
         }
     }
+
+    buffer.dirtyLineCount = dirtyLineCount;
+
+    UIF_PRINTF("Framework: dirty lines: %lu\r\n", dirtyLineCount);
 }
 
 /* Call back block for when the screen transfer is complete */
@@ -132,33 +576,57 @@ void UIFramework::copyBufferToScreenDone()
 {
     UIF_PRINTF("Framework: screen: done\r\n");
 
-    if (frameReady)
+    /* return buffer to the renderer */
+    if (sendingBuffer)
     {
-        frameReady = false;
+        uint32_t now = UIClock::getTime();
 
-        if (callInterval == 0)
+        /*  A frame cannot be rendered before a buffer is available, so a
+            renderer waiting for this buffer is not late until now.
+        */
+        if (frameDueValid && (getBuffer(BUFFER_FREE) == NULL) && UIClock::isBefore(frameDue, now))
         {
-            renderBufferTaskNotPosted = false;
+            frameDue = now;
+        }
 
-            FunctionPointer onStart(this, &UIFramework::renderViewToCurrentBuffer);
-            FunctionPointer onFinish(this, &UIFramework::copyBufferToScreenDone);
+        sendingBuffer->frame.transferTime = now - sendingBuffer->transferStart;
+        sendingBuffer->frame.latency = now - sendingBuffer->wakeupTime;
 
-            screen.sendFrameBuffer(canvas, onStart, onFinish);
+        if (!(sendingBuffer->frame.flags & UIFrameTelemetry::FRAME_UNCHANGED))
+        {
+            lastTransferTime = sendingBuffer->frame.transferTime;
+        }
+
+        telemetry.addFrame(sendingBuffer->frame);
+
+        sendingBuffer->state = BUFFER_FREE;
+        sendingBuffer = NULL;
+    }
+
+    /* send next frame in queue, if any */
+    transferBuffer();
+
+    if (renderRequested)
+    {
+        /* a render was waiting for a free buffer */
+        renderRequested = false;
+
+        if ((callInterval == 0) || (frameLimit == 0))
+        {
+            postRenderTask();
         }
         else
         {
-            FunctionPointer onFinish(this, &UIFramework::copyBufferToScreenDone);
-
-            screen.sendFrameBuffer(canvas, 0, onFinish);
+            minar::Scheduler::postCallback(this, &UIFramework::wakeupTask)
+                .tolerance(minar::milliseconds(0))
+                .delay(minar::milliseconds(frameLimit));
         }
     }
-    else
+    else if (!screenBusy && renderBufferTaskNotPosted)
     {
-        screenBusy = false;
-
         /* use the callback interval to set sleep time */
         /* Note: callback delay cannot be greater than time wrap-around. */
-        if (callInterval != ULONG_MAX)
+        if (callInterval != UINT32_MAX)
         {
             UIF_PRINTF("Framework: callback: %lu\r\n", callInterval);
 
@@ -173,20 +641,10 @@ void UIFramework::copyBufferToScreenDone()
 */
 void UIFramework::updateScreen()
 {
-    /*  Only one render task can be posted at a time and it should only
-        be posted if there isn't already a new frame ready in the buffer.
+    /*  Only one render task can be posted at a time. If all buffers are
+        owned by the screen the render is deferred until one is returned.
     */
-    if (renderBufferTaskNotPosted && !frameReady)
-    {
-        renderBufferTaskNotPosted = false;
-
-        minar::Scheduler::postCallback(this, &UIFramework::renderViewToCurrentBuffer)
-            .tolerance(minar::milliseconds(0));
-    }
-    else
-    {
-        callInterval = frameLimit;
-    }
+    postRenderTask();
 
     screenUpdateTaskNotPosted = true;
 }
@@ -197,6 +655,19 @@ void UIFramework::wakeupTask()
 {
     UIF_PRINTF("Framework: wakeup requested\r\n");
 
+    telemetry.addWakeup();
+
+    /* remember when the first wakeup since the last render arrived */
+    if (pendingWakeups == 0)
+    {
+        wakeupTime = UIClock::getTime();
+    }
+
+    if (pendingWakeups < 0xFFFF)
+    {
+        pendingWakeups++;
+    }
+
     if (screenUpdateTaskNotPosted)
     {
         UIF_PRINTF("Framework: update\r\n");
@@ -218,3 +689,104 @@ uint32_t UIFramework::getFrameLimit(void) const
 {
     return frameLimit;
 }
+
+/*  Frame timing telemetry.
+*/
+const UIFrameTelemetry& UIFramework::getTelemetry(void) const
+{
+    return telemetry;
+}
+
+void UIFramework::resetTelemetry(void)
+{
+    telemetry.reset();
+}
+
+uint32_t UIFramework::getBufferCount(void) const
+{
+    return bufferCount;
+}
+
+/*  Enable/disable dirty line tracking.
+*/
+void UIFramework::setDirtyLineTracking(bool enable)
+{
+    /* the frame copy is not updated while tracking is disabled */
+    if (enable && !dirtyLineTracking)
+    {
+        forceAllLines = true;
+    }
+
+    dirtyLineTracking = enable;
+}
+
+bool UIFramework::getDirtyLineTracking(void) const
+{
+    return dirtyLineTracking;
+}
+
+/*  Enable/disable idle frame elision.
+*/
+void UIFramework::setIdleFrameElision(bool enable)
+{
+    idleFrameElision = enable;
+}
+
+bool UIFramework::getIdleFrameElision(void) const
+{
+    return idleFrameElision;
+}
+
+/*  Enable/disable partial rendering.
+*/
+void UIFramework::setPartialRendering(bool enable)
+{
+    partialRendering = enable;
+}
+
+bool UIFramework::getPartialRendering(void) const
+{
+    return partialRendering;
+}
+
+/*  Transfer statistics.
+*/
+uint32_t UIFramework::getRenderedFrames(void) const
+{
+    return renderedFrames;
+}
+
+uint32_t UIFramework::getTransferredFrames(void) const
+{
+    return transferredFrames;
+}
+
+uint32_t UIFramework::getTransferredLines(void) const
+{
+    return transferredLines;
+}
+
+uint32_t UIFramework::getTransferredBytes(void) const
+{
+    return transferredBytes;
+}
+
+uint32_t UIFramework::getRenderedLines(void) const
+{
+    return renderedLines;
+}
+
+uint32_t UIFramework::getElidedFrames(void) const
+{
+    return elidedFrames;
+}
+
+void UIFramework::resetStatistics(void)
+{
+    renderedFrames = 0;
+    transferredFrames = 0;
+    transferredLines = 0;
+    transferredBytes = 0;
+    elidedFrames = 0;
+    renderedLines = 0;
+}
@@ -0,0 +1,727 @@
+/* mbed
+ * Copyright (c) 2006-2015 ARM Limited
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#include "UIFramework/UIGridView.h"
+
+#include "UIFramework/UIPlatform.h"
+#include "UIFramework/UIClock.h"
+
+
+#if 0
+#include <stdio.h>
+#define UIF_PRINTF(...) { printf(__VA_ARGS__); }
+#else
+#define UIF_PRINTF(...)
+#endif
+
+/*  Row heights, or column widths, of a grid presented as the heights of an
+    array, so UIHeightIndex can index both directions.
+*/
+class UIGridExtents : public UIView::Array
+{
+public:
+    UIGridExtents(const UIView::Array& _array, uint32_t _columns, bool _rows)
+        :   array(_array),
+            columns(_columns),
+            rows(_rows)
+    {}
+
+    virtual uint32_t getSize(void) const
+    {
+        uint32_t size = array.getSize();
+
+        if (rows)
+        {
+            return (size + columns - 1) / columns;
+        }
+
+        return (size < columns) ? size : columns;
+    }
+
+    virtual SharedPointer<UIView> viewAtIndex(uint32_t index) const
+    {
+        (void) index;
+
+        return SharedPointer<UIView>();
+    }
+
+    /* first cell of the row, or cell of the first row in the column */
+    virtual uint32_t heightAtIndex(uint32_t index) const
+    {
+        return (rows) ? array.heightAtIndex(index * columns) : array.widthAtIndex(index);
+    }
+
+    virtual uint32_t widthAtIndex(uint32_t index) const
+    {
+        (void) index;
+
+        return 0;
+    }
+
+    virtual uint32_t getUniformHeight(void) const
+    {
+        return (rows) ? array.getUniformHeight() : 0;
+    }
+
+    virtual const char* getTitle(void) const
+    {
+        return NULL;
+    }
+
+private:
+    const UIView::Array& array;
+    uint32_t columns;
+    bool rows;
+};
+
+
+UIGridView::UIGridView(SharedPointer<UIView::Array>& _array,
+                       uint32_t _columns,
+                       uint32_t _cacheSize,
+                       uint32_t _cacheWays)
+    :   UIView(),
+        array(_array),
+        columns(_columns),
+        rowIndex(),
+        columnIndex(),
+        indexedSize(0),
+        positionX(0),
+        positionY(0),
+        outstandingX(0),
+        outstandingY(0),
+        velocityX(0),
+        velocityY(0),
+        cellPool(),
+        cellCache(_cacheSize, _cacheWays),
+        cellWindow(new UISubCanvas()),
+        cellCanvas(cellWindow),
+        prefetchQueue(DEFAULT_GRID_PREFETCH_CELLS),
+        prefetchCallbackHandle(NULL),
+        visibleFirstRow(0),
+        visibleEndRow(0),
+        visibleFirstColumn(0),
+        visibleEndColumn(0),
+        renderedCells(0)
+{
+    /* background and cells cover the whole grid */
+    opaque = true;
+
+    cellCache.setPool(&cellPool);
+
+    /* force the first index to be built */
+    indexedSize = array->getSize() + 1;
+
+    array->addListener(this);
+}
+
+UIGridView::~UIGridView()
+{
+    array->removeListener(this);
+
+    // Cancel any callbacks that might have been scheduled but not executed
+    if (prefetchCallbackHandle)
+    {
+        minar::Scheduler::cancelCallback(prefetchCallbackHandle);
+    }
+}
+
+void UIGridView::scrollPx(int32_t x, int32_t y)
+{
+    outstandingX += x;
+    outstandingY += y;
+}
+
+void UIGridView::setPosition(uint32_t x, uint32_t y)
+{
+    positionX = x;
+    positionY = y;
+    outstandingX = 0;
+    outstandingY = 0;
+
+    UIView::markDirty();
+}
+
+uint32_t UIGridView::getPositionX()
+{
+    return positionX;
+}
+
+uint32_t UIGridView::getPositionY()
+{
+    return positionY;
+}
+
+uint32_t UIGridView::getRows()
+{
+    updateIndex();
+
+    return rowIndex.getSize();
+}
+
+uint32_t UIGridView::getColumns()
+{
+    updateIndex();
+
+    return columnIndex.getSize();
+}
+
+void UIGridView::reloadGrid()
+{
+    indexedSize = array->getSize() + 1;
+    updateIndex();
+
+    cellCache.clear();
+
+    UIView::markDirty();
+}
+
+/*  Cells keep their content when they move to another row or column, so
+    cached cells are shifted along with their index. The sizes of every row
+    and column after the change may differ, so the index is built again.
+*/
+void UIGridView::cellsMoved(uint32_t first, int32_t delta)
+{
+    cellCache.shift(first, delta);
+    prefetchQueue.clear();
+
+    indexedSize = array->getSize() + 1;
+
+    UIView::markDirty();
+}
+
+void UIGridView::rowsInserted(uint32_t first, uint32_t count)
+{
+    cellsMoved(first, count);
+}
+
+void UIGridView::rowsDeleted(uint32_t first, uint32_t count)
+{
+    cellsMoved(first + count, -((int32_t) count));
+}
+
+/*  Updated cells are fetched again, and may have a new size.
+*/
+void UIGridView::rowsUpdated(uint32_t first, uint32_t count)
+{
+    for (uint32_t index = first; index < first + count; index++)
+    {
+        cellCache.remove(index);
+    }
+
+    indexedSize = array->getSize() + 1;
+
+    UIView::markDirty();
+}
+
+UICellCache& UIGridView::getCellCache()
+{
+    return cellCache;
+}
+
+UICellPool& UIGridView::getCellPool()
+{
+    return cellPool;
+}
+
+UIPrefetchQueue& UIGridView::getPrefetchQueue()
+{
+    return prefetchQueue;
+}
+
+uint32_t UIGridView::getRenderedCells() const
+{
+    return renderedCells;
+}
+
+/*  Rebuild the row and column positions when the number of cells changes.
+*/
+void UIGridView::updateIndex()
+{
+    uint32_t size = array->getSize();
+
+    if (size != indexedSize)
+    {
+        uint32_t perRow = (columns > 0) ? columns : size;
+
+        if (perRow == 0)
+        {
+            perRow = 1;
+        }
+
+        UIGridExtents rowHeights(*array, perRow, true);
+        UIGridExtents columnWidths(*array, perRow, false);
+
+        rowIndex.build(rowHeights);
+        columnIndex.build(columnWidths);
+
+        indexedSize = size;
+    }
+}
+
+/*  Apply the scrolling since the last frame, keeping the view within the
+    grid.
+*/
+void UIGridView::applyScroll()
+{
+    int32_t x = (int32_t) positionX - outstandingX;
+    int32_t y = (int32_t) positionY - outstandingY;
+
+    uint32_t totalWidth = columnIndex.getTotalHeight();
+    uint32_t totalHeight = rowIndex.getTotalHeight();
+    int32_t maxX = (totalWidth > width) ? totalWidth - width : 0;
+    int32_t maxY = (totalHeight > height) ? totalHeight - height : 0;
+
+    x = (x < 0) ? 0 : ((x > maxX) ? maxX : x);
+    y = (y < 0) ? 0 : ((y > maxY) ? maxY : y);
+
+    velocityX = x - (int32_t) positionX;
+    velocityY = y - (int32_t) positionY;
+
+    positionX = x;
+    positionY = y;
+    outstandingX = 0;
+    outstandingY = 0;
+}
+
+/*  Rows and columns intersecting the view, as [first, end).
+*/
+void UIGridView::findVisible(uint32_t* firstRow, uint32_t* endRow, uint32_t* firstColumn, uint32_t* endColumn)
+{
+    *firstRow = 0;
+    *endRow = 0;
+    *firstColumn = 0;
+    *endColumn = 0;
+
+    if ((rowIndex.getSize() == 0) || (columnIndex.getSize() == 0) || (width == 0) || (height == 0))
+    {
+        return;
+    }
+
+    *firstRow = rowIndex.findRow(positionY, NULL);
+    *endRow = rowIndex.findRow(positionY + height - 1, NULL) + 1;
+    *firstColumn = columnIndex.findRow(positionX, NULL);
+    *endColumn = columnIndex.findRow(positionX + width - 1, NULL) + 1;
+}
+
+/*  Suspend the cached cells that left the view and resume the ones that
+    came back. Cells fetched for the view are resumed in getCell.
+*/
+void UIGridView::updateVisibleRange(uint32_t firstRow, uint32_t endRow, uint32_t firstColumn, uint32_t endColumn)
+{
+    uint32_t perRow = columnIndex.getSize();
+
+    for (uint32_t row = visibleFirstRow; row < visibleEndRow; row++)
+    {
+        for (uint32_t column = visibleFirstColumn; column < visibleEndColumn; column++)
+        {
+            if ((row < firstRow) || (row >= endRow) || (column < firstColumn) || (column >= endColumn))
+            {
+                SharedPointer<UIView>& cell = cellCache.peek(row * perRow + column);
+
+                if (cell != NULL)
+                {
+                    cell->suspend();
+                }
+            }
+        }
+    }
+
+    for (uint32_t row = firstRow; row < endRow; row++)
+    {
+        for (uint32_t column = firstColumn; column < endColumn; column++)
+        {
+            if ((row < visibleFirstRow) || (row >= visibleEndRow)
+                || (column < visibleFirstColumn) || (column >= visibleEndColumn))
+            {
+                SharedPointer<UIView>& cell = cellCache.peek(row * perRow + column);
+
+                if (cell != NULL)
+                {
+                    cell->resume();
+                }
+            }
+        }
+    }
+
+    visibleFirstRow = firstRow;
+    visibleEndRow = endRow;
+    visibleFirstColumn = firstColumn;
+    visibleEndColumn = endColumn;
+}
+
+/*  Get the cell from the cache if it exists and is still valid. Otherwise
+    get it from the array, which may reuse a cell from the pool.
+*/
+SharedPointer<UIView> UIGridView::getCell(uint32_t index)
+{
+    SharedPointer<UIView> cell = cellCache.lookup(index);
+
+    if ((cell != NULL) && cell->isValid())
+    {
+        return cell;
+    }
+
+    UIF_PRINTF("UIGridView: miss: %lu\r\n", index);
+
+    cell = array->viewAtIndex(index, cellPool);
+
+    // propagate wakeup callback
+    cell->setWakeupCallback(wakeupCallback);
+
+    // propagate color inversion
+    cell->setInverse(inverse);
+
+    // reused cells may have been suspended when they left the view
+    cell->resume();
+
+    if (cell->isCacheable())
+    {
+        cellCache.insert(index, cell);
+    }
+
+    return cell;
+}
+
+void UIGridView::fetchCell(uint32_t index)
+{
+    UIF_PRINTF("UIGridView: prefetch: %lu\r\n", index);
+
+    SharedPointer<UIView> cell = array->viewAtIndex(index, cellPool);
+
+    cell->setWakeupCallback(wakeupCallback);
+    cell->setInverse(inverse);
+
+    /* prefetched cells are outside the view, they are resumed when they scroll in */
+    cell->suspend();
+    cell->prefetch(0, 0);
+
+    if (cell->isCacheable())
+    {
+        cellCache.insert(index, cell, true);
+    }
+}
+
+/*  Queue the row or column about to scroll into view, in the direction of
+    the last frame's movement.
+*/
+void UIGridView::updatePrefetchWindow()
+{
+    uint32_t size = array->getSize();
+    uint32_t perRow = columnIndex.getSize();
+    uint32_t rows = rowIndex.getSize();
+
+    prefetchQueue.clear();
+
+    if ((velocityY != 0) && (visibleEndColumn > visibleFirstColumn))
+    {
+        bool down = (velocityY > 0);
+
+        if ((down && (visibleEndRow < rows)) || (!down && (visibleFirstRow > 0)))
+        {
+            uint32_t row = (down) ? visibleEndRow : visibleFirstRow - 1;
+
+            for (uint32_t column = visibleFirstColumn; column < visibleEndColumn; column++)
+            {
+                uint32_t index = row * perRow + column;
+
+                if ((index < size) && (cellCache.peek(index) == NULL))
+                {
+                    prefetchQueue.push(index);
+                }
+            }
+        }
+    }
+
+    if ((velocityX != 0) && (visibleEndRow > visibleFirstRow))
+    {
+        bool right = (velocityX > 0);
+
+        if ((right && (visibleEndColumn < perRow)) || (!right && (visibleFirstColumn > 0)))
+        {
+            uint32_t column = (right) ? visibleEndColumn : visibleFirstColumn - 1;
+
+            for (uint32_t row = visibleFirstRow; row < visibleEndRow; row++)
+            {
+                uint32_t index = row * perRow + column;
+
+                if ((index < size) && (cellCache.peek(index) == NULL))
+                {
+                    prefetchQueue.push(index);
+                }
+            }
+        }
+    }
+
+    /* one task works through the queue, however many frames add to it */
+    if ((prefetchCallbackHandle == NULL) && (prefetchQueue.getDepth() > 0))
+    {
+        prefetchCallbackHandle = minar::Scheduler::postCallback(this, &UIGridView::runPrefetchQueue)
+                                    .getHandle();
+    }
+}
+
+/*  Fetch queued cells within the time budget of one slot, then leave the
+    rest for the next slot.
+*/
+void UIGridView::runPrefetchQueue()
+{
+    prefetchCallbackHandle = NULL;
+
+    uint32_t start = UIClock::getTime();
+    uint32_t index;
+
+    while (prefetchQueue.pop(index))
+    {
+        SharedPointer<UIView>& cached = cellCache.peek(index);
+
+        if ((cached != NULL) && cached->isValid())
+        {
+            continue;
+        }
+
+        fetchCell(index);
+
+        if (UIClock::elapsed(start) >= DEFAULT_GRID_PREFETCH_TIME_MS * 1000)
+        {
+            break;
+        }
+    }
+
+    if (prefetchQueue.getDepth() > 0)
+    {
+        prefetchCallbackHandle = minar::Scheduler::postCallback(this, &UIGridView::runPrefetchQueue)
+                                    .getHandle();
+    }
+}
+
+/*  UIView */
+uint32_t UIGridView::fillFrameBuffer(SharedPointer<FrameBuffer>& canvas, int16_t xOffset, int16_t yOffset)
+{
+    /* nothing to prefetch beyond the cells in the cache */
+    if (canvas.get() == NULL)
+    {
+        return UINT32_MAX;
+    }
+
+    if (width == 0)
+    {
+        width = canvas->getWidth();
+    }
+
+    if (height == 0)
+    {
+        height = canvas->getHeight();
+    }
+
+    updateIndex();
+    applyScroll();
+
+    uint32_t firstRow;
+    uint32_t endRow;
+    uint32_t firstColumn;
+    uint32_t endColumn;
+
+    findVisible(&firstRow, &endRow, &firstColumn, &endColumn);
+    updateVisibleRange(firstRow, endRow, firstColumn, endColumn);
+
+    /* background, clipped to the canvas */
+    int32_t canvasWidth = canvas->getWidth();
+    int32_t canvasHeight = canvas->getHeight();
+    int32_t left = (xOffset > 0) ? xOffset : 0;
+    int32_t top = (yOffset > 0) ? yOffset : 0;
+    int32_t right = (xOffset + width < canvasWidth) ? xOffset + width : canvasWidth;
+    int32_t bottom = (yOffset + height < canvasHeight) ? yOffset + height : canvasHeight;
+
+    if ((right > left) && (bottom > top))
+    {
+        canvas->drawRectangle(left, right, top, bottom, (inverse) ? 0 : 1);
+    }
+
+    uint32_t size = array->getSize();
+    uint32_t perRow = columnIndex.getSize();
+    uint32_t callInterval = UINT32_MAX;
+
+    for (uint32_t row = firstRow; row < endRow; row++)
+    {
+        int32_t cellTop = rowIndex.getPosition(row) - positionY + yOffset;
+        int32_t cellHeight = rowIndex.getHeight(row);
+
+        if ((cellTop >= canvasHeight) || (cellTop + cellHeight <= 0))
+        {
+            continue;
+        }
+
+        for (uint32_t column = firstColumn; column < endColumn; column++)
+        {
+            uint32_t index = row * perRow + column;
+
+            if (index >= size)
+            {
+                break;
+            }
+
+            int32_t cellLeft = columnIndex.getPosition(column) - positionX + xOffset;
+            int32_t cellWidth = columnIndex.getHeight(column);
+
+            if ((cellLeft >= canvasWidth) || (cellLeft + cellWidth <= 0))
+            {
+                continue;
+            }
+
+            SharedPointer<UIView> cell = getCell(index);
+
+            /* cells moved by changes to the array land in other columns */
+            cell->setWidth(cellWidth);
+            cell->setHeight(cellHeight);
+
+            /*  The window is cut off at the canvas edges, cells starting
+                above or left of it draw the part that is left through
+                negative offsets.
+            */
+            cellWindow->setWindow(canvas.get(), cellLeft, cellTop, cellWidth, cellHeight);
+
+            uint32_t interval = cell->fillFrameBuffer(cellCanvas,
+                                                      (cellLeft < 0) ? cellLeft : 0,
+                                                      (cellTop < 0) ? cellTop : 0);
+
+            callInterval = (interval < callInterval) ? interval : callInterval;
+
+            renderedCells++;
+        }
+    }
+
+    cellWindow->clearWindow();
+
+    updatePrefetchWindow();
+
+    /* cells in view span this range of indices, spare them */
+    if (endRow > firstRow)
+    {
+        cellCache.trim(firstRow * perRow + firstColumn, (endRow - 1) * perRow + endColumn);
+    }
+
+    return callInterval;
+}
+
+void UIGridView::setWakeupCallback(FunctionPointer& callback)
+{
+    wakeupCallback = callback;
+
+    for (uint32_t slot = 0; slot < cellCache.getSize(); slot++)
+    {
+        SharedPointer<UIView>& cell = cellCache.getSlot(slot);
+
+        if (cell != NULL)
+        {
+            cell->setWakeupCallback(wakeupCallback);
+        }
+    }
+}
+
+/*  The grid has changed if it scrolled or if one of the visible cells has
+    changed, been invalidated or is not in the cache yet.
+*/
+bool UIGridView::isDirty()
+{
+    if (UIView::isDirty() || (outstandingX != 0) || (outstandingY != 0))
+    {
+        return true;
+    }
+
+    updateIndex();
+
+    uint32_t size = array->getSize();
+    uint32_t perRow = columnIndex.getSize();
+
+    for (uint32_t row = visibleFirstRow; row < visibleEndRow; row++)
+    {
+        for (uint32_t column = visibleFirstColumn; column < visibleEndColumn; column++)
+        {
+            uint32_t index = row * perRow + column;
+
+            if (index >= size)
+            {
+                break;
+            }
+
+            SharedPointer<UIView>& cell = cellCache.peek(index);
+
+            if ((cell == NULL) || !cell->isValid() || cell->isDirty())
+            {
+                return true;
+            }
+        }
+    }
+
+    return false;
+}
+
+void UIGridView::clearDirty()
+{
+    UIView::clearDirty();
+
+    for (uint32_t slot = 0; slot < cellCache.getSize(); slot++)
+    {
+        SharedPointer<UIView>& cell = cellCache.getSlot(slot);
+
+        if (cell != NULL)
+        {
+            cell->clearDirty();
+        }
+    }
+}
+
+/*  Put all cached cells to sleep and stop prefetching while the grid is
+    out of view. The next frame resumes the cells it shows.
+*/
+void UIGridView::suspend()
+{
+    if (prefetchCallbackHandle)
+    {
+        minar::Scheduler::cancelCallback(prefetchCallbackHandle);
+        prefetchCallbackHandle = NULL;
+    }
+
+    prefetchQueue.clear();
+
+    for (uint32_t slot = 0; slot < cellCache.getSize(); slot++)
+    {
+        SharedPointer<UIView>& cell = cellCache.getSlot(slot);
+
+        if (cell != NULL)
+        {
+            cell->suspend();
+        }
+    }
+
+    visibleFirstRow = 0;
+    visibleEndRow = 0;
+    visibleFirstColumn = 0;
+    visibleEndColumn = 0;
+
+    cellCache.refresh();
+    cellCache.trim(0, 0);
+}
+
+uint32_t UIGridView::getRetainedBytes() const
+{
+    return sizeof(UIGridView) + cellCache.getRetainedBytes();
+}
+
+void UIGridView::setCacheBudget(SharedPointer<UICacheBudget>& budget)
+{
+    cellCache.setBudget(budget);
+}
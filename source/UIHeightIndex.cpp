@@ -0,0 +1,411 @@
+/* mbed
+ * Copyright (c) 2006-2015 ARM Limited
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#include "UIFramework/UIHeightIndex.h"
+
+
+UIHeightIndex::UIHeightIndex()
+    :   tree(NULL),
+        size(0),
+        capacity(0),
+        topBit(0),
+        uniformHeight(0)
+{}
+
+UIHeightIndex::~UIHeightIndex()
+{
+    delete[] tree;
+}
+
+/*  Free the tree, positions are computed from the uniform height.
+*/
+void UIHeightIndex::release()
+{
+    delete[] tree;
+
+    tree = NULL;
+    capacity = 0;
+}
+
+/*  Make room for the tree and find the highest power of two in it.
+*/
+void UIHeightIndex::allocate()
+{
+    /* keep the tree when the table shrinks */
+    if (size + 1 > capacity)
+    {
+        delete[] tree;
+
+        capacity = size + 1;
+        tree = new uint32_t[capacity];
+    }
+
+    tree[0] = 0;
+
+    findTopBit();
+}
+
+/*  Make room for rows to be added to the tree, keeping its contents.
+*/
+void UIHeightIndex::reserve(uint32_t rows)
+{
+    if (rows + 1 > capacity)
+    {
+        /* grow in steps so repeated inserts do not copy every time */
+        uint32_t grown = capacity + (capacity / 2);
+
+        capacity = (rows + 1 > grown) ? rows + 1 : grown;
+
+        uint32_t* larger = new uint32_t[capacity];
+
+        larger[0] = 0;
+
+        for (uint32_t idx = 1; (tree != NULL) && (idx <= size); idx++)
+        {
+            larger[idx] = tree[idx];
+        }
+
+        delete[] tree;
+        tree = larger;
+    }
+}
+
+void UIHeightIndex::findTopBit()
+{
+    topBit = 1;
+
+    while ((topBit << 1) <= size)
+    {
+        topBit <<= 1;
+    }
+}
+
+/*  Switch from the uniform height to the tree.
+*/
+void UIHeightIndex::expand()
+{
+    allocate();
+
+    for (uint32_t idx = 1; idx <= size; idx++)
+    {
+        tree[idx] = uniformHeight * (idx & (0 - idx));
+    }
+
+    uniformHeight = 0;
+}
+
+/*  Push each partial sum to the node covering it, O(n) in total. Before,
+    node i holds the height of row i - 1 only.
+*/
+void UIHeightIndex::fold()
+{
+    for (uint32_t idx = 1; idx <= size; idx++)
+    {
+        uint32_t parent = idx + (idx & (0 - idx));
+
+        if (parent <= size)
+        {
+            tree[parent] += tree[idx];
+        }
+    }
+}
+
+/*  Undo fold, leaving the height of row i - 1 in node i.
+*/
+void UIHeightIndex::unfold()
+{
+    for (uint32_t idx = size; idx > 0; idx--)
+    {
+        uint32_t parent = idx + (idx & (0 - idx));
+
+        if (parent <= size)
+        {
+            tree[parent] -= tree[idx];
+        }
+    }
+}
+
+void UIHeightIndex::build(const UIView::Array& array)
+{
+    size = array.getSize();
+    uniformHeight = array.getUniformHeight();
+
+    if (uniformHeight > 0)
+    {
+        release();
+
+        return;
+    }
+
+    allocate();
+
+    /* node i covers only row i - 1 until the sums are pushed up */
+    if (size > 0)
+    {
+        array.heightsInRange(0, size, &tree[1]);
+    }
+
+    /* the array did not say so, but the rows may still share a height */
+    uint32_t height = (size > 0) ? tree[1] : 0;
+
+    for (uint32_t idx = 2; (idx <= size) && (height > 0); idx++)
+    {
+        if (tree[idx] != height)
+        {
+            height = 0;
+        }
+    }
+
+    if (height > 0)
+    {
+        release();
+
+        uniformHeight = height;
+
+        return;
+    }
+
+    fold();
+}
+
+/*  Rows added at the end are appended in O(log n) each. Rows added
+    anywhere else move the rows after them, which is O(n) but reads only
+    the new heights from the array.
+*/
+void UIHeightIndex::insert(uint32_t first, uint32_t count, const UIView::Array& array)
+{
+    if ((first > size) || (count == 0))
+    {
+        return;
+    }
+
+    if (uniformHeight > 0)
+    {
+        bool uniform = true;
+
+        for (uint32_t row = first; (row < first + count) && uniform; row++)
+        {
+            uniform = (array.heightAtIndex(row) == uniformHeight);
+        }
+
+        if (uniform)
+        {
+            size += count;
+            return;
+        }
+
+        expand();
+    }
+
+    reserve(size + count);
+
+    if (first == size)
+    {
+        for (uint32_t row = first; row < first + count; row++)
+        {
+            /* node covers the rows [row + 1 - lowest bit, row] */
+            uint32_t node = row + 1;
+            uint32_t start = node - (node & (0 - node));
+
+            tree[node] = getPosition(row) - getPosition(start) + array.heightAtIndex(row);
+            size++;
+        }
+    }
+    else
+    {
+        unfold();
+
+        for (uint32_t idx = size; idx > first; idx--)
+        {
+            tree[idx + count] = tree[idx];
+        }
+
+        array.heightsInRange(first, first + count, &tree[first + 1]);
+
+        size += count;
+
+        fold();
+    }
+
+    findTopBit();
+}
+
+/*  Rows removed from the end only shrink the tree, as no node below the
+    new size covers them. Otherwise the rows after them are moved up.
+*/
+void UIHeightIndex::remove(uint32_t first, uint32_t count)
+{
+    if (first >= size)
+    {
+        return;
+    }
+
+    if (count > size - first)
+    {
+        count = size - first;
+    }
+
+    if ((uniformHeight == 0) && (first + count < size))
+    {
+        unfold();
+
+        for (uint32_t idx = first + 1; idx + count <= size; idx++)
+        {
+            tree[idx] = tree[idx + count];
+        }
+
+        size -= count;
+
+        fold();
+    }
+    else
+    {
+        size -= count;
+    }
+
+    if (uniformHeight == 0)
+    {
+        findTopBit();
+    }
+}
+
+uint32_t UIHeightIndex::getSize() const
+{
+    return size;
+}
+
+void UIHeightIndex::setHeight(uint32_t index, uint32_t height)
+{
+    if ((uniformHeight > 0) && (index < size) && (height != uniformHeight))
+    {
+        /* rows no longer share a height, switch to the tree */
+        expand();
+    }
+
+    if ((uniformHeight == 0) && (index < size))
+    {
+        uint32_t delta = height - getHeight(index);
+
+        /* unsigned wrap-around adds negative deltas correctly */
+        for (uint32_t idx = index + 1; idx <= size; idx += idx & (0 - idx))
+        {
+            tree[idx] += delta;
+        }
+    }
+}
+
+uint32_t UIHeightIndex::getHeight(uint32_t index) const
+{
+    if (index < size)
+    {
+        return getPosition(index + 1) - getPosition(index);
+    }
+
+    return 0;
+}
+
+uint32_t UIHeightIndex::getPosition(uint32_t index) const
+{
+    if (index > size)
+    {
+        index = size;
+    }
+
+    if (uniformHeight > 0)
+    {
+        return index * uniformHeight;
+    }
+
+    uint32_t sum = 0;
+
+    for (uint32_t idx = index; idx > 0; idx -= idx & (0 - idx))
+    {
+        sum += tree[idx];
+    }
+
+    return sum;
+}
+
+uint32_t UIHeightIndex::getUniformHeight() const
+{
+    return uniformHeight;
+}
+
+uint32_t UIHeightIndex::getTotalHeight() const
+{
+    return getPosition(size);
+}
+
+/*  Descend the tree from the largest power of two, keeping the longest run
+    of rows whose heights add up to no more than the position.
+*/
+uint32_t UIHeightIndex::findRow(uint32_t position, uint32_t* offset) const
+{
+    if (size == 0)
+    {
+        if (offset)
+        {
+            *offset = position;
+        }
+
+        return 0;
+    }
+
+    if (uniformHeight > 0)
+    {
+        uint32_t row = position / uniformHeight;
+
+        if (row >= size)
+        {
+            row = size - 1;
+        }
+
+        if (offset)
+        {
+            *offset = position - row * uniformHeight;
+        }
+
+        return row;
+    }
+
+    uint32_t rows = 0;
+    uint32_t remainder = position;
+
+    for (uint32_t step = topBit; step > 0; step >>= 1)
+    {
+        uint32_t next = rows + step;
+
+        if ((next <= size) && (tree[next] <= remainder))
+        {
+            rows = next;
+            remainder -= tree[next];
+        }
+    }
+
+    /* past the end, stay on the last row */
+    if (rows == size)
+    {
+        rows = size - 1;
+        remainder = position - getPosition(rows);
+    }
+
+    if (offset)
+    {
+        *offset = remainder;
+    }
+
+    return rows;
+}
@@ -18,9 +18,17 @@
 
 
 UIImageView::UIImageView(const struct CompBuf* _image)
-    :   UIView(),
-        image(_image)
+    :   UIView()
 {
+    setImage(_image);
+}
+
+void UIImageView::setImage(const struct CompBuf* _image)
+{
+    image = _image;
+
+    UIView::markDirty();
+
     if (image)
     {
         contentWidth = image->width_bits;
@@ -103,5 +111,27 @@ uint32_t UIImageView::fillFrameBuffer(SharedPointer<FrameBuffer>& canvas, int16_
         }
     }
 
-    return ULONG_MAX;
+    return UINT32_MAX;
+}
+
+/*  The image itself is owned by the caller.
+*/
+uint32_t UIImageView::getRetainedBytes() const
+{
+    return sizeof(UIImageView);
+}
+
+/*  Images without a mask that fill the view cover every pixel.
+*/
+bool UIImageView::isOpaque() const
+{
+    if (UIView::isOpaque())
+    {
+        return true;
+    }
+
+    return (image != NULL)
+        && (image->mask == (uint8_t*) Comp_Fill_Ones)
+        && (UIView::width > 0) && (contentWidth >= UIView::width)
+        && (UIView::height > 0) && (contentHeight >= UIView::height);
 }
@@ -0,0 +1,180 @@
+/* mbed
+ * Copyright (c) 2006-2015 ARM Limited
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#include "UIFramework/UIKineticPhysics.h"
+
+
+#define STEPS_PER_FRAME (KINETIC_FRAME_US / KINETIC_STEP_US)
+
+/*  Whole pixels in a Q16 value, rounded towards minus infinity so the
+    fraction is always positive.
+*/
+static int32_t floorPixels(int32_t value)
+{
+    return (value >= 0) ? (value >> 16) : -((-value + 0xFFFF) >> 16);
+}
+
+static int32_t decay(int32_t value)
+{
+    return (int32_t) (((int64_t) value * KINETIC_DECAY_Q16) / 65536);
+}
+
+UIKineticPhysics::UIKineticPhysics()
+    :   velocity(0),
+        remaining(0),
+        residue(0),
+        pendingUs(0),
+        spareUs(0),
+        first(0),
+        last(0),
+        friction(5)
+{}
+
+void UIKineticPhysics::setBounds(int32_t _first, int32_t _last)
+{
+    first = _first;
+    last = _last;
+}
+
+void UIKineticPhysics::setFriction(uint32_t _friction)
+{
+    friction = _friction;
+}
+
+void UIKineticPhysics::fling(int32_t speed)
+{
+    /* pixels per frame to Q16 pixels per step */
+    velocity = (speed * 65536) / STEPS_PER_FRAME;
+    remaining = 0;
+    residue = 0;
+    pendingUs = 0;
+    spareUs = 0;
+}
+
+void UIKineticPhysics::snap(int32_t distance)
+{
+    velocity = 0;
+    remaining = distance * 65536;
+}
+
+void UIKineticPhysics::stop()
+{
+    velocity = 0;
+    remaining = 0;
+    residue = 0;
+    pendingUs = 0;
+    spareUs = 0;
+}
+
+bool UIKineticPhysics::isMoving() const
+{
+    return (velocity != 0) || (remaining != 0);
+}
+
+int32_t UIKineticPhysics::advance(uint32_t elapsed, int32_t offset)
+{
+    if (!isMoving())
+    {
+        pendingUs = 0;
+        spareUs = 0;
+
+        return 0;
+    }
+
+    uint32_t time = pendingUs + spareUs + elapsed;
+
+    if (time > KINETIC_MAX_ELAPSED_US)
+    {
+        time = KINETIC_MAX_ELAPSED_US;
+    }
+
+    uint32_t steps = time / KINETIC_STEP_US;
+
+    pendingUs = time % KINETIC_STEP_US;
+    spareUs = 0;
+
+    /* Q16 pixels from the whole pixel offset */
+    int32_t moved = residue;
+    int32_t deceleration = (friction * 65536) / (STEPS_PER_FRAME * STEPS_PER_FRAME);
+
+    for (uint32_t step = 0; step < steps; step++)
+    {
+        if (velocity != 0)
+        {
+            int32_t position = offset + floorPixels(moved);
+
+            /* rubber band */
+            if ((position < last) || (position > first))
+            {
+                velocity = decay(velocity);
+            }
+
+            moved += velocity;
+
+            if (velocity > deceleration)
+            {
+                velocity -= deceleration;
+            }
+            else if (velocity < -deceleration)
+            {
+                velocity += deceleration;
+            }
+            else
+            {
+                velocity = 0;
+            }
+        }
+        else if (remaining != 0)
+        {
+            int32_t distance = remaining - decay(remaining);
+
+            /* less than a pixel to go */
+            if ((remaining < 65536) && (remaining > -65536))
+            {
+                distance = remaining;
+            }
+
+            moved += distance;
+            remaining -= distance;
+        }
+        else
+        {
+            /* came to rest, keep the rest of the time for a snap */
+            spareUs = (steps - step) * KINETIC_STEP_US + pendingUs;
+            pendingUs = 0;
+            break;
+        }
+    }
+
+    int32_t pixels = floorPixels(moved);
+
+    residue = moved - pixels * 65536;
+
+    /* start the next motion on a whole pixel, with the time after this one */
+    if (!isMoving())
+    {
+        residue = 0;
+        spareUs += pendingUs;
+        pendingUs = 0;
+    }
+
+    return pixels;
+}
+
+int32_t UIKineticPhysics::getSpeed() const
+{
+    return (int32_t) (((int64_t) velocity * STEPS_PER_FRAME) / 65536);
+}
@@ -0,0 +1,272 @@
+/* mbed
+ * Copyright (c) 2006-2015 ARM Limited
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#include "UIFramework/UILayerView.h"
+
+
+#if 0
+#include <stdio.h>
+#define UIF_PRINTF(...) { printf(__VA_ARGS__); }
+#else
+#define UIF_PRINTF(...)
+#endif
+
+UILayerView::UILayerView(SharedPointer<UIView>& _view)
+    :   UIView(),
+        view(_view),
+        layer(),
+        layerBuffer(NULL),
+        mask(NULL),
+        callInterval(UINT32_MAX),
+        renderCount(0)
+{
+    MBED_ASSERT(view);
+
+    /* take over the properties of the view */
+    align = view->getHorizontalAlignment();
+    valign = view->getVerticalAlignment();
+    width = view->getWidth();
+    height = view->getHeight();
+    inverse = view->getInverse();
+    cacheable = view->isCacheable();
+}
+
+UILayerView::~UILayerView()
+{
+    release();
+}
+
+SharedPointer<UIView>& UILayerView::getView()
+{
+    return view;
+}
+
+bool UILayerView::isRetained() const
+{
+    return (layerBuffer != NULL);
+}
+
+uint32_t UILayerView::getRenderCount() const
+{
+    return renderCount;
+}
+
+/*  Pass properties set on the layer on to the view. The setters only mark
+    the view as changed if a value is different.
+*/
+void UILayerView::updateView()
+{
+    view->setHorizontalAlignment(align);
+    view->setVerticalAlignment(valign);
+    view->setWidth(width);
+    view->setHeight(height);
+    view->setInverse(inverse);
+}
+
+/*  Render the view onto a white and a black background. Pixels that are the
+    same in both were drawn by the view, the rest are transparent.
+*/
+void UILayerView::capture()
+{
+    UIF_PRINTF("UILayerView: capture: %u %u\r\n", width, height);
+
+    layerBuffer = new UIMemoryFrameBuffer(width, height);
+    layer = SharedPointer<FrameBuffer>(layerBuffer);
+
+    UIMemoryFrameBuffer* background = new UIMemoryFrameBuffer(width, height);
+    SharedPointer<FrameBuffer> backgroundCanvas(background);
+
+    layerBuffer->fill(1);
+    background->fill(0);
+
+    view->fillFrameBuffer(layer, 0, 0);
+    callInterval = view->fillFrameBuffer(backgroundCanvas, 0, 0);
+    renderCount += 2;
+
+    uint16_t stride = layerBuffer->getStride();
+    uint32_t size = stride * height;
+
+    const uint8_t* white = layerBuffer->getData();
+    const uint8_t* black = background->getData();
+
+    /* padding bits at the end of each row are ignored */
+    uint8_t lastByte = (width % 8) ? ((1 << (width % 8)) - 1) : 0xFF;
+    bool opaque = true;
+
+    mask = new uint8_t[size];
+
+    for (uint32_t idx = 0; idx < size; idx++)
+    {
+        uint8_t drawn = ~(white[idx] ^ black[idx]);
+        uint8_t used = ((idx % stride) == (uint32_t)(stride - 1)) ? lastByte : 0xFF;
+
+        mask[idx] = drawn;
+
+        if ((drawn & used) != used)
+        {
+            opaque = false;
+        }
+    }
+
+    if (opaque)
+    {
+        delete[] mask;
+        mask = NULL;
+    }
+
+    image.buf = layerBuffer->getData();
+    image.mask = (mask) ? mask : (uint8_t*) Comp_Fill_Ones;
+    image.bit_offset = 0;
+    image.stride_bytes = stride;
+    image.width_bits = width;
+    image.height_strides = height;
+}
+
+void UILayerView::release()
+{
+    layer = SharedPointer<FrameBuffer>();
+    layerBuffer = NULL;
+
+    delete[] mask;
+    mask = NULL;
+}
+
+/*  UIView */
+uint32_t UILayerView::fillFrameBuffer(SharedPointer<FrameBuffer>& canvas, int16_t xOffset, int16_t yOffset)
+{
+    /* use canvas dimensions if none has been pre-set */
+    if (width == 0)
+    {
+        width = canvas->getWidth();
+    }
+
+    if (height == 0)
+    {
+        height = canvas->getHeight();
+    }
+
+    updateView();
+
+    /*  The retained bitmap is stale while the view is changing, including
+        after invalidate(). Render it directly instead of capturing a bitmap
+        that is only used once.
+    */
+    if (!view->isCacheable() || view->isDirty())
+    {
+        release();
+
+        renderCount++;
+        callInterval = view->fillFrameBuffer(canvas, xOffset, yOffset);
+
+        return callInterval;
+    }
+
+    if (layerBuffer == NULL)
+    {
+        capture();
+    }
+
+    canvas->drawImage(image, xOffset, yOffset, 0);
+
+    return callInterval;
+}
+
+void UILayerView::prefetch(int16_t xOffset, int16_t yOffset)
+{
+    if (layerBuffer == NULL)
+    {
+        view->prefetch(xOffset, yOffset);
+    }
+}
+
+void UILayerView::setWakeupCallback(FunctionPointer& wakeup)
+{
+    wakeupCallback = wakeup;
+
+    view->setWakeupCallback(wakeup);
+}
+
+/*  The retained bitmap, its mask and the view underneath.
+*/
+uint32_t UILayerView::getRetainedBytes() const
+{
+    uint32_t bytes = sizeof(UILayerView) + view->getRetainedBytes();
+
+    if (layerBuffer != NULL)
+    {
+        uint32_t size = layerBuffer->getStride() * layerBuffer->getHeight();
+
+        bytes += (mask != NULL) ? 2 * size : size;
+    }
+
+    return bytes;
+}
+
+void UILayerView::setCacheBudget(SharedPointer<UICacheBudget>& budget)
+{
+    view->setCacheBudget(budget);
+}
+
+void UILayerView::suspend()
+{
+    release();
+
+    view->suspend();
+}
+
+void UILayerView::resume()
+{
+    view->resume();
+}
+
+SharedPointer<UIView::Action> UILayerView::getAction()
+{
+    return view->getAction();
+}
+
+/*  A retained bitmap without mask covers every pixel.
+*/
+bool UILayerView::isOpaque() const
+{
+    return UIView::isOpaque() || view->isOpaque() || ((layerBuffer != NULL) && (mask == NULL));
+}
+
+bool UILayerView::isDirty()
+{
+    return UIView::isDirty() || view->isDirty();
+}
+
+UIView::Rect UILayerView::getDirtyRect()
+{
+    if (UIView::dirty)
+    {
+        return getBounds();
+    }
+
+    UIView::Rect region = dirtyRect;
+
+    region.unite(view->getDirtyRect());
+    region.intersect(getBounds());
+
+    return region;
+}
+
+void UILayerView::clearDirty()
+{
+    UIView::clearDirty();
+
+    view->clearDirty();
+}
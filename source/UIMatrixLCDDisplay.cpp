@@ -0,0 +1,45 @@
+/* mbed
+ * Copyright (c) 2006-2015 ARM Limited
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#include "UIFramework/UIMatrixLCDDisplay.h"
+
+#if !UIF_HOST
+
+
+UIMatrixLCDDisplay::UIMatrixLCDDisplay(uif::MatrixLCD& _screen)
+    :   UIDisplay(),
+        screen(_screen)
+{
+}
+
+SharedPointer<FrameBuffer> UIMatrixLCDDisplay::getFrameBuffer()
+{
+    return screen.getFrameBuffer();
+}
+
+uint32_t UIMatrixLCDDisplay::getBufferCount() const
+{
+    return 2;
+}
+
+void UIMatrixLCDDisplay::sendFrameBuffer(SharedPointer<FrameBuffer>& buffer,
+                                         FunctionPointer onStart,
+                                         FunctionPointer onFinish)
+{
+    screen.sendFrameBuffer(buffer, onStart, onFinish);
+}
+
+#endif // !UIF_HOST
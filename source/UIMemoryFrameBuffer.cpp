@@ -0,0 +1,421 @@
+/* mbed
+ * Copyright (c) 2006-2015 ARM Limited
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#include "UIFramework/UIMemoryFrameBuffer.h"
+
+#include <cstring>
+
+
+UIMemoryFrameBuffer::UIMemoryFrameBuffer(uint16_t _width, uint16_t _height)
+    :   FrameBuffer(),
+        data(NULL),
+        ownsData(true),
+        stride((_width + 7) / 8),
+        clipX0(0),
+        clipX1(_width),
+        clipY0(0),
+        clipY1(_height),
+        xOrigin(0),
+        yOrigin(0),
+        width(_width),
+        height(_height)
+{
+#if UIF_HOST
+    root = this;
+    written = NULL;
+    pixelWrites = 0;
+    overdraw = 0;
+#endif
+
+    data = new uint8_t[stride * height];
+
+    fill(1);
+}
+
+UIMemoryFrameBuffer::UIMemoryFrameBuffer(const UIMemoryFrameBuffer& parent,
+                                         int32_t _xOrigin,
+                                         int32_t _yOrigin,
+                                         uint16_t _width,
+                                         uint16_t _height)
+    :   FrameBuffer(),
+        data(parent.data),
+        ownsData(false),
+        stride(parent.stride),
+        xOrigin(_xOrigin),
+        yOrigin(_yOrigin),
+        width(_width),
+        height(_height)
+{
+#if UIF_HOST
+    root = parent.root;
+    written = NULL;
+    pixelWrites = 0;
+    overdraw = 0;
+#endif
+
+    /* visible area is the intersection with the parent's visible area */
+    clipX0 = (xOrigin > parent.clipX0) ? xOrigin : parent.clipX0;
+    clipY0 = (yOrigin > parent.clipY0) ? yOrigin : parent.clipY0;
+    clipX1 = (xOrigin + width < parent.clipX1) ? xOrigin + width : parent.clipX1;
+    clipY1 = (yOrigin + height < parent.clipY1) ? yOrigin + height : parent.clipY1;
+}
+
+UIMemoryFrameBuffer::~UIMemoryFrameBuffer()
+{
+    if (ownsData)
+    {
+        delete[] data;
+    }
+
+#if UIF_HOST
+    delete[] written;
+#endif
+}
+
+/*  Clip rectangle, given in local coordinates, against the visible area.
+    Returns the result in root coordinates.
+*/
+bool UIMemoryFrameBuffer::clip(int32_t& x0, int32_t& x1, int32_t& y0, int32_t& y1) const
+{
+    x0 += xOrigin;
+    x1 += xOrigin;
+    y0 += yOrigin;
+    y1 += yOrigin;
+
+    if (x0 < clipX0)
+    {
+        x0 = clipX0;
+    }
+
+    if (y0 < clipY0)
+    {
+        y0 = clipY0;
+    }
+
+    if (x1 > clipX1)
+    {
+        x1 = clipX1;
+    }
+
+    if (y1 > clipY1)
+    {
+        y1 = clipY1;
+    }
+
+    return (x0 < x1) && (y0 < y1);
+}
+
+/*  Fill [xStart, xEnd) on the given root row. Whole bytes are set at once.
+*/
+void UIMemoryFrameBuffer::fillSpan(int32_t row, int32_t xStart, int32_t xEnd, uint8_t color)
+{
+    track(row, xStart, xEnd);
+
+    uint8_t* line = &data[row * stride];
+
+    int32_t x = xStart;
+
+    for (; (x < xEnd) && (x & 0x07); x++)
+    {
+        if (color)
+        {
+            line[x / 8] |= (1 << (x % 8));
+        }
+        else
+        {
+            line[x / 8] &= ~(1 << (x % 8));
+        }
+    }
+
+    if ((xEnd - x) >= 8)
+    {
+        uint32_t bytes = (xEnd - x) / 8;
+
+        memset(&line[x / 8], (color) ? 0xFF : 0x00, bytes);
+
+        x += bytes * 8;
+    }
+
+    for (; x < xEnd; x++)
+    {
+        if (color)
+        {
+            line[x / 8] |= (1 << (x % 8));
+        }
+        else
+        {
+            line[x / 8] &= ~(1 << (x % 8));
+        }
+    }
+}
+
+/*  Count writes to [xStart, xEnd) on the given root row.
+*/
+void UIMemoryFrameBuffer::track(int32_t row, int32_t xStart, int32_t xEnd)
+{
+#if UIF_HOST
+    uint8_t* bits = root->written;
+
+    if (bits == NULL)
+    {
+        return;
+    }
+
+    uint8_t* line = &bits[row * stride];
+
+    for (int32_t x = xStart; x < xEnd; x++)
+    {
+        if (line[x / 8] & (1 << (x % 8)))
+        {
+            root->overdraw++;
+        }
+
+        line[x / 8] |= (1 << (x % 8));
+    }
+
+    root->pixelWrites += xEnd - xStart;
+#else
+    (void) row;
+    (void) xStart;
+    (void) xEnd;
+#endif
+}
+
+void UIMemoryFrameBuffer::drawPixel(uint16_t x, uint16_t y, uint8_t color)
+{
+    drawRectangle(x, x + 1, y, y + 1, color);
+}
+
+uint8_t UIMemoryFrameBuffer::getPixel(uint16_t x, uint16_t y) const
+{
+    int32_t rootX = xOrigin + x;
+    int32_t rootY = yOrigin + y;
+
+    if ((rootX >= clipX0) && (rootX < clipX1)
+        && (rootY >= clipY0) && (rootY < clipY1))
+    {
+        return (data[rootY * stride + rootX / 8] >> (rootX % 8)) & 0x01;
+    }
+
+    return 0;
+}
+
+void UIMemoryFrameBuffer::drawRectangle(uint16_t _x0, uint16_t _x1, uint16_t _y0, uint16_t _y1, uint8_t color)
+{
+    int32_t x0 = _x0;
+    int32_t x1 = _x1;
+    int32_t y0 = _y0;
+    int32_t y1 = _y1;
+
+    if (clip(x0, x1, y0, y1))
+    {
+        for (int32_t row = y0; row < y1; row++)
+        {
+            fillSpan(row, x0, x1, color);
+        }
+    }
+}
+
+/*  Composite image onto the buffer. Pixels with the mask bit set are given
+    the value of the image bit.
+*/
+bool UIMemoryFrameBuffer::drawImage(const struct CompBuf& image, int16_t x, int16_t y, uint8_t rotation)
+{
+    /* only unrotated images are supported */
+    if (rotation != 0)
+    {
+        return false;
+    }
+
+    int32_t x0 = x;
+    int32_t x1 = x + image.width_bits;
+    int32_t y0 = y;
+    int32_t y1 = y + image.height_strides;
+
+    if (!clip(x0, x1, y0, y1))
+    {
+        return true;
+    }
+
+    bool maskOnes = (image.mask == (uint8_t*) Comp_Fill_Ones);
+    bool maskZeros = (image.mask == (uint8_t*) Comp_Fill_Zeros);
+    bool bufOnes = (image.buf == (uint8_t*) Comp_Fill_Ones);
+    bool bufZeros = (image.buf == (uint8_t*) Comp_Fill_Zeros);
+
+    if (maskZeros)
+    {
+        return true;
+    }
+
+    /* image coordinates of the first visible pixel */
+    int32_t imageX = x0 - (xOrigin + x);
+    int32_t imageY = y0 - (yOrigin + y);
+
+    for (int32_t row = y0; row < y1; row++, imageY++)
+    {
+        const uint32_t rowBase = imageY * image.stride_bytes * 8 + image.bit_offset;
+
+        /* solid images are plain fills */
+        if (maskOnes && (bufOnes || bufZeros))
+        {
+            fillSpan(row, x0, x1, (bufOnes) ? 1 : 0);
+            continue;
+        }
+
+        for (int32_t col = x0, bit = rowBase + imageX; col < x1; col++, bit++)
+        {
+            uint8_t maskBit = (maskOnes) ? 1 : ((image.mask[bit / 8] >> (bit % 8)) & 0x01);
+
+            if (maskBit)
+            {
+                uint8_t pixel;
+
+                if (bufOnes)
+                {
+                    pixel = 1;
+                }
+                else if (bufZeros)
+                {
+                    pixel = 0;
+                }
+                else
+                {
+                    pixel = (image.buf[bit / 8] >> (bit % 8)) & 0x01;
+                }
+
+                track(row, col, col + 1);
+
+                if (pixel)
+                {
+                    data[row * stride + col / 8] |= (1 << (col % 8));
+                }
+                else
+                {
+                    data[row * stride + col / 8] &= ~(1 << (col % 8));
+                }
+            }
+        }
+    }
+
+    return true;
+}
+
+/*  Sub frame buffers starting above or left of this one are cut off at its
+    edge, as with the LCD frame buffers. Views account for the part that is
+    cut off through their offsets.
+*/
+SharedPointer<FrameBuffer> UIMemoryFrameBuffer::getFrameBuffer(int16_t x, int16_t y, uint16_t _width, uint16_t _height)
+{
+    if (x < 0)
+    {
+        _width = (_width > -x) ? _width + x : 0;
+        x = 0;
+    }
+
+    if (y < 0)
+    {
+        _height = (_height > -y) ? _height + y : 0;
+        y = 0;
+    }
+
+    return SharedPointer<FrameBuffer>(new UIMemoryFrameBuffer(*this,
+                                                              xOrigin + x,
+                                                              yOrigin + y,
+                                                              _width,
+                                                              _height));
+}
+
+uint16_t UIMemoryFrameBuffer::getWidth(void) const
+{
+    return width;
+}
+
+uint16_t UIMemoryFrameBuffer::getHeight(void) const
+{
+    return height;
+}
+
+uint8_t* UIMemoryFrameBuffer::getData(void) const
+{
+    return data;
+}
+
+uint16_t UIMemoryFrameBuffer::getStride(void) const
+{
+    return stride;
+}
+
+void UIMemoryFrameBuffer::fill(uint8_t color)
+{
+    drawRectangle(0, width, 0, height, color);
+}
+
+void UIMemoryFrameBuffer::scroll(int16_t lines)
+{
+    int32_t rows = clipY1 - clipY0;
+
+    if ((lines == 0) || (lines >= rows) || (-lines >= rows))
+    {
+        return;
+    }
+
+    uint8_t* first = &data[clipY0 * stride];
+
+    if (lines > 0)
+    {
+        memmove(first + lines * stride, first, (rows - lines) * stride);
+    }
+    else
+    {
+        memmove(first, first - lines * stride, (rows + lines) * stride);
+    }
+}
+
+#if UIF_HOST
+void UIMemoryFrameBuffer::setOverdrawTracking(bool enable)
+{
+    delete[] root->written;
+    root->written = NULL;
+
+    if (enable)
+    {
+        root->written = new uint8_t[stride * root->height];
+    }
+
+    resetOverdraw();
+}
+
+void UIMemoryFrameBuffer::resetOverdraw()
+{
+    if (root->written)
+    {
+        memset(root->written, 0, stride * root->height);
+    }
+
+    root->pixelWrites = 0;
+    root->overdraw = 0;
+}
+
+uint32_t UIMemoryFrameBuffer::getPixelWrites() const
+{
+    return root->pixelWrites;
+}
+
+uint32_t UIMemoryFrameBuffer::getOverdraw() const
+{
+    return root->overdraw;
+}
+#endif
@@ -0,0 +1,157 @@
+/* mbed
+ * Copyright (c) 2006-2015 ARM Limited
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#include "UIFramework/UIPrefetchQueue.h"
+
+#include <cstddef>
+
+
+UIPrefetchQueue::UIPrefetchQueue(uint32_t _capacity)
+    :   rows(NULL),
+        capacity(0),
+        depth(0),
+        maxDepth(0),
+        pushed(0),
+        duplicates(0),
+        dropped(0)
+{
+    setCapacity(_capacity);
+}
+
+UIPrefetchQueue::~UIPrefetchQueue()
+{
+    delete[] rows;
+}
+
+void UIPrefetchQueue::setCapacity(uint32_t _capacity)
+{
+    clear();
+
+    if (_capacity != capacity)
+    {
+        delete[] rows;
+
+        capacity = _capacity;
+        rows = (capacity > 0) ? new uint32_t[capacity] : NULL;
+    }
+}
+
+bool UIPrefetchQueue::push(uint32_t index)
+{
+    for (uint32_t idx = 0; idx < depth; idx++)
+    {
+        if (rows[idx] == index)
+        {
+            duplicates++;
+
+            return false;
+        }
+    }
+
+    if (depth == capacity)
+    {
+        return false;
+    }
+
+    rows[depth++] = index;
+    pushed++;
+
+    if (depth > maxDepth)
+    {
+        maxDepth = depth;
+    }
+
+    return true;
+}
+
+/*  The queue holds a handful of rows, shifting them down is cheaper than
+    keeping a ring.
+*/
+bool UIPrefetchQueue::pop(uint32_t& index)
+{
+    if (depth == 0)
+    {
+        return false;
+    }
+
+    index = rows[0];
+    depth--;
+
+    for (uint32_t idx = 0; idx < depth; idx++)
+    {
+        rows[idx] = rows[idx + 1];
+    }
+
+    return true;
+}
+
+void UIPrefetchQueue::retain(uint32_t first, uint32_t end)
+{
+    uint32_t kept = 0;
+
+    for (uint32_t idx = 0; idx < depth; idx++)
+    {
+        if ((rows[idx] >= first) && (rows[idx] < end))
+        {
+            rows[kept++] = rows[idx];
+        }
+        else
+        {
+            dropped++;
+        }
+    }
+
+    depth = kept;
+}
+
+void UIPrefetchQueue::clear()
+{
+    dropped += depth;
+    depth = 0;
+}
+
+uint32_t UIPrefetchQueue::getDepth() const
+{
+    return depth;
+}
+
+uint32_t UIPrefetchQueue::getMaxDepth() const
+{
+    return maxDepth;
+}
+
+uint32_t UIPrefetchQueue::getPushed() const
+{
+    return pushed;
+}
+
+uint32_t UIPrefetchQueue::getDuplicates() const
+{
+    return duplicates;
+}
+
+uint32_t UIPrefetchQueue::getDropped() const
+{
+    return dropped;
+}
+
+void UIPrefetchQueue::resetStatistics()
+{
+    maxDepth = depth;
+    pushed = 0;
+    duplicates = 0;
+    dropped = 0;
+}
@@ -0,0 +1,357 @@
+/* mbed
+ * Copyright (c) 2006-2015 ARM Limited
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#include "UIFramework/UIStreamArray.h"
+
+#include "UIFramework/UICellPool.h"
+#include "UIFramework/UITextView.h"
+
+#include <cstdlib>
+#include <cstring>
+
+
+UIStreamArray::UIStreamArray(SharedPointer<Source>& _source,
+                             const struct FontData* _font,
+                             uint32_t _rowHeight,
+                             uint32_t _rowWidth,
+                             const char* _title,
+                             uint32_t _stride)
+    :   UIView::Array(),
+        source(_source),
+        font(_font),
+        rowHeight(_rowHeight),
+        rowWidth(_rowWidth),
+        title(_title),
+        stride((_stride > 0) ? _stride : 1),
+        length(0),
+        records(0),
+        index(NULL),
+        indexSize(0),
+        blockClock(0),
+        cursorRecord(0),
+        cursorOffset(0),
+        blockReads(0),
+        scannedRecords(0)
+{
+    for (uint32_t block = 0; block < STREAM_BLOCKS; block++)
+    {
+        blockOffset[block] = 0;
+        blockValid[block] = 0;
+        blockUsed[block] = 0;
+    }
+
+    if (source.get() != NULL)
+    {
+        length = source->getLength();
+    }
+
+    buildIndex();
+}
+
+UIStreamArray::~UIStreamArray()
+{
+    free(index);
+}
+
+/*  Read the source once and note where every stride-th record starts.
+*/
+void UIStreamArray::buildIndex()
+{
+    uint32_t capacity = 0;
+    uint32_t offset = 0;
+    bool start = true;
+    bool full = false;
+
+    while ((offset < length) && !full)
+    {
+        uint32_t valid;
+        const uint8_t* bytes = getBlock(offset, &valid);
+
+        if (valid == 0)
+        {
+            /* read error, keep the records found so far */
+            length = offset;
+            break;
+        }
+
+        for (uint32_t idx = 0; idx < valid; idx++)
+        {
+            if (start)
+            {
+                if ((records % stride) == 0)
+                {
+                    if (indexSize == capacity)
+                    {
+                        uint32_t grown = (capacity > 0) ? 2 * capacity : 16;
+                        uint32_t* larger = (uint32_t*) realloc(index, grown * sizeof(uint32_t));
+
+                        if (larger == NULL)
+                        {
+                            /* out of memory, stop at the last indexed stride */
+                            full = true;
+                            break;
+                        }
+
+                        index = larger;
+                        capacity = grown;
+                    }
+
+                    index[indexSize++] = offset + idx;
+                }
+
+                records++;
+                start = false;
+            }
+
+            if (bytes[idx] == '\n')
+            {
+                start = true;
+            }
+        }
+
+        offset += valid;
+    }
+
+    /* give back what the doubling left unused */
+    if ((indexSize > 0) && (indexSize < capacity))
+    {
+        uint32_t* exact = (uint32_t*) realloc(index, indexSize * sizeof(uint32_t));
+
+        if (exact != NULL)
+        {
+            index = exact;
+        }
+    }
+}
+
+/*  Bytes from the offset to the end of its block, read from the source if
+    the block is not cached.
+*/
+const uint8_t* UIStreamArray::getBlock(uint32_t offset, uint32_t* valid) const
+{
+    uint32_t aligned = offset - (offset % DEFAULT_STREAM_BLOCK_SIZE);
+    uint32_t victim = 0;
+
+    blockClock++;
+
+    for (uint32_t block = 0; block < STREAM_BLOCKS; block++)
+    {
+        if ((blockValid[block] > 0) && (blockOffset[block] == aligned))
+        {
+            blockUsed[block] = blockClock;
+
+            *valid = (offset - aligned < blockValid[block]) ? blockValid[block] - (offset - aligned) : 0;
+
+            return &blocks[block][offset - aligned];
+        }
+
+        if (blockUsed[block] < blockUsed[victim])
+        {
+            victim = block;
+        }
+    }
+
+    blockOffset[victim] = aligned;
+    blockValid[victim] = source->read(aligned, blocks[victim], DEFAULT_STREAM_BLOCK_SIZE);
+    blockUsed[victim] = blockClock;
+    blockReads++;
+
+    *valid = (offset - aligned < blockValid[victim]) ? blockValid[victim] - (offset - aligned) : 0;
+
+    return &blocks[victim][offset - aligned];
+}
+
+/*  Offset of the record, found from the nearest index entry or from where
+    the last record read ended, whichever is closer.
+*/
+uint32_t UIStreamArray::findRecord(uint32_t record) const
+{
+    uint32_t entry = record / stride;
+    uint32_t current = entry * stride;
+    uint32_t offset = index[entry];
+
+    if ((cursorRecord <= record) && (cursorRecord > current))
+    {
+        current = cursorRecord;
+        offset = cursorOffset;
+    }
+
+    while ((current < record) && (offset < length))
+    {
+        uint32_t valid;
+        const uint8_t* bytes = getBlock(offset, &valid);
+
+        if (valid == 0)
+        {
+            break;
+        }
+
+        const uint8_t* newline = (const uint8_t*) memchr(bytes, '\n', valid);
+
+        if (newline != NULL)
+        {
+            offset += (newline - bytes) + 1;
+            current++;
+            scannedRecords++;
+        }
+        else
+        {
+            offset += valid;
+        }
+    }
+
+    return offset;
+}
+
+uint32_t UIStreamArray::getRecord(uint32_t record, char* buffer, uint32_t size) const
+{
+    if (size == 0)
+    {
+        return 0;
+    }
+
+    buffer[0] = '\0';
+
+    if (record >= records)
+    {
+        return 0;
+    }
+
+    uint32_t offset = findRecord(record);
+    uint32_t copied = 0;
+    bool found = false;
+
+    /* copy what fits, but read on to the end of the record for the cursor */
+    while (!found && (offset < length))
+    {
+        uint32_t valid;
+        const uint8_t* bytes = getBlock(offset, &valid);
+
+        if (valid == 0)
+        {
+            break;
+        }
+
+        const uint8_t* newline = (const uint8_t*) memchr(bytes, '\n', valid);
+        uint32_t part = (newline != NULL) ? newline - bytes : valid;
+        uint32_t room = size - 1 - copied;
+        uint32_t copy = (part < room) ? part : room;
+
+        memcpy(&buffer[copied], bytes, copy);
+        copied += copy;
+
+        offset += part;
+
+        if (newline != NULL)
+        {
+            offset++;
+            found = true;
+        }
+    }
+
+    if ((copied > 0) && (buffer[copied - 1] == '\r'))
+    {
+        copied--;
+    }
+
+    buffer[copied] = '\0';
+
+    cursorRecord = record + 1;
+    cursorOffset = offset;
+
+    return copied;
+}
+
+uint32_t UIStreamArray::getIndexBytes() const
+{
+    return indexSize * sizeof(uint32_t);
+}
+
+uint32_t UIStreamArray::getBlockReads() const
+{
+    return blockReads;
+}
+
+uint32_t UIStreamArray::getScannedRecords() const
+{
+    return scannedRecords;
+}
+
+/*  UIView::Array */
+uint32_t UIStreamArray::getSize() const
+{
+    return records;
+}
+
+SharedPointer<UIView> UIStreamArray::viewAtIndex(uint32_t record) const
+{
+    char buffer[DEFAULT_STREAM_RECORD_LENGTH];
+
+    getRecord(record, buffer, sizeof(buffer));
+
+    std::string text(buffer);
+
+    UITextView* cell = new UITextView(text, font);
+    cell->setReuseType(STREAM_CELL_REUSE_TYPE);
+
+    return SharedPointer<UIView>(cell);
+}
+
+/*  Rebind a text cell from the pool to the record, if there is one.
+*/
+SharedPointer<UIView> UIStreamArray::viewAtIndex(uint32_t record, UICellPool& pool) const
+{
+    SharedPointer<UIView> cell = pool.dequeue(STREAM_CELL_REUSE_TYPE);
+
+    if (cell == NULL)
+    {
+        return viewAtIndex(record);
+    }
+
+    char buffer[DEFAULT_STREAM_RECORD_LENGTH];
+
+    getRecord(record, buffer, sizeof(buffer));
+
+    std::string text(buffer);
+
+    static_cast<UITextView*>(cell.get())->setText(text);
+
+    return cell;
+}
+
+uint32_t UIStreamArray::heightAtIndex(uint32_t record) const
+{
+    (void) record;
+
+    return rowHeight;
+}
+
+uint32_t UIStreamArray::widthAtIndex(uint32_t record) const
+{
+    (void) record;
+
+    return rowWidth;
+}
+
+uint32_t UIStreamArray::getUniformHeight() const
+{
+    return rowHeight;
+}
+
+const char* UIStreamArray::getTitle() const
+{
+    return title;
+}
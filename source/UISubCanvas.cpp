@@ -0,0 +1,212 @@
+/* mbed
+ * Copyright (c) 2006-2015 ARM Limited
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#include "UIFramework/UISubCanvas.h"
+
+
+UISubCanvas::UISubCanvas()
+    :   FrameBuffer(),
+        parent(NULL),
+        xOrigin(0),
+        yOrigin(0),
+        width(0),
+        height(0)
+{}
+
+void UISubCanvas::setWindow(FrameBuffer* _parent, int16_t x, int16_t y, uint16_t _width, uint16_t _height)
+{
+    if (x < 0)
+    {
+        _width = (_width > -x) ? _width + x : 0;
+        x = 0;
+    }
+
+    if (y < 0)
+    {
+        _height = (_height > -y) ? _height + y : 0;
+        y = 0;
+    }
+
+    /* parents are not required to clip, so stay within their extent */
+    if (_parent)
+    {
+        uint16_t parentWidth = _parent->getWidth();
+        uint16_t parentHeight = _parent->getHeight();
+
+        if (x + _width > parentWidth)
+        {
+            _width = (parentWidth > x) ? parentWidth - x : 0;
+        }
+
+        if (y + _height > parentHeight)
+        {
+            _height = (parentHeight > y) ? parentHeight - y : 0;
+        }
+    }
+
+    parent = _parent;
+    xOrigin = x;
+    yOrigin = y;
+    width = _width;
+    height = _height;
+}
+
+void UISubCanvas::clearWindow()
+{
+    parent = NULL;
+    width = 0;
+    height = 0;
+}
+
+void UISubCanvas::drawPixel(uint16_t x, uint16_t y, uint8_t color)
+{
+    if (parent && (x < width) && (y < height))
+    {
+        parent->drawPixel(xOrigin + x, yOrigin + y, color);
+    }
+}
+
+uint8_t UISubCanvas::getPixel(uint16_t x, uint16_t y) const
+{
+    if (parent && (x < width) && (y < height))
+    {
+        return parent->getPixel(xOrigin + x, yOrigin + y);
+    }
+
+    return 0;
+}
+
+void UISubCanvas::drawRectangle(uint16_t x0, uint16_t x1, uint16_t y0, uint16_t y1, uint8_t color)
+{
+    if (x1 > width)
+    {
+        x1 = width;
+    }
+
+    if (y1 > height)
+    {
+        y1 = height;
+    }
+
+    if (parent && (x0 < x1) && (y0 < y1))
+    {
+        parent->drawRectangle(xOrigin + x0, xOrigin + x1, yOrigin + y0, yOrigin + y1, color);
+    }
+}
+
+/*  Images crossing the window edge are cropped by moving the start of the
+    image data, so the parent never draws outside the window.
+*/
+bool UISubCanvas::drawImage(const struct CompBuf& image, int16_t x, int16_t y, uint8_t rotation)
+{
+    if (parent == NULL)
+    {
+        return true;
+    }
+
+    /* only unrotated images can be cropped */
+    if (rotation != 0)
+    {
+        return parent->drawImage(image, xOrigin + x, yOrigin + y, rotation);
+    }
+
+    int32_t x0 = (x > 0) ? x : 0;
+    int32_t y0 = (y > 0) ? y : 0;
+    int32_t x1 = x + image.width_bits;
+    int32_t y1 = y + image.height_strides;
+
+    if (x1 > width)
+    {
+        x1 = width;
+    }
+
+    if (y1 > height)
+    {
+        y1 = height;
+    }
+
+    if ((x0 >= x1) || (y0 >= y1))
+    {
+        return true;
+    }
+
+    struct CompBuf cropped = image;
+
+    uint32_t skipBits = image.bit_offset + (x0 - x);
+    uint32_t skipBytes = (y0 - y) * image.stride_bytes + skipBits / 8;
+
+    /* solid fills have no data to move */
+    if ((image.buf != (uint8_t*) Comp_Fill_Ones) && (image.buf != (uint8_t*) Comp_Fill_Zeros))
+    {
+        cropped.buf = image.buf + skipBytes;
+    }
+
+    if ((image.mask != (uint8_t*) Comp_Fill_Ones) && (image.mask != (uint8_t*) Comp_Fill_Zeros))
+    {
+        cropped.mask = image.mask + skipBytes;
+    }
+
+    cropped.bit_offset = skipBits % 8;
+    cropped.width_bits = x1 - x0;
+    cropped.height_strides = y1 - y0;
+
+    return parent->drawImage(cropped, xOrigin + x0, yOrigin + y0, rotation);
+}
+
+/*  Nested windows are rare and not on the render path; they are taken from
+    the parent directly.
+*/
+SharedPointer<FrameBuffer> UISubCanvas::getFrameBuffer(int16_t x, int16_t y, uint16_t _width, uint16_t _height)
+{
+    if (parent == NULL)
+    {
+        return SharedPointer<FrameBuffer>();
+    }
+
+    if (x < 0)
+    {
+        _width = (_width > -x) ? _width + x : 0;
+        x = 0;
+    }
+
+    if (y < 0)
+    {
+        _height = (_height > -y) ? _height + y : 0;
+        y = 0;
+    }
+
+    if (x + _width > width)
+    {
+        _width = (width > x) ? width - x : 0;
+    }
+
+    if (y + _height > height)
+    {
+        _height = (height > y) ? height - y : 0;
+    }
+
+    return parent->getFrameBuffer(xOrigin + x, yOrigin + y, _width, _height);
+}
+
+uint16_t UISubCanvas::getWidth(void) const
+{
+    return width;
+}
+
+uint16_t UISubCanvas::getHeight(void) const
+{
+    return height;
+}
@@ -16,6 +16,8 @@
 
 #include "UIFramework/UITableKineticView.h"
 
+#include "UIFramework/UIClock.h"
+
 
 #if 0
 #include <stdio.h>
@@ -27,12 +29,14 @@
 UITableKineticView::UITableKineticView(SharedPointer<UIView::Array>& table,
                                        uint32_t width,
                                        uint32_t height,
-                                       int32_t  offset)
-    :   UITableView(table),
+                                       int32_t  offset,
+                                       uint32_t cacheSize)
+    :   UITableView(table, cacheSize),
         friction(5),
         magnetism(0),
-        coasting(0),
         sliderNotPressed(true),
+        physics(),
+        frameTime(0),
         globalOffset(offset)
 {
     UIView::width = width;
@@ -46,6 +50,8 @@ UITableKineticView::UITableKineticView(SharedPointer<UIView::Array>& table,
     firstOffset = UITableView::getPixels() + globalOffset;
 
     UITableView::setCenter(table->getDefaultIndex());
+
+    physics.setBounds(firstOffset, lastOffset);
 }
 
 int32_t UITableKineticView::getFirstOffset()
@@ -72,22 +78,14 @@ bool UITableKineticView::findMagnetism()
     }
     else
     {
-        uint32_t firstIndex = UITableView::getFirstIndex();
-        uint32_t firstOverflow = UITableView::getFirstOverflow();
-        uint32_t firstHeight = table->heightAtIndex(firstIndex);
-
-        int32_t heightSum = firstHeight - firstOverflow;
-
-        uint32_t tableIndex = firstIndex + 1;
-        uint32_t tableSize = table->getSize();
+        /* row under the center line and how far its bottom edge is below it */
+        int32_t center = UIView::height / 2 + globalOffset;
+        int32_t heightSum = 0;
 
-        for (; (tableIndex < tableSize) && (heightSum < (UIView::height / 2 + globalOffset)); tableIndex++)
-        {
-            heightSum += table->heightAtIndex(tableIndex);
-        }
+        uint32_t centerIndex = UITableView::getRowAtDistance(center, &heightSum);
 
-        uint32_t overflow = heightSum - (UIView::height / 2 + globalOffset);
-        uint32_t cellHeight = table->heightAtIndex(tableIndex - 1);
+        uint32_t overflow = heightSum - center;
+        uint32_t cellHeight = UITableView::rowHeight(centerIndex);
 
         if (overflow > (cellHeight / 2))
         {
@@ -113,6 +111,8 @@ void UITableKineticView::sliderPressed()
     magnetism = 0;
     sliderNotPressed = false;
 
+    physics.stop();
+
     if (wakeupCallback)
     {
         wakeupCallback();
@@ -157,6 +157,12 @@ void UITableKineticView::sliderChangedWithSpeed(int32_t speedPx)
     }
 
     UITableView::scrollPx(scaledSpeed);
+    UITableView::setScrollVelocity(scaledSpeed);
+
+    if (wakeupCallback)
+    {
+        wakeupCallback();
+    }
 }
 
 void UITableKineticView::sliderReleasedWithSpeed(int32_t speedPx)
@@ -182,68 +188,77 @@ void UITableKineticView::sliderReleasedWithSpeed(int32_t speedPx)
 
     if ((filteredSpeed > 10) || (filteredSpeed < -10))
     {
-        coasting = filteredSpeed;
+        physics.fling(filteredSpeed);
     }
-    else
+    else if (findMagnetism())
     {
-        findMagnetism();
+        physics.snap(magnetism);
     }
+
+    startMotion();
+
+    if (wakeupCallback)
+    {
+        wakeupCallback();
+    }
+}
+
+
+/*  Motion starts now, the first frame integrates from here.
+*/
+void UITableKineticView::startMotion()
+{
+    frameTime = UIClock::getTime();
 }
 
+/*  Scroll right away, so the next snap is measured from the new position.
+*/
+void UITableKineticView::move(int32_t pixels)
+{
+    if (pixels != 0)
+    {
+        UITableView::scrollPx(pixels);
+        UITableView::updateTable();
+    }
+}
 
 /*  UIView */
 uint32_t UITableKineticView::fillFrameBuffer(SharedPointer<FrameBuffer>& canvas, int16_t xOffset, int16_t yOffset)
 {
-    uint32_t callInterval = ULONG_MAX;
+    uint32_t callInterval = UINT32_MAX;
 
     if (sliderNotPressed && (xOffset == 0) && (yOffset == 0))
     {
-        if (coasting != 0)
-        {
-            /* set friction based on whether we are inside our outside the table. */
-            int32_t offset = UITableView::getPixels();
-
-            if ((offset < lastOffset) || (offset > firstOffset))
-            {
-                coasting = coasting / 2;
-            }
+        /* time since the last frame, however long it took */
+        uint32_t now = UIClock::getTime();
+        uint32_t elapsed = UIClock::elapsed(frameTime, now);
 
-            UITableView::scrollPx(coasting);
-            callInterval = 0;
+        frameTime = now;
 
-            if (coasting > (int32_t) friction)
-            {
-                coasting -= friction;
-            }
-            else if (coasting < -((int32_t) friction))
-            {
-                coasting += friction;
-            }
-            else
-            {
-                coasting = 0;
-            }
-        }
-        else if (magnetism != 0)
+        if (physics.isMoving())
         {
-            int32_t scroll = magnetism / 2;
+            physics.setFriction(friction);
 
-            if (scroll == 0)
+            move(physics.advance(elapsed, UITableView::getPixels()));
+
+            /* came to rest during the frame, snap for the rest of it */
+            if (!physics.isMoving() && findMagnetism())
             {
-                scroll = magnetism;
+                physics.snap(magnetism);
+
+                move(physics.advance(0, UITableView::getPixels()));
             }
 
-            UITableView::scrollPx(scroll);
-            magnetism -= scroll;
             callInterval = 0;
         }
-        else
+        else if (findMagnetism())
         {
-            if (findMagnetism() != 0)
-            {
-                callInterval = 0;
-            }
+            physics.snap(magnetism);
+            callInterval = 0;
         }
+
+        /* prefetch further ahead the faster the table coasts */
+        UITableView::setScrollVelocity(physics.getSpeed());
     }
 
     uint32_t interval = UITableView::fillFrameBuffer(canvas, xOffset, yOffset);
@@ -251,3 +266,27 @@ uint32_t UITableKineticView::fillFrameBuffer(SharedPointer<FrameBuffer>& canvas,
 
     return (!sliderNotPressed) ? 0 : callInterval;
 }
+
+/*  Still moving while coasting or snapping to the nearest cell. When the
+    table has come to rest, check whether it needs to snap.
+*/
+bool UITableKineticView::isMoving()
+{
+    if (sliderNotPressed && !physics.isMoving() && findMagnetism())
+    {
+        physics.snap(magnetism);
+        startMotion();
+    }
+
+    return physics.isMoving();
+}
+
+bool UITableKineticView::isDirty()
+{
+    return isMoving() || UITableView::isDirty();
+}
+
+UIView::Rect UITableKineticView::getDirtyRect()
+{
+    return (isMoving()) ? getBounds() : UITableView::getDirtyRect();
+}
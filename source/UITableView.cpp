@@ -17,7 +17,8 @@
 
 #include "UIFramework/UITableView.h"
 
-#include "mbed-drivers/mbed.h"
+#include "UIFramework/UIPlatform.h"
+#include "UIFramework/UIClock.h"
 
 
 #if 0
@@ -27,381 +28,1086 @@
 #define UIF_PRINTF(...)
 #endif
 
-UITableView::UITableView(SharedPointer<UIView::Array>& _table, uint32_t _cacheSize)
+UITableView::UITableView(SharedPointer<UIView::Array>& _table, uint32_t _cacheSize, uint32_t _cacheWays)
     :   UIView(),
         table(_table),
         topRow(0),
         topCellOverflow(0),
-        cacheSize(_cacheSize),
-        lookUpTable(NULL),
-        cache(NULL),
-        cacheTopCallbackHandle(NULL),
-        cacheBottomCallbackHandle(NULL),
+        heightIndex(),
+        cellPool(),
+        cellCache(_cacheSize, _cacheWays),
+        cellWindow(new UISubCanvas()),
+        cellCanvas(cellWindow),
+        batchFirst(0),
+        batchCount(0),
+        layoutCount(0),
+        layoutNext(0),
+        layoutPasses(0),
+        positionRow(0),
+        positionTop(0),
+        positionValid(false),
+        visibleFirst(0),
+        visibleEnd(0),
+        prefetchQueue(DEFAULT_PREFETCH_ROWS + 1),
+        prefetchCallbackHandle(NULL),
+        prefetchRows(DEFAULT_PREFETCH_ROWS),
+        prefetchTime(DEFAULT_PREFETCH_TIME_MS * 1000),
+        scrollVelocity(0),
+        blitScrolling(false),
+        layerBuffer(NULL),
+        layerWindow(new UISubCanvas()),
+        layerCanvas(layerWindow),
+        layerValid(false),
+        layerPosition(0),
+        layerInterval(UINT32_MAX),
+        renderedLines(0),
         outstandingScrollPx(0)
 {
-    cache = new SharedPointer<UIView>[cacheSize];
-    lookUpTable = new uint32_t[cacheSize];
+    /* background and cells cover the whole table */
+    opaque = true;
 
-    /* initialize cache */
-    for (uint32_t idx = 0; idx < cacheSize; idx++)
-    {
-        lookUpTable[idx] = 0xFFFFFFFF;
-    }
+    cellCache.setPool(&cellPool);
+
+    table->addListener(this);
 }
 
 UITableView::~UITableView()
 {
-    delete[] cache;
-    delete[] lookUpTable;
+    table->removeListener(this);
 
     // Cancel any callbacks that might have been scheduled but not executed
-    if (cacheTopCallbackHandle)
+    if (prefetchCallbackHandle)
+    {
+        minar::Scheduler::cancelCallback(prefetchCallbackHandle);
+    }
+}
+
+bool UITableView::isCached(uint32_t index)
+{
+    SharedPointer<UIView>& cell = cellCache.peek(index);
+
+    return (cell != NULL) && cell->isValid();
+}
+
+void UITableView::insertCell(SharedPointer<UIView>& cell, uint32_t index, bool prefetched)
+{
+    if (cell->isCacheable())
+    {
+        cellCache.insert(index, cell, prefetched);
+    }
+}
+
+void UITableView::fetchRow(uint32_t index)
+{
+    UIF_PRINTF("UITableView: prefetch: %lu\r\n", index);
+
+    // get cell at index
+    SharedPointer<UIView> cell = table->viewAtIndex(index, cellPool);
+
+    // propagate wakeup callback
+    cell->setWakeupCallback(wakeupCallback);
+
+    // propagate color inversion
+    cell->setInverse(inverse);
+
+    // rows outside the view stay quiet until they scroll in, see updateVisibleRange
+    if ((index < visibleFirst) || (index >= visibleEnd))
     {
-        minar::Scheduler::cancelCallback(cacheTopCallbackHandle);
+        cell->suspend();
+    }
+
+    // prefetch cell content
+    cell->prefetch(0, 0);
+
+    // insert cell in cache
+    insertCell(cell, index, true);
+}
+
+/*  Get the cell for a visible row from the cache if it exists and is still
+    valid. Otherwise take it from the rows fetched in the last batch, or fetch
+    it together with the missing rows below it, up to lastRow, in one call to
+    the table-object.
+*/
+SharedPointer<UIView> UITableView::getCell(uint32_t row, uint32_t lastRow)
+{
+    SharedPointer<UIView> cell = cellCache.lookup(row);
+
+    if ((cell != NULL) && cell->isValid())
+    {
+        return cell;
+    }
+
+    UIF_PRINTF("UITableView: miss: %lu\r\n", row);
+
+    if ((row < batchFirst) || (row >= batchFirst + batchCount))
+    {
+        uint32_t last = row + 1;
+
+        while ((last <= lastRow) && (last < row + FETCH_BATCH_ROWS) && !isCached(last))
+        {
+            last++;
+        }
+
+        // get cells at indices
+        table->viewsInRange(row, last, batch, cellPool);
+
+        batchFirst = row;
+        batchCount = last - row;
+    }
+
+    cell = batch[row - batchFirst];
+
+    // propagate wakeup callback
+    cell->setWakeupCallback(wakeupCallback);
+
+    // reused cells may have been suspended when they left the view
+    cell->resume();
+
+    // propagate color inversion
+    cell->setInverse(inverse);
+
+    // insert cell in cache
+    insertCell(cell, row);
+
+    UIF_PRINTF("UITableView: cell: %p\r\n", cell.get());
+
+    return cell;
+}
+
+/*  Suspend the cached cells of rows that scrolled out of view and resume
+    the ones that scrolled back in. Cells fetched for a visible row are
+    resumed in getCell.
+*/
+void UITableView::updateVisibleRange()
+{
+    uint32_t first = topRow;
+    uint32_t end = (table->getSize() > 0) ? getLastIndex() + 1 : 0;
+
+    for (uint32_t row = visibleFirst; row < visibleEnd; row++)
+    {
+        if ((row < first) || (row >= end))
+        {
+            SharedPointer<UIView>& cell = cellCache.peek(row);
+
+            if (cell != NULL)
+            {
+                cell->suspend();
+            }
+        }
     }
 
-    if (cacheBottomCallbackHandle)
+    for (uint32_t row = first; row < end; row++)
     {
-        minar::Scheduler::cancelCallback(cacheBottomCallbackHandle);
+        if ((row < visibleFirst) || (row >= visibleEnd))
+        {
+            SharedPointer<UIView>& cell = cellCache.peek(row);
+
+            if (cell != NULL)
+            {
+                cell->resume();
+            }
+        }
     }
+
+    visibleFirst = first;
+    visibleEnd = end;
 }
 
-SharedPointer<UIView>& UITableView::getCellAtCacheIndex(uint32_t index)
+/*  Rows to fetch around the visible ones: one row on either side, plus as
+    many rows in the direction of scrolling as the current velocity covers in
+    PREFETCH_LOOKAHEAD_FRAMES frames. The window is limited by the row budget
+    and by the room the visible rows leave in the cache, so prefetching never
+    evicts a row on screen.
+*/
+void UITableView::updatePrefetchWindow(uint32_t bottomRow)
 {
-    uint32_t tableIndex = index % cacheSize;
+    if (prefetchRows == 0)
+    {
+        prefetchQueue.clear();
+
+        return;
+    }
+
+    uint32_t tableSize = table->getSize();
+    uint32_t depth = 1;
+
+    if ((scrollVelocity != 0) && (tableSize > 0))
+    {
+        uint32_t speed = (scrollVelocity > 0) ? scrollVelocity : -scrollVelocity;
+        uint32_t averageHeight = heightIndex.getTotalHeight() / tableSize;
+
+        if (averageHeight == 0)
+        {
+            averageHeight = 1;
+        }
+
+        depth += (speed * PREFETCH_LOOKAHEAD_FRAMES + averageHeight - 1) / averageHeight;
+    }
+
+    if (depth > prefetchRows)
+    {
+        depth = prefetchRows;
+    }
 
-    if (lookUpTable[tableIndex] == index)
+    uint32_t visibleRows = bottomRow - topRow;
+    uint32_t room = (cellCache.getSize() > visibleRows + 1) ? cellCache.getSize() - visibleRows - 1 : 1;
+
+    if (depth > room)
     {
-        return cache[tableIndex];
+        depth = room;
+    }
+
+    /* positive velocities scroll towards the top of the table */
+    uint32_t depthAbove = (scrollVelocity > 0) ? depth : 1;
+    uint32_t depthBelow = (scrollVelocity < 0) ? depth : 1;
+
+    uint32_t aboveEnd = (topRow > depthAbove) ? topRow - depthAbove : 0;
+    uint32_t belowEnd = (bottomRow + depthBelow < tableSize) ? bottomRow + depthBelow : tableSize;
+
+    /* rows that scrolled out of the window are not worth fetching anymore */
+    prefetchQueue.retain(aboveEnd, belowEnd);
+
+    /* queue rows nearest the visible ones first, in the direction of scrolling first */
+    for (uint32_t pass = 0; pass < 2; pass++)
+    {
+        if ((pass == 0) == (scrollVelocity <= 0))
+        {
+            for (uint32_t row = bottomRow; row < belowEnd; row++)
+            {
+                if (!isCached(row))
+                {
+                    prefetchQueue.push(row);
+                }
+            }
+        }
+        else
+        {
+            for (uint32_t row = topRow; row > aboveEnd; row--)
+            {
+                if (!isCached(row - 1))
+                {
+                    prefetchQueue.push(row - 1);
+                }
+            }
+        }
+    }
+
+    /* one task works through the queue, however many frames add to it */
+    if ((prefetchCallbackHandle == NULL) && (prefetchQueue.getDepth() > 0))
+    {
+        prefetchCallbackHandle = minar::Scheduler::postCallback(this, &UITableView::runPrefetchQueue)
+                                    .getHandle();
+    }
+}
+
+/*  Fetch queued rows until the queue is empty or the time budget for this
+    slot is used up, then leave the rest for the next slot. Rows that have
+    been drawn, and so cached, in the meantime are skipped.
+*/
+void UITableView::runPrefetchQueue()
+{
+    prefetchCallbackHandle = NULL;
+
+    uint32_t start = UIClock::getTime();
+    uint32_t row;
+
+    while (prefetchQueue.pop(row))
+    {
+        if (isCached(row))
+        {
+            continue;
+        }
+
+        fetchRow(row);
+
+        if (UIClock::elapsed(start) >= prefetchTime)
+        {
+            break;
+        }
+    }
+
+    cellCache.trim(visibleFirst, visibleEnd);
+
+    if (prefetchQueue.getDepth() > 0)
+    {
+        prefetchCallbackHandle = minar::Scheduler::postCallback(this, &UITableView::runPrefetchQueue)
+                                    .getHandle();
+    }
+}
+
+void UITableView::setScrollVelocity(int32_t pixelsPerFrame)
+{
+    scrollVelocity = pixelsPerFrame;
+}
+
+void UITableView::setPrefetchBudget(uint32_t rows, uint32_t timeInMilliseconds)
+{
+    prefetchRows = rows;
+    prefetchTime = timeInMilliseconds * 1000;
+
+    /* the window never holds more than the rows ahead and the row behind */
+    prefetchQueue.setCapacity(rows + 1);
+}
+
+UIPrefetchQueue& UITableView::getPrefetchQueue()
+{
+    return prefetchQueue;
+}
+
+void UITableView::setBlitScrolling(bool enable)
+{
+    blitScrolling = enable;
+
+    if (!blitScrolling)
+    {
+        layer = SharedPointer<FrameBuffer>();
+        layerBuffer = NULL;
+        layerValid = false;
+    }
+}
+
+bool UITableView::getBlitScrolling() const
+{
+    return blitScrolling;
+}
+
+uint32_t UITableView::getRenderedLines() const
+{
+    return renderedLines;
+}
+
+uint32_t UITableView::getLayoutPasses() const
+{
+    return layoutPasses;
+}
+
+UICellCache& UITableView::getCellCache()
+{
+    return cellCache;
+}
+
+UICellPool& UITableView::getCellPool()
+{
+    return cellPool;
+}
+
+void UITableView::scrollPx(int32_t pixels)
+{
+    outstandingScrollPx += pixels;
+}
+
+void UITableView::updateTable()
+{
+    if (outstandingScrollPx > 0)
+    {
+        scrollPxBackward(outstandingScrollPx);
+    }
+    else if (outstandingScrollPx < 0)
+    {
+        scrollPxForward(-outstandingScrollPx);
+    }
+
+    outstandingScrollPx = 0;
+}
+
+/*  Bring the height index up to date with the size of the table. Rows that
+    change height without changing the size are updated through reloadRow.
+*/
+void UITableView::updateIndex()
+{
+    uint32_t tableSize = table->getSize();
+
+    if (heightIndex.getSize() != tableSize)
+    {
+        heightIndex.build(*table);
+        invalidateLayout();
+
+        if (topRow >= tableSize)
+        {
+            topRow = 0;
+            topCellOverflow = 0;
+        }
+    }
+}
+
+/*  Move to the given pixel position, measured from the top of the first row.
+*/
+void UITableView::setPosition(uint32_t position)
+{
+    topRow = heightIndex.findRow(position, &topCellOverflow);
+
+    /* the lookup gives the position of the top row for free */
+    positionRow = topRow;
+    positionTop = position - topCellOverflow;
+    positionValid = true;
+}
+
+/*  Pixel position of the top of topRow, looked up once per top row.
+*/
+uint32_t UITableView::getTopPosition()
+{
+    if (!positionValid || (positionRow != topRow))
+    {
+        positionRow = topRow;
+        positionTop = heightIndex.getPosition(topRow);
+        positionValid = true;
+    }
+
+    return positionTop;
+}
+
+/*  Heights have changed, rows and positions must be looked up again.
+*/
+void UITableView::invalidateLayout()
+{
+    layoutCount = 0;
+    layoutNext = 0;
+    positionValid = false;
+}
+
+// Update internal view
+// Updates variables topRow and topCellOverflow
+void UITableView::scrollPxForward(uint32_t pixels)
+{
+    updateIndex();
+
+    uint32_t tableSize = table->getSize();
+
+    if (tableSize > 1)
+    {
+        uint32_t position = getTopPosition() + topCellOverflow + pixels;
+        uint32_t totalHeight = heightIndex.getTotalHeight();
+
+        /*  Stop when the last row reaches the bottom of the table,
+            or stay at the top if there are not enough rows to fill it.
+        */
+        if (totalHeight < height)
+        {
+            position = 0;
+        }
+        else if (position > totalHeight - height)
+        {
+            position = totalHeight - height;
+        }
+
+        setPosition(position);
+    }
+}
+
+void UITableView::scrollPxBackward(uint32_t pixels)
+{
+    /*  The scroll amount is smaller than the topRow overflow.
+        Top row is unchanged.
+    */
+    if (topCellOverflow > pixels)
+    {
+        topCellOverflow -= pixels;
     }
     else
     {
-        return cacheMiss;
+        updateIndex();
+
+        uint32_t position = getTopPosition() + topCellOverflow;
+
+        setPosition((position > pixels) ? position - pixels : 0);
     }
 }
 
-void UITableView::insertCell(SharedPointer<UIView>& cell, uint32_t index)
+void UITableView::setPixels(int32_t pixels)
 {
-    if (cell->isCacheable())
+    topRow = 0;
+    topCellOverflow = 0;
+    outstandingScrollPx = 0;
+
+    UIView::markDirty();
+
+    if (pixels > 0)
+    {
+        scrollPxBackward(pixels);
+    }
+    else
+    {
+        scrollPxForward(-pixels);
+    }
+}
+
+int32_t UITableView::getPixels()
+{
+    updateIndex();
+
+    return -(getTopPosition() + topCellOverflow);
+}
+
+void UITableView::setCenter(uint32_t index)
+{
+    updateIndex();
+
+    uint32_t tableSize = table->getSize();
+
+    if (index < tableSize)
+    {
+        int32_t center = heightIndex.getPosition(index) + rowHeight(index) / 2;
+
+        setPixels(-(center - (int32_t) (height / 2)));
+    }
+}
+
+/*  Rows are expected to keep their height. Tell the table when one has
+    changed anyway, so the index and the cached cell are updated.
+*/
+void UITableView::reloadRow(uint32_t index)
+{
+    updateIndex();
+
+    heightIndex.setHeight(index, table->heightAtIndex(index));
+    invalidateLayout();
+
+    cellCache.remove(index);
+
+    UIView::markDirty();
+}
+
+void UITableView::reloadTable()
+{
+    heightIndex.build(*table);
+    invalidateLayout();
+
+    cellCache.clear();
+
+    /* keep the scroll position within the new table */
+    if (topRow >= table->getSize())
+    {
+        topRow = 0;
+        topCellOverflow = 0;
+    }
+
+    scrollPxForward(0);
+
+    UIView::markDirty();
+}
+
+/*  Rows at and after first moved by delta after rows were inserted or
+    deleted. Cached cells and the rows last drawn follow them, while queued
+    and batched rows are simply dropped.
+*/
+void UITableView::rowsMoved(uint32_t first, int32_t delta)
+{
+    cellCache.shift(first, delta);
+
+    uint32_t removed = (delta < 0) ? -delta : 0;
+
+    if (visibleFirst >= first)
+    {
+        visibleFirst += delta;
+    }
+    else if (visibleFirst + removed > first)
+    {
+        visibleFirst = first - removed;
+    }
+
+    if (visibleEnd >= first)
+    {
+        visibleEnd += delta;
+    }
+    else if (visibleEnd + removed > first)
+    {
+        visibleEnd = first - removed;
+    }
+
+    prefetchQueue.clear();
+
+    for (uint32_t index = 0; index < batchCount; index++)
+    {
+        batch[index] = SharedPointer<UIView>();
+    }
+
+    batchCount = 0;
+}
+
+void UITableView::rowsInserted(uint32_t first, uint32_t count)
+{
+    uint32_t tableSize = table->getSize();
+
+    /* changes the table was not told about, start over */
+    if ((heightIndex.getSize() + count != tableSize) || (first + count > tableSize))
+    {
+        reloadTable();
+        return;
+    }
+
+    bool wasEmpty = (heightIndex.getSize() == 0);
+
+    heightIndex.insert(first, count, *table);
+    invalidateLayout();
+    rowsMoved(first, count);
+
+    uint32_t added = heightIndex.getPosition(first + count) - heightIndex.getPosition(first);
+
+    if (!wasEmpty && (first <= topRow))
+    {
+        /* above the screen, keep showing the same rows */
+        topRow += count;
+        layerPosition += added;
+    }
+    else if (first < visibleEnd)
+    {
+        layerValid = false;
+        UIView::markDirty();
+    }
+}
+
+void UITableView::rowsDeleted(uint32_t first, uint32_t count)
+{
+    uint32_t tableSize = table->getSize();
+
+    if ((heightIndex.getSize() != tableSize + count) || (first > tableSize))
+    {
+        reloadTable();
+        return;
+    }
+
+    /* height of the deleted rows, before the index forgets them */
+    uint32_t removed = heightIndex.getPosition(first + count) - heightIndex.getPosition(first);
+
+    if (first + count <= topRow)
+    {
+        /* above the screen, keep showing the same rows */
+        topRow -= count;
+        layerPosition -= removed;
+    }
+    else if (first <= topRow)
+    {
+        /* the top row went, show what followed it */
+        topRow = first;
+        topCellOverflow = 0;
+        layerValid = false;
+        UIView::markDirty();
+    }
+    else if (first < visibleEnd)
+    {
+        layerValid = false;
+        UIView::markDirty();
+    }
+
+    rowsMoved(first + count, -((int32_t) count));
+    heightIndex.remove(first, count);
+    invalidateLayout();
+
+    /* the last rows went, scrollPxForward moves up to fill the screen */
+    if (topRow >= tableSize)
+    {
+        topRow = (tableSize > 0) ? tableSize - 1 : 0;
+        topCellOverflow = 0;
+    }
+
+    /* the table may now end above the bottom of the screen */
+    scrollPxForward(0);
+}
+
+void UITableView::rowsUpdated(uint32_t first, uint32_t count)
+{
+    uint32_t tableSize = table->getSize();
+
+    if ((heightIndex.getSize() != tableSize) || (first + count > tableSize))
+    {
+        reloadTable();
+        return;
+    }
+
+    for (uint32_t row = first; row < first + count; row++)
+    {
+        uint32_t before = heightIndex.getHeight(row);
+        uint32_t after = table->heightAtIndex(row);
+
+        if (after != before)
+        {
+            heightIndex.setHeight(row, after);
+            invalidateLayout();
+
+            /* rows above the screen push the rows on it along */
+            if (row < topRow)
+            {
+                layerPosition = layerPosition + after - before;
+            }
+        }
+
+        cellCache.remove(row);
+    }
+
+    if ((first < visibleEnd) && (first + count > visibleFirst))
     {
-        uint32_t tableIndex = index % cacheSize;
+        layerValid = false;
+        UIView::markDirty();
+    }
+
+    scrollPxForward(0);
+}
+
+uint32_t UITableView::getFirstOverflow()
+{
+    return topCellOverflow;
+}
+
+uint32_t UITableView::getFirstIndex()
+{
+    return topRow;
+}
+
+uint32_t UITableView::getMiddleIndex()
+{
+    return getRowAtDistance(height / 2, NULL);
+}
+
+uint32_t UITableView::getLastIndex()
+{
+    return getRowAtDistance(height, NULL);
+}
+
+/*  Height of a single row, from the height index rather than the array.
+*/
+uint32_t UITableView::rowHeight(uint32_t index)
+{
+    return heightIndex.getHeight(index);
+}
+
+/*  First visible row reaching the given distance from the top of the table,
+    or the last row of the table. Bottom is set to the bottom edge of that row
+    relative to the top of the table.
+
+    Results are kept per distance in the layout slots and reused while the
+    row still covers the distance, so the middle and last rows asked for by
+    every frame are only looked up when a row boundary is crossed.
+*/
+uint32_t UITableView::getRowAtDistance(int32_t distance, int32_t* bottom)
+{
+    updateIndex();
+
+    uint32_t tableSize = table->getSize();
+    uint32_t position = getTopPosition() + topCellOverflow;
+    int32_t target = position + distance;
+
+    for (uint32_t slot = 0; slot < layoutCount; slot++)
+    {
+        if ((layoutDistance[slot] == distance)
+            && (layoutRow[slot] >= topRow)
+            && (target > (int32_t) layoutTop[slot])
+            && ((target <= (int32_t) layoutBottom[slot]) || (layoutRow[slot] + 1 == tableSize)))
+        {
+            if (bottom)
+            {
+                *bottom = layoutBottom[slot] - position;
+            }
+
+            return layoutRow[slot];
+        }
+    }
+
+    layoutPasses++;
+
+    uint32_t uniformHeight = heightIndex.getUniformHeight();
+    int32_t heightSum = rowHeight(topRow) - topCellOverflow;
+    uint32_t row = topRow;
 
-        lookUpTable[tableIndex] = index;
+    if (uniformHeight > 0)
+    {
+        /* closed form of the loop below */
+        if ((distance > heightSum) && (tableSize > 0))
+        {
+            uint32_t rows = (distance - heightSum + uniformHeight - 1) / uniformHeight;
+
+            if (rows > tableSize - 1 - topRow)
+            {
+                rows = tableSize - 1 - topRow;
+            }
+
+            row += rows;
+            heightSum += rows * uniformHeight;
+        }
+    }
+    else if ((distance > heightSum) && (tableSize > 0))
+    {
+        /* first row with its bottom edge at or below the distance */
+        row = heightIndex.findRow(position + distance - 1, NULL);
+        heightSum = heightIndex.getPosition(row + 1) - position;
+    }
+
+    /* replace the slot for this distance, or the oldest one */
+    uint32_t slot = 0;
+
+    while ((slot < layoutCount) && (layoutDistance[slot] != distance))
+    {
+        slot++;
+    }
+
+    if (slot == layoutCount)
+    {
+        if (layoutCount < LAYOUT_SLOTS)
+        {
+            layoutCount++;
+        }
+        else
+        {
+            slot = layoutNext;
+            layoutNext = (layoutNext + 1) % LAYOUT_SLOTS;
+        }
+    }
+
+    layoutDistance[slot] = distance;
+    layoutRow[slot] = row;
+    layoutBottom[slot] = position + heightSum;
+    layoutTop[slot] = layoutBottom[slot] - rowHeight(row);
+
+    if (bottom)
+    {
+        *bottom = heightSum;
+    }
+
+    return row;
+}
+
+/*  Fill background according to the inverse parameter, from top to bottom
+    in canvas coordinates, clipped to the canvas.
+*/
+void UITableView::fillBackground(SharedPointer<FrameBuffer>& canvas, int32_t top, int32_t bottom)
+{
+    int32_t canvasHeight = canvas->getHeight();
+    uint16_t right = (width < canvas->getWidth()) ? width : canvas->getWidth();
+
+    if (top < 0)
+    {
+        top = 0;
+    }
+
+    if (bottom > canvasHeight)
+    {
+        bottom = canvasHeight;
+    }
+
+    if (bottom > top)
+    {
+        canvas->drawRectangle(0, right, top, bottom, (inverse) ? 0 : 1);
+    }
+}
+
+/*  Opaque cells that span the whole row draw over the background anyway.
+*/
+bool UITableView::coversRow(SharedPointer<UIView>& cell, int32_t cellHeight) const
+{
+    return cell->isOpaque()
+        && (cell->getWidth() >= width)
+        && (cell->getHeight() >= cellHeight);
+}
+
+/*  UIView */
+uint32_t UITableView::fillFrameBuffer(SharedPointer<FrameBuffer>& canvas, int16_t xOffset, int16_t yOffset)
+{
+    /*  If canvas is NULL it means we are pre-fetching only and not actually blitting.
+        If the Width/Height is not set, use the whole canvas.
+    */
+    if (canvas.get() != NULL)
+    {
+        if (width == 0)
+        {
+            width = canvas->getWidth();
+        }
 
-        cache[tableIndex] = cell;
+        if (height == 0)
+        {
+            height = canvas->getHeight();
+        }
     }
-}
 
-void UITableView::prefetch(uint32_t index, minar::callback_handle_t* handle)
-{
-    SharedPointer<UIView> cell = getCellAtCacheIndex(index);
+    // update table view based on scrolling
+    updateIndex();
+    updateTable();
 
-    if ((cell == NULL) || (!cell->isValid()))
+    if (canvas.get() == NULL)
     {
-        UIF_PRINTF("UITableView: prefetch: %lu\r\n", index);
+        return renderRows(canvas, xOffset, yOffset);
+    }
 
-        // get cell at index
-        cell = table->viewAtIndex(index);
+    updateVisibleRange();
 
-        // propagate wakeup callback
-        cell->setWakeupCallback(wakeupCallback);
+    uint32_t callInterval;
 
-        // propagate color inversion
-        cell->setInverse(inverse);
+    /*  The retained rows can be reused for untranslated frames and for
+        bands of the table, as drawn by partial rendering.
+    */
+    if (blitScrolling && (xOffset == 0) && (yOffset <= 0) && (-yOffset < height))
+    {
+        callInterval = blitRows(canvas, -yOffset);
+    }
+    else
+    {
+        /* drawn somewhere else, the retained rows are out of date */
+        layerValid = false;
 
-        // prefetch cell content
-        cell->prefetch(0, 0);
+        renderedLines += (height < canvas->getHeight()) ? height : canvas->getHeight();
 
-        // insert cell in cache
-        insertCell(cell, index);
+        callInterval = renderRows(canvas, xOffset, yOffset);
     }
 
-    // reset handle
-    if (handle)
-    {
-        *handle = NULL;
-    }
-}
+    /* cells have rendered their buffers now, keep the cache within its budget */
+    cellCache.trim(visibleFirst, visibleEnd);
 
-void UITableView::scrollPx(int32_t pixels)
-{
-    outstandingScrollPx += pixels;
+    return callInterval;
 }
 
-void UITableView::updateTable()
+/*  Blit scrolling: the rows drawn in the last frame are kept in a layer and
+    moved by the distance scrolled since, so only the rows scrolled into view
+    and the cells that have changed are drawn. The layer is then copied to the
+    canvas, starting from line first of the table.
+*/
+uint32_t UITableView::blitRows(SharedPointer<FrameBuffer>& canvas, uint16_t first)
 {
-    if (outstandingScrollPx > 0)
-    {
-        scrollPxBackward(outstandingScrollPx);
-    }
-    else if (outstandingScrollPx < 0)
+    if ((layerBuffer == NULL)
+        || (layerBuffer->getWidth() != width)
+        || (layerBuffer->getHeight() != height))
     {
-        scrollPxForward(-outstandingScrollPx);
+        layerBuffer = new UIMemoryFrameBuffer(width, height);
+        layer = SharedPointer<FrameBuffer>(layerBuffer);
+        layerValid = false;
     }
 
-    outstandingScrollPx = 0;
-}
+    uint32_t position = getTopPosition() + topCellOverflow;
 
-// Update internal view
-// Updates variables topRow and topCellOverflow
-void UITableView::scrollPxForward(uint32_t pixels)
-{
-    uint32_t tableSize = table->getSize();
+    /* lines to draw, scrolled into view or out of date */
+    int32_t top = 0;
+    int32_t bottom = height;
 
-    if (tableSize > 1)
+    if (layerValid && !UIView::dirty && dirtyRect.isEmpty())
     {
-        uint32_t totalHeight = 0;
+        int32_t delta = position - layerPosition;
 
-        // find the last visible row and the new top row
-        bool searchForTop = true;
-        uint32_t newTopRow = topRow;
-        uint32_t newTopCellOverflow = 0;
-
-        uint32_t row = topRow;
-        for ( ; (row < tableSize) && (totalHeight < (height + topCellOverflow + pixels)); row++)
+        if ((delta > -((int32_t) height)) && (delta < (int32_t) height))
         {
-            uint32_t cellHeight = table->heightAtIndex(row);
+            layerBuffer->scroll(-delta);
 
-            totalHeight += cellHeight;
+            top = (delta > 0) ? height - delta : 0;
+            bottom = (delta > 0) ? height : -delta;
+        }
+    }
 
-            if (searchForTop)
-            {
-                if ((totalHeight - topCellOverflow) > pixels)
-                {
-                    searchForTop = false;
+    /*  Find the cells that changed outside the exposed lines before drawing,
+        as cells fetched for those lines start out changed.
+    */
+    int32_t changedTop = height;
+    int32_t changedBottom = 0;
 
-                    newTopRow = row;
-                    newTopCellOverflow = cellHeight - (totalHeight - topCellOverflow - pixels);
-                }
-            }
-        }
+    if ((top > 0) || (bottom < (int32_t) height))
+    {
+        uint32_t tableSize = table->getSize();
+        int32_t rowTop = -topCellOverflow;
 
-        // we reached the end of the array without filling the screen
-        if ( (row == tableSize) && (totalHeight < (height + topCellOverflow + pixels)) )
+        for (uint32_t row = topRow; (row < tableSize) && (rowTop < (int32_t) height); row++)
         {
-            // reverse search
-            uint32_t reverseRow = tableSize - 1;
-            uint32_t reverseHeight = 0;
-            for ( ; (reverseRow > 0) && (reverseHeight < height); reverseRow-- )
-            {
-                uint32_t cellHeight = table->heightAtIndex(reverseRow);
+            int32_t rowBottom = rowTop + rowHeight(row);
 
-                reverseHeight += cellHeight;
-            }
+            SharedPointer<UIView>& cell = cellCache.peek(row);
 
-            if (reverseHeight >= height)
-            {
-                topRow = reverseRow + 1;
-                topCellOverflow = reverseHeight - height;
-            }
-            // we reached the top without filling the screen
-            // i.e. there are not enough rows to fill it
-            else
+            if ((cell == NULL) || !cell->isValid() || cell->isDirty())
             {
-                topRow = 0;
-                topCellOverflow = 0;
+                changedTop = (rowTop < changedTop) ? rowTop : changedTop;
+                changedBottom = (rowBottom > changedBottom) ? rowBottom : changedBottom;
             }
-        }
-        // filled the screen
-        else // if (totalHeight >= (visibleScreen + topCellOverflow + pixels))
-        {
-            topRow = newTopRow;
-            topCellOverflow = newTopCellOverflow;
-        }
-    }
-}
 
-void UITableView::scrollPxBackward(uint32_t pixels)
-{
-    /*  The scroll amount is smaller than the topRow overflow.
-        Top row is unchanged.
-    */
-    if (topCellOverflow > pixels)
-    {
-        topCellOverflow -= pixels;
+            rowTop = rowBottom;
+        }
     }
-    else
-    {
-        /*  Find new top row and offset by traversing array in reverse.
-            topCellOverflow is the height of topRow, so start with topRow - 1.
-         */
-        int32_t reverseRow = topRow - 1;
-        uint32_t totalHeight = 0;
 
-        for ( ; (reverseRow >= 0) && ((totalHeight + topCellOverflow) < pixels); reverseRow--)
-        {
-            uint32_t cellHeight = table->heightAtIndex(reverseRow);
+    uint32_t callInterval = renderBand(top, bottom);
 
-            totalHeight += cellHeight;
-        }
+    if (changedTop < changedBottom)
+    {
+        uint32_t interval = renderBand(changedTop, changedBottom);
 
-        if ((totalHeight + topCellOverflow) >= pixels)
-        {
-            topRow = reverseRow + 1;
-            topCellOverflow = totalHeight + topCellOverflow - pixels;
-        }
-        else
-        {
-            topRow = 0;
-            topCellOverflow = 0;
-        }
+        callInterval = (interval < callInterval) ? interval : callInterval;
     }
-}
 
-void UITableView::setPixels(int32_t pixels)
-{
-    topRow = 0;
-    topCellOverflow = 0;
-    outstandingScrollPx = 0;
-
-    if (pixels > 0)
+    /* rows that were not drawn keep the interval they asked for last time */
+    if ((top == 0) && (bottom == (int32_t) height))
     {
-        scrollPxBackward(pixels);
+        layerInterval = callInterval;
     }
     else
     {
-        scrollPxForward(-pixels);
+        callInterval = (layerInterval < callInterval) ? layerInterval : callInterval;
     }
-}
-
-int32_t UITableView::getPixels()
-{
-    uint32_t heightSum = 0;
 
-    for (uint32_t row = 0; row < topRow; row++)
-    {
-        heightSum += table->heightAtIndex(row);
-    }
+    layerPosition = position;
+    layerValid = true;
 
-    return -(heightSum + topCellOverflow);
-}
+    /* copy the layer to the canvas */
+    struct CompBuf image;
 
-void UITableView::setCenter(uint32_t index)
-{
-    uint32_t tableSize = table->getSize();
+    uint16_t lines = height - first;
 
-    if (index < tableSize)
+    if (lines > canvas->getHeight())
     {
-        uint32_t heightSum = 0;
-
-        for (uint32_t row = 0; row < index; row++)
-        {
-            heightSum += table->heightAtIndex(row);
-        }
-
-        heightSum += table->heightAtIndex(index) / 2;
-
-        setPixels(-(heightSum - (height / 2)));
+        lines = canvas->getHeight();
     }
-}
 
-uint32_t UITableView::getFirstOverflow()
-{
-    return topCellOverflow;
-}
+    image.buf = layerBuffer->getData() + (first * layerBuffer->getStride());
+    image.mask = (uint8_t*) Comp_Fill_Ones;
+    image.bit_offset = 0;
+    image.stride_bytes = layerBuffer->getStride();
+    image.width_bits = width;
+    image.height_strides = lines;
 
-uint32_t UITableView::getFirstIndex()
-{
-    return topRow;
+    canvas->drawImage(image, 0, 0, 0);
+
+    return callInterval;
 }
 
-uint32_t UITableView::getMiddleIndex()
+/*  Draw the lines [top, bottom) of the table into the layer.
+*/
+uint32_t UITableView::renderBand(int32_t top, int32_t bottom)
 {
-    uint32_t tableSize = table->getSize();
-    uint32_t heightSum = table->heightAtIndex(topRow) - topCellOverflow;
-
-    uint32_t row = topRow + 1;
+    top = (top > 0) ? top : 0;
+    bottom = (bottom < (int32_t) height) ? bottom : height;
 
-    for (; (row < tableSize) && (heightSum < (height / 2)); row++)
+    if (top >= bottom)
     {
-        heightSum += table->heightAtIndex(row);
+        return UINT32_MAX;
     }
 
-    return row - 1;
-}
+    layerWindow->setWindow(layerBuffer, 0, top, width, bottom - top);
 
-uint32_t UITableView::getLastIndex()
-{
-  uint32_t tableSize = table->getSize();
-  uint32_t heightSum = table->heightAtIndex(topRow) - topCellOverflow;
+    uint32_t callInterval = renderRows(layerCanvas, 0, -top);
 
-  uint32_t row = topRow + 1;
+    layerWindow->clearWindow();
 
-  for (; (row < tableSize) && (heightSum < height); row++)
-  {
-      heightSum += table->heightAtIndex(row);
-  }
+    renderedLines += bottom - top;
 
-  return row - 1;
+    return callInterval;
 }
 
-/*  UIView */
-uint32_t UITableView::fillFrameBuffer(SharedPointer<FrameBuffer>& canvas, int16_t xOffset, int16_t yOffset)
+/*  Draw the visible rows. A negative yOffset draws the part of the table
+    that far down from its top.
+*/
+uint32_t UITableView::renderRows(SharedPointer<FrameBuffer>& canvas, int16_t xOffset, int16_t yOffset)
 {
     int32_t heightSum = 0;
     int32_t maxHeight = height;
     uint32_t tableSize = table->getSize();
 
-    uint32_t callInterval = ULONG_MAX;
-    SharedPointer<FrameBuffer> subCanvas;
+    uint32_t callInterval = UINT32_MAX;
 
     SharedPointer<UIView> cell;
 
-    /*  If canvas is NULL it means we are pre-fetching only and not actually blitting.
-        If the Width/Height is not set, use the whole canvas.
-    */
     if (canvas.get() != NULL)
     {
-        if (width == 0)
-        {
-            width = canvas->getWidth();
-        }
-
-        if (height == 0)
-        {
-            height = canvas->getHeight();
-        }
-
         maxHeight = canvas->getHeight();
-
-        // fill background according to the inverse parameter
-        if (inverse)
-        {
-            canvas->drawRectangle(0, width, 0, height, 0);
-        }
-        else
-        {
-            canvas->drawRectangle(0, width, 0, height, 1);
-        }
     }
 
-    // update table view based on scrolling
-    updateTable();
+    /* last visible row, cells missing up to it are fetched together */
+    uint32_t lastRow = getLastIndex();
 
     /*  Special case the top row. Necessary to do proper over-the-top drawing.
         Get cell from the cache if it exists and is still valid.
         Otherwise get it from the table-object and put it in the cache.
     */
-    cell = getCellAtCacheIndex(topRow);
-
-    if ((cell == NULL) || (!cell->isValid()))
-    {
-        UIF_PRINTF("UITableView: miss: %lu\r\n", topRow);
-
-        // get cell at index
-        cell = table->viewAtIndex(topRow);
-
-        // propagate wakeup callback
-        cell->setWakeupCallback(wakeupCallback);
-
-        // propagate color inversion
-        cell->setInverse(inverse);
-
-        // insert cell in cache
-        insertCell(cell, topRow);
-
-        UIF_PRINTF("UITableView: cell: %p\r\n", cell.get());
-    }
+    cell = getCell(topRow, lastRow);
 
 
     /*  cellHeight is the height of the actual cell, according to the table-object.
@@ -412,7 +1118,7 @@ uint32_t UITableView::fillFrameBuffer(SharedPointer<FrameBuffer>& canvas, int16_
         The top row can overflow when the table is scrolled, the number of pixels
         running over the top is stored in topCellOverflow.
     */
-    int32_t cellHeight = table->heightAtIndex(topRow);
+    int32_t cellHeight = rowHeight(topRow);
     int32_t yBase = (yOffset < 0) ? yOffset : 0;
     heightSum = yBase + cellHeight - topCellOverflow;
 
@@ -431,22 +1137,29 @@ uint32_t UITableView::fillFrameBuffer(SharedPointer<FrameBuffer>& canvas, int16_
                 cell->setHeight(cellHeight);
             }
 
-            /*  Create a sub partition for each cell in the table to specify the area each
-                cell is allowed to modify.
+            // fill background unless the cell covers it
+            if (!coversRow(cell, cellHeight))
+            {
+                fillBackground(canvas, 0, heightSum);
+            }
+
+            /*  Move the cell window over the area each cell is allowed to modify.
+                The window is reused for every cell so drawing does not allocate.
             */
-            subCanvas = canvas->getFrameBuffer(0, 0, width, heightSum);
+            cellWindow->setWindow(canvas.get(), 0, 0, width, heightSum);
 
-            /*  If the top cell doesn't fit the canvas, draw the bottom part of the cell by adjustsing
+            /*  If the top cell doesn't fit the table, draw the bottom part of the cell by adjustsing
                 the yOffset parameter. Otherwise use the difference in heightSum and cellHeight as yOffset.
-                Note the canvas coordinate system is opposite the table's.
+                Note the canvas coordinate system is opposite the table's. The table height rather
+                than the canvas height decides, so bands drawn with a negative yOffset match.
             */
-            if (heightSum > canvas->getHeight())
+            if (heightSum - yBase > (int32_t) height)
             {
-                callInterval = cell->fillFrameBuffer(subCanvas, xOffset, (canvas->getHeight() - heightSum));
+                callInterval = cell->fillFrameBuffer(cellCanvas, xOffset, (yBase + height - (heightSum - yBase)));
             }
             else
             {
-                callInterval = cell->fillFrameBuffer(subCanvas, xOffset, (heightSum - cellHeight));
+                callInterval = cell->fillFrameBuffer(cellCanvas, xOffset, (heightSum - cellHeight));
             }
         }
         else
@@ -460,28 +1173,9 @@ uint32_t UITableView::fillFrameBuffer(SharedPointer<FrameBuffer>& canvas, int16_
 
     for (; (row < tableSize) && (heightSum < maxHeight); row++)
     {
-        cell = getCellAtCacheIndex(row);
-
-        if ((cell == NULL) || (!cell->isValid()))
-        {
-            UIF_PRINTF("UITableView: miss: %lu\r\n", row);
+        cell = getCell(row, lastRow);
 
-            // get cell at index
-            cell = table->viewAtIndex(row);
-
-            // propagate wakeup callback
-            cell->setWakeupCallback(wakeupCallback);
-
-            // propagate color inversion
-            cell->setInverse(inverse);
-
-            // insert cell in cache
-            insertCell(cell, row);
-
-            UIF_PRINTF("UITableView: cell: %p\r\n", cell.get());
-        }
-
-        cellHeight = table->heightAtIndex(row);
+        cellHeight = rowHeight(row);
 
         int32_t tempHeight = heightSum + cellHeight;
 
@@ -500,17 +1194,22 @@ uint32_t UITableView::fillFrameBuffer(SharedPointer<FrameBuffer>& canvas, int16_
                     cell->setHeight(cellHeight);
                 }
 
-                subCanvas = canvas->getFrameBuffer(0, heightSum, width, cellHeight);
+                if (!coversRow(cell, cellHeight))
+                {
+                    fillBackground(canvas, heightSum, tempHeight);
+                }
+
+                cellWindow->setWindow(canvas.get(), 0, heightSum, width, cellHeight);
 
                 if (tempHeight < cellHeight)
                 {
-                    uint32_t interval = cell->fillFrameBuffer(subCanvas, xOffset, (tempHeight - cellHeight));
+                    uint32_t interval = cell->fillFrameBuffer(cellCanvas, xOffset, (tempHeight - cellHeight));
 
                     callInterval = (callInterval < interval) ? callInterval : interval;
                 }
                 else
                 {
-                    uint32_t interval = cell->fillFrameBuffer(subCanvas, xOffset, 0);
+                    uint32_t interval = cell->fillFrameBuffer(cellCanvas, xOffset, 0);
 
                     callInterval = (callInterval < interval) ? callInterval : interval;
                 }
@@ -524,25 +1223,28 @@ uint32_t UITableView::fillFrameBuffer(SharedPointer<FrameBuffer>& canvas, int16_
         heightSum += cellHeight;
     }
 
-    /* schedule offscreen cells to be pre-cached */
-    /* cache the cell before the ones already shown if it is not already in cache */
-    if (topRow > 0)
+    /* fill background below the last row */
+    if (canvas.get() != NULL)
     {
-        FunctionPointer2<void, uint32_t, minar::callback_handle_t*> fetchRow(this, &UITableView::prefetch);
+        int32_t tableBottom = yBase + height;
 
-        cacheTopCallbackHandle = minar::Scheduler::postCallback(fetchRow.bind(topRow, &cacheTopCallbackHandle))
-                                    .getHandle();
+        fillBackground(canvas, heightSum, (tableBottom < maxHeight) ? tableBottom : maxHeight);
     }
 
-    /* cache the cell after the ones already shown if it is not already in cache */
-    if (row < tableSize)
+    /* rows fetched beyond the ones drawn are not kept */
+    for (uint32_t index = 0; index < batchCount; index++)
     {
-        FunctionPointer2<void, uint32_t, minar::callback_handle_t*> fetchRow(this, &UITableView::prefetch);
-
-        cacheBottomCallbackHandle = minar::Scheduler::postCallback(fetchRow.bind(row, &cacheBottomCallbackHandle))
-                                        .getHandle();
+        batch[index] = SharedPointer<UIView>();
     }
 
+    batchCount = 0;
+
+    /* the window must not outlive the canvas it points into */
+    cellWindow->clearWindow();
+
+    /* schedule offscreen cells to be pre-cached */
+    updatePrefetchWindow(row);
+
     return callInterval;
 }
 
@@ -553,6 +1255,149 @@ void UITableView::prefetch(int16_t xOffset, int16_t yOffset)
     fillFrameBuffer(null, xOffset, yOffset);
 }
 
+/*  The table has changed when it has been scrolled or when one of the
+    visible cells has changed, been invalidated or is not in the cache yet.
+*/
+bool UITableView::isDirty()
+{
+    if (UIView::isDirty() || (outstandingScrollPx != 0))
+    {
+        return true;
+    }
+
+    updateIndex();
+
+    uint32_t tableSize = table->getSize();
+    int32_t heightSum = -topCellOverflow;
+
+    for (uint32_t row = topRow; (row < tableSize) && (heightSum < height); row++)
+    {
+        SharedPointer<UIView>& cell = cellCache.peek(row);
+
+        if ((cell == NULL) || (!cell->isValid()) || cell->isDirty())
+        {
+            return true;
+        }
+
+        heightSum += rowHeight(row);
+    }
+
+    return false;
+}
+
+UIView::Rect UITableView::getDirtyRect()
+{
+    if (UIView::dirty || (outstandingScrollPx != 0))
+    {
+        return getBounds();
+    }
+
+    UIView::Rect bounds = getBounds();
+    UIView::Rect region = dirtyRect;
+
+    updateIndex();
+
+    uint32_t tableSize = table->getSize();
+    int32_t rowTop = -topCellOverflow;
+
+    for (uint32_t row = topRow; (row < tableSize) && (rowTop < height); row++)
+    {
+        int32_t cellHeight = rowHeight(row);
+
+        SharedPointer<UIView>& cell = cellCache.peek(row);
+
+        if ((cell == NULL) || (!cell->isValid()))
+        {
+            region.unite(UIView::Rect(0, rowTop, bounds.x1, rowTop + cellHeight));
+        }
+        else
+        {
+            UIView::Rect cellRect = cell->getDirtyRect();
+
+            cellRect.intersect(UIView::Rect(0, 0, bounds.x1, cellHeight));
+            cellRect.translate(0, rowTop);
+
+            region.unite(cellRect);
+        }
+
+        rowTop += cellHeight;
+    }
+
+    region.intersect(bounds);
+
+    return region;
+}
+
+void UITableView::clearDirty()
+{
+    UIView::clearDirty();
+
+    for (uint32_t slot = 0; slot < cellCache.getSize(); slot++)
+    {
+        SharedPointer<UIView>& cell = cellCache.getSlot(slot);
+
+        if (cell != NULL)
+        {
+            cell->clearDirty();
+        }
+    }
+}
+
+/*  Put all cached cells to sleep and stop prefetching while the table is
+    out of view. The next frame resumes the cells it shows.
+*/
+void UITableView::suspend()
+{
+    if (prefetchCallbackHandle)
+    {
+        minar::Scheduler::cancelCallback(prefetchCallbackHandle);
+        prefetchCallbackHandle = NULL;
+    }
+
+    prefetchQueue.clear();
+
+    for (uint32_t slot = 0; slot < cellCache.getSize(); slot++)
+    {
+        SharedPointer<UIView>& cell = cellCache.getSlot(slot);
+
+        if (cell != NULL)
+        {
+            cell->suspend();
+        }
+    }
+
+    visibleFirst = 0;
+    visibleEnd = 0;
+
+    /* the retained rows are redrawn when the table is shown again */
+    layer = SharedPointer<FrameBuffer>();
+    layerBuffer = NULL;
+    layerValid = false;
+
+    /*  Give what the suspended cells released back to the budget, and make
+        room for the tables in view if it is still exceeded.
+    */
+    cellCache.refresh();
+    cellCache.trim(0, 0);
+}
+
+void UITableView::setCacheBudget(SharedPointer<UICacheBudget>& budget)
+{
+    cellCache.setBudget(budget);
+}
+
+uint32_t UITableView::getRetainedBytes() const
+{
+    uint32_t bytes = sizeof(UITableView) + cellCache.getRetainedBytes();
+
+    if (layerBuffer != NULL)
+    {
+        bytes += layerBuffer->getStride() * layerBuffer->getHeight();
+    }
+
+    return bytes;
+}
+
 void UITableView::setWakeupCallback(FunctionPointer& callback)
 {
     UIF_PRINTF("UITableView: set wakeup %p\r\n", callback.get_function());
@@ -560,11 +1405,13 @@ void UITableView::setWakeupCallback(FunctionPointer& callback)
     /* store reference for new objects pushed on the stack. */
     wakeupCallback = callback;
 
-    for (uint32_t idx = 0; idx < cacheSize; idx++)
+    for (uint32_t slot = 0; slot < cellCache.getSize(); slot++)
     {
-        if (cache[idx] != NULL)
+        SharedPointer<UIView>& cell = cellCache.getSlot(slot);
+
+        if (cell != NULL)
         {
-            cache[idx]->setWakeupCallback(wakeupCallback);
+            cell->setWakeupCallback(wakeupCallback);
         }
     }
 }
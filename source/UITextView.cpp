@@ -17,6 +17,7 @@
 #include "UIFramework/UITextView.h"
 
 #include <cstdlib>
+#include <cstring>
 
 UITextView::UITextView(const char* _text, const struct FontData* _font)
     :   UIView(),
@@ -24,6 +25,8 @@ UITextView::UITextView(const char* _text, const struct FontData* _font)
         font(_font),
         textString(),
         mallocBuffer(NULL),
+        mallocSize(0),
+        rendered(false),
         cacheImage(NULL)
 {
     // call helper function to initialise object
@@ -35,6 +38,8 @@ UITextView::UITextView(std::string& _string, const struct FontData* _font)
         font(_font),
         textString(_string),
         mallocBuffer(NULL),
+        mallocSize(0),
+        rendered(false),
         cacheImage(NULL)
 {
     // get pointer to locally cached string
@@ -69,11 +74,30 @@ void UITextView::constructor()
     }
     else
     {
+        // keep the font for later text
         text = NULL;
-        font = NULL;
     }
 }
 
+void UITextView::setText(const char* _text)
+{
+    text = _text;
+
+    constructor();
+
+    // render again on next use, into the same bitmap if it fits
+    rendered = false;
+
+    UIView::markDirty();
+}
+
+void UITextView::setText(std::string& _string)
+{
+    textString = _string;
+
+    setText(textString.c_str());
+}
+
 UITextView::~UITextView()
 {
     free(mallocBuffer);
@@ -85,7 +109,7 @@ uint32_t UITextView::fillFrameBuffer(SharedPointer<FrameBuffer>& canvas, int16_t
     prefetch(0, 0);
 
     /* Copy text to canvas */
-    if (cacheImage != NULL)
+    if (rendered && (cacheImage != NULL))
     {
         cacheImage->setInverse(inverse);
         cacheImage->setHorizontalAlignment(align);
@@ -96,7 +120,7 @@ uint32_t UITextView::fillFrameBuffer(SharedPointer<FrameBuffer>& canvas, int16_t
         cacheImage->fillFrameBuffer(canvas, xOffset, yOffset);
     }
 
-    return ULONG_MAX;
+    return UINT32_MAX;
 }
 
 void UITextView::prefetch(int16_t xOffset, int16_t yOffset)
@@ -104,11 +128,21 @@ void UITextView::prefetch(int16_t xOffset, int16_t yOffset)
     (void) xOffset;
     (void) yOffset;
 
-    if ((mallocBuffer == NULL) && (text != NULL))
+    if (!rendered && (text != NULL))
     {
         uint32_t numBytes = cacheBuffer.stride_bytes * cacheBuffer.height_strides;
 
-        mallocBuffer = (uint8_t*) calloc(numBytes, sizeof(uint8_t));
+        if ((mallocBuffer == NULL) || (numBytes > mallocSize))
+        {
+            free(mallocBuffer);
+
+            mallocBuffer = (uint8_t*) calloc(numBytes, sizeof(uint8_t));
+            mallocSize = (mallocBuffer != NULL) ? numBytes : 0;
+        }
+        else
+        {
+            memset(mallocBuffer, 0, numBytes);
+        }
 
         if (mallocBuffer != NULL)
         {
@@ -119,7 +153,55 @@ void UITextView::prefetch(int16_t xOffset, int16_t yOffset)
             cacheBuffer.mask = cacheBuffer.buf;
             cacheBuffer.buf = (uint8_t*)Comp_Fill_Zeros;
 
-            cacheImage = new UIImageView(&cacheBuffer);
+            if (cacheImage == NULL)
+            {
+                cacheImage = new UIImageView(&cacheBuffer);
+            }
+            else
+            {
+                cacheImage->setImage(&cacheBuffer);
+            }
+
+            rendered = true;
         }
     }
 }
+
+/*  Free the bitmap while out of view, it is rendered again when the view is
+    drawn or prefetched next.
+*/
+void UITextView::suspend()
+{
+    free(mallocBuffer);
+
+    mallocBuffer = NULL;
+    mallocSize = 0;
+    rendered = false;
+}
+
+uint32_t UITextView::getRetainedBytes() const
+{
+    uint32_t bytes = sizeof(UITextView) + textString.capacity() + mallocSize;
+
+    if (cacheImage != NULL)
+    {
+        bytes += cacheImage->getRetainedBytes();
+    }
+
+    return bytes;
+}
+
+bool UITextView::isDirty()
+{
+    return UIView::isDirty() || ((cacheImage != NULL) && cacheImage->isDirty());
+}
+
+void UITextView::clearDirty()
+{
+    UIView::clearDirty();
+
+    if (cacheImage != NULL)
+    {
+        cacheImage->clearDirty();
+    }
+}
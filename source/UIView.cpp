@@ -15,8 +15,7 @@
  */
 
 #include "UIFramework/UIView.h"
-
-#include <sys/time.h>
+#include "UIFramework/UIClock.h"
 
 
 UIView::UIView()
@@ -25,8 +24,11 @@ UIView::UIView()
         width(0),
         height(0),
         inverse(false),
+        opaque(false),
         cacheable(true),
-        valid(true)
+        valid(true),
+        reuseType(0),
+        dirty(true)
 {
 }
 
@@ -36,18 +38,17 @@ UIView::UIView(align_t _hAlign, valign_t _vAlign, uint16_t _width, uint16_t _hei
         width(_width),
         height(_height),
         inverse(_inverse),
+        opaque(false),
         cacheable(true),
-        valid(true)
+        valid(true),
+        reuseType(0),
+        dirty(true)
 {
 }
 
 uint32_t UIView::getTimeInMilliseconds() const
 {
-    struct timeval tvs;
-
-    gettimeofday(&tvs, NULL);
-
-    return (tvs.tv_sec * 1000) + (tvs.tv_usec / 1000);
+    return UIClock::getTimeInMilliseconds();
 }
 
 void UIView::setWakeupCallback(FunctionPointer& wakeup)
@@ -83,27 +84,57 @@ bool UIView::getInverse() const
 
 void UIView::setHorizontalAlignment(align_t _align)
 {
-    align = _align;
+    if (align != _align)
+    {
+        align = _align;
+        dirty = true;
+    }
 }
 
 void UIView::setVerticalAlignment(valign_t _valign)
 {
-    valign = _valign;
+    if (valign != _valign)
+    {
+        valign = _valign;
+        dirty = true;
+    }
 }
 
 void UIView::setWidth(uint16_t _width)
 {
-    width = _width;
+    if (width != _width)
+    {
+        width = _width;
+        dirty = true;
+    }
 }
 
 void UIView::setHeight(uint16_t _height)
 {
-    height = _height;
+    if (height != _height)
+    {
+        height = _height;
+        dirty = true;
+    }
 }
 
 void UIView::setInverse(bool _inverse)
 {
-    inverse = _inverse;
+    if (inverse != _inverse)
+    {
+        inverse = _inverse;
+        dirty = true;
+    }
+}
+
+void UIView::setOpaque(bool _opaque)
+{
+    opaque = _opaque;
+}
+
+bool UIView::isOpaque() const
+{
+    return opaque;
 }
 
 /* Cache control
@@ -116,6 +147,7 @@ void UIView::setCacheable(bool _cacheable)
 void UIView::invalidate()
 {
     valid = false;
+    dirty = true;
 }
 
 bool UIView::isCacheable() const
@@ -128,6 +160,80 @@ bool UIView::isValid() const
     return valid;
 }
 
+void UIView::setReuseType(uint32_t type)
+{
+    reuseType = type;
+}
+
+uint32_t UIView::getReuseType() const
+{
+    return reuseType;
+}
+
+void UIView::prepareForReuse()
+{
+    valid = true;
+    dirty = true;
+    dirtyRect = Rect();
+}
+
+uint32_t UIView::getRetainedBytes() const
+{
+    return sizeof(UIView);
+}
+
+void UIView::setCacheBudget(SharedPointer<UICacheBudget>& budget)
+{
+    (void) budget;
+}
+
+/* Change tracking
+*/
+void UIView::markDirty()
+{
+    dirty = true;
+}
+
+void UIView::invalidate(const Rect& rect)
+{
+    dirtyRect.unite(rect);
+}
+
+bool UIView::isDirty()
+{
+    return dirty || !dirtyRect.isEmpty();
+}
+
+UIView::Rect UIView::getDirtyRect()
+{
+    if (!isDirty())
+    {
+        return Rect();
+    }
+
+    /* changed without a specific area */
+    if (dirty || dirtyRect.isEmpty())
+    {
+        return getBounds();
+    }
+
+    return dirtyRect;
+}
+
+void UIView::clearDirty()
+{
+    dirty = false;
+    dirtyRect = Rect();
+}
+
+UIView::Rect UIView::getBounds() const
+{
+    return Rect(0,
+                0,
+                (width) ? width : SHRT_MAX,
+                (height) ? height : SHRT_MAX);
+}
+
 SharedPointer<UIView::Action> UIView::getAction()
 {
     UIView::Action retval;
@@ -138,6 +244,212 @@ SharedPointer<UIView::Action> UIView::getAction()
 
 
 
+UIView::Rect::Rect()
+    :   x0(0),
+        y0(0),
+        x1(0),
+        y1(0)
+{}
+
+UIView::Rect::Rect(int16_t _x0, int16_t _y0, int16_t _x1, int16_t _y1)
+    :   x0(_x0),
+        y0(_y0),
+        x1(_x1),
+        y1(_y1)
+{}
+
+bool UIView::Rect::isEmpty() const
+{
+    return (x0 >= x1) || (y0 >= y1);
+}
+
+void UIView::Rect::unite(const Rect& other)
+{
+    if (other.isEmpty())
+    {
+        return;
+    }
+
+    if (isEmpty())
+    {
+        *this = other;
+        return;
+    }
+
+    x0 = (other.x0 < x0) ? other.x0 : x0;
+    y0 = (other.y0 < y0) ? other.y0 : y0;
+    x1 = (other.x1 > x1) ? other.x1 : x1;
+    y1 = (other.y1 > y1) ? other.y1 : y1;
+}
+
+void UIView::Rect::intersect(const Rect& other)
+{
+    x0 = (other.x0 > x0) ? other.x0 : x0;
+    y0 = (other.y0 > y0) ? other.y0 : y0;
+    x1 = (other.x1 < x1) ? other.x1 : x1;
+    y1 = (other.y1 < y1) ? other.y1 : y1;
+
+    if (isEmpty())
+    {
+        *this = Rect();
+    }
+}
+
+/*  Saturate instead of wrapping, unbounded rectangles stay unbounded.
+*/
+static int16_t saturate(int32_t value)
+{
+    if (value > SHRT_MAX)
+    {
+        return SHRT_MAX;
+    }
+    else if (value < SHRT_MIN)
+    {
+        return SHRT_MIN;
+    }
+
+    return value;
+}
+
+void UIView::Rect::translate(int16_t x, int16_t y)
+{
+    if (!isEmpty())
+    {
+        x0 = saturate(x0 + x);
+        y0 = saturate(y0 + y);
+        x1 = saturate(x1 + x);
+        y1 = saturate(y1 + y);
+    }
+}
+
+void UIView::Array::viewsInRange(uint32_t first, uint32_t last, SharedPointer<UIView>* views, UICellPool& pool) const
+{
+    for (uint32_t index = first; index < last; index++)
+    {
+        views[index - first] = viewAtIndex(index, pool);
+    }
+}
+
+void UIView::Array::heightsInRange(uint32_t first, uint32_t last, uint32_t* heights) const
+{
+    for (uint32_t index = first; index < last; index++)
+    {
+        heights[index - first] = heightAtIndex(index);
+    }
+}
+
+void UIView::Array::widthsInRange(uint32_t first, uint32_t last, uint32_t* widths) const
+{
+    for (uint32_t index = first; index < last; index++)
+    {
+        widths[index - first] = widthAtIndex(index);
+    }
+}
+
+UIView::Array::Listener::~Listener()
+{
+    if (listenedArray != NULL)
+    {
+        listenedArray->removeListener(this);
+    }
+}
+
+UIView::Array::~Array()
+{
+    while (listeners != NULL)
+    {
+        Listener* listener = listeners;
+        listeners = listener->nextListener;
+
+        listener->listenedArray = NULL;
+        listener->nextListener = NULL;
+    }
+}
+
+void UIView::Array::addListener(Listener* listener)
+{
+    MBED_ASSERT(listener != NULL);
+
+    /* linking into a second list would cut the first one */
+    MBED_ASSERT((listener->listenedArray == NULL) || (listener->listenedArray == this));
+
+    if (listener->listenedArray == NULL)
+    {
+        MBED_ASSERT(listener->nextListener == NULL);
+
+        listener->listenedArray = this;
+        listener->nextListener = listeners;
+        listeners = listener;
+    }
+}
+
+void UIView::Array::removeListener(Listener* listener)
+{
+    if ((listener == NULL) || (listener->listenedArray != this))
+    {
+        return;
+    }
+
+    for (Listener** link = &listeners; *link != NULL; link = &(*link)->nextListener)
+    {
+        if (*link == listener)
+        {
+            *link = listener->nextListener;
+            break;
+        }
+    }
+
+    listener->listenedArray = NULL;
+    listener->nextListener = NULL;
+}
+
+bool UIView::Array::hasListener(const Listener* listener) const
+{
+    return (listener != NULL) && (listener->listenedArray == this);
+}
+
+/*  The next listener is read before calling each one, so a listener may
+    remove itself while being told.
+*/
+void UIView::Array::notifyInserted(uint32_t first, uint32_t count)
+{
+    Listener* next = (count > 0) ? listeners : NULL;
+
+    while (next != NULL)
+    {
+        Listener* current = next;
+        next = current->nextListener;
+
+        current->rowsInserted(first, count);
+    }
+}
+
+void UIView::Array::notifyDeleted(uint32_t first, uint32_t count)
+{
+    Listener* next = (count > 0) ? listeners : NULL;
+
+    while (next != NULL)
+    {
+        Listener* current = next;
+        next = current->nextListener;
+
+        current->rowsDeleted(first, count);
+    }
+}
+
+void UIView::Array::notifyUpdated(uint32_t first, uint32_t count)
+{
+    Listener* next = (count > 0) ? listeners : NULL;
+
+    while (next != NULL)
+    {
+        Listener* current = next;
+        next = current->nextListener;
+
+        current->rowsUpdated(first, count);
+    }
+}
+
 UIView::Action::Action(type_t _type)
     :   type(_type)
 {}
@@ -15,6 +15,7 @@
  */
 
 #include "UIFramework/UIViewStack.h"
+#include "UIFramework/UIClock.h"
 
 
 #if 0
@@ -31,7 +32,9 @@ UIViewStack::UIViewStack()
         scrollRightToLeft(false),
         scrollOffset(0),
         scrollStartTime(0),
-        stack()
+        stack(),
+        transitionWindow(new UISubCanvas()),
+        transitionCanvas(transitionWindow)
 {
     UAllocTraits_t traits = {0};
 
@@ -47,6 +50,12 @@ void UIViewStack::pushView(SharedPointer<UIView>& view)
     /* add callback for wakeups. */
     view->setWakeupCallback(wakeupCallback);
 
+    /* share the cache budget, if any */
+    if (cacheBudget != NULL)
+    {
+        view->setCacheBudget(cacheBudget);
+    }
+
     /*  Put UIView at the end of array.
         Cycle mainCell to leftCell, new view to rightCell.
         If leftCell is not nil, start scrolling rightToLeft.
@@ -63,12 +72,14 @@ void UIViewStack::pushView(SharedPointer<UIView>& view)
     {
         scrollRightToLeft = true;
         scrollLeftToRight = false;
-        scrollStartTime = UIView::getTimeInMilliseconds();
+        scrollStartTime = UIClock::getTime();
 
         leftCell->suspend();
     }
 
     rightCell->resume();
+
+    UIView::markDirty();
 }
 
 SharedPointer<UIView>& UIViewStack::popView()
@@ -94,7 +105,9 @@ SharedPointer<UIView>& UIViewStack::popView()
 
         scrollLeftToRight = true;
         scrollRightToLeft = false;
-        scrollStartTime = UIView::getTimeInMilliseconds();
+        scrollStartTime = UIClock::getTime();
+
+        UIView::markDirty();
     }
 
     return mainCell;
@@ -127,12 +140,30 @@ SharedPointer<UIView>& UIViewStack::resetView()
 
         scrollLeftToRight = true;
         scrollRightToLeft = false;
-        scrollStartTime = UIView::getTimeInMilliseconds();
+        scrollStartTime = UIClock::getTime();
+
+        UIView::markDirty();
     }
 
     return mainCell;
 }
 
+/*  Transition offset in pixels based on the time elapsed since the transition
+    was initiated, saturated at the full width.
+*/
+uint32_t UIViewStack::getScrollOffset() const
+{
+    uint32_t progress = UIClock::elapsed(scrollStartTime);
+    uint32_t duration = transitionTimeInMilliSeconds * 1000;
+
+    if (progress >= duration)
+    {
+        return UIView::width;
+    }
+
+    return ((uint64_t) UIView::width * progress) / duration;
+}
+
 uint32_t UIViewStack::getSize()
 {
     return stack.get_num_elements();
@@ -158,75 +189,76 @@ uint32_t UIViewStack::fillFrameBuffer(SharedPointer<FrameBuffer>& canvas,
                                       int16_t xOffset,
                                       int16_t yOffset)
 {
-#warning xOffset and yOffset transpose in UIViewStack not implemented
-    /*  FIXME: [UIViewStack fillCompBuf] does not use xOffset and yOffset to transpose itself. */
-    (void) xOffset;
-    (void) yOffset;
-
-    uint32_t callInterval = ULONG_MAX;
-
-    SharedPointer<FrameBuffer> left_canvas;
-    SharedPointer<FrameBuffer> right_canvas;
+    uint32_t callInterval = UINT32_MAX;
 
     if (scrollRightToLeft)
     {
         /*  Calculate scrolling offset based on transitionTime and elapsed time since scrolling was initiated.
         */
-        uint32_t now = UIView::getTimeInMilliseconds();
-        uint32_t progress = now - scrollStartTime;
-        scrollOffset = (UIView::width * progress) / transitionTimeInMilliSeconds;
+        scrollOffset = getScrollOffset();
 
         /*  The scrolling is over when the offset has been cycled through a complete perceived width.
         */
         if (scrollOffset < UIView::width)
         {
-            left_canvas = canvas->getFrameBuffer(-scrollOffset,
-                                                 0,
-                                                 UIView::width,
-                                                 UIView::height);
+            /*  Both halves are drawn through the same window, one after the other.
+            */
+            transitionWindow->setWindow(canvas.get(),
+                                        -scrollOffset,
+                                        0,
+                                        UIView::width,
+                                        UIView::height);
+
+            leftCell->fillFrameBuffer(transitionCanvas, xOffset - scrollOffset, yOffset);
 
-            leftCell->fillFrameBuffer(left_canvas, -scrollOffset, 0);
+            transitionWindow->setWindow(canvas.get(),
+                                        UIView::width - scrollOffset,
+                                        0,
+                                        UIView::width,
+                                        UIView::height);
 
-            right_canvas = canvas->getFrameBuffer(UIView::width - scrollOffset,
-                                                  0,
-                                                  UIView::width,
-                                                  UIView::height);
+            rightCell->fillFrameBuffer(transitionCanvas, xOffset, yOffset);
 
-            rightCell->fillFrameBuffer(right_canvas, 0, 0);
+            transitionWindow->clearWindow();
 
             callInterval = 0;
         }
         else
         {
             /*  Reset variables. Set mainCell since this is the one we are calling when not scrolling.
+                Drawing the transition resumed the cells of the view underneath, suspend it again.
             */
             scrollRightToLeft = false;
             scrollOffset = 0;
 
-            callInterval = rightCell->fillFrameBuffer(canvas, 0, 0);
+            leftCell->suspend();
+
+            callInterval = rightCell->fillFrameBuffer(canvas, xOffset, yOffset);
         }
     }
     else if (scrollLeftToRight)
     {
-        uint32_t now = UIView::getTimeInMilliseconds();
-        uint32_t progress = now - scrollStartTime;
-        scrollOffset = (UIView::width * progress) / transitionTimeInMilliSeconds;
+        scrollOffset = getScrollOffset();
 
         if (scrollOffset < UIView::width)
         {
-            left_canvas = canvas->getFrameBuffer(scrollOffset - UIView::width,
-                                                 0,
-                                                 UIView::width,
-                                                 UIView::height);
+            transitionWindow->setWindow(canvas.get(),
+                                        scrollOffset - UIView::width,
+                                        0,
+                                        UIView::width,
+                                        UIView::height);
+
+            leftCell->fillFrameBuffer(transitionCanvas, xOffset + (scrollOffset - UIView::width), yOffset);
 
-            leftCell->fillFrameBuffer(left_canvas, (scrollOffset - UIView::width), 0);
+            transitionWindow->setWindow(canvas.get(),
+                                        scrollOffset,
+                                        0,
+                                        UIView::width,
+                                        UIView::height);
 
-            right_canvas = canvas->getFrameBuffer(scrollOffset,
-                                                  0,
-                                                  UIView::width,
-                                                  UIView::height);
+            rightCell->fillFrameBuffer(transitionCanvas, xOffset, yOffset);
 
-            rightCell->fillFrameBuffer(right_canvas, 0, 0);
+            transitionWindow->clearWindow();
 
             callInterval = 0;
         }
@@ -234,15 +266,18 @@ uint32_t UIViewStack::fillFrameBuffer(SharedPointer<FrameBuffer>& canvas,
         {
             scrollLeftToRight = false;
             scrollOffset = 0;
+
+            /* the popped view was drawn during the transition */
+            rightCell->suspend();
             rightCell = SharedPointer<UIView>();
 
-            callInterval = leftCell->fillFrameBuffer(canvas, 0, 0);
+            callInterval = leftCell->fillFrameBuffer(canvas, xOffset, yOffset);
         }
     }
     else
     {
         /* no scrolling in prorgess, call main cell */
-        callInterval = mainCell->fillFrameBuffer(canvas, 0, 0);
+        callInterval = mainCell->fillFrameBuffer(canvas, xOffset, yOffset);
     }
 
     return callInterval;
@@ -253,6 +288,72 @@ void UIViewStack::prefetch(int16_t xOffset, int16_t yOffset)
     mainCell->prefetch(xOffset, yOffset);
 }
 
+/*  The stack has changed while a transition is in progress, otherwise
+    when the view on top has.
+*/
+bool UIViewStack::isDirty()
+{
+    if (UIView::isDirty() || scrollLeftToRight || scrollRightToLeft)
+    {
+        return true;
+    }
+
+    return (mainCell) ? mainCell->isDirty() : false;
+}
+
+UIView::Rect UIViewStack::getDirtyRect()
+{
+    if (UIView::dirty || scrollLeftToRight || scrollRightToLeft)
+    {
+        return getBounds();
+    }
+
+    UIView::Rect region = dirtyRect;
+
+    if (mainCell)
+    {
+        region.unite(mainCell->getDirtyRect());
+    }
+
+    region.intersect(getBounds());
+
+    return region;
+}
+
+void UIViewStack::clearDirty()
+{
+    UIView::clearDirty();
+
+    if (mainCell)
+    {
+        mainCell->clearDirty();
+    }
+
+    if (leftCell)
+    {
+        leftCell->clearDirty();
+    }
+
+    if (rightCell)
+    {
+        rightCell->clearDirty();
+    }
+}
+
+void UIViewStack::setCacheBudget(SharedPointer<UICacheBudget>& budget)
+{
+    /* store reference for new objects pushed on the stack. */
+    cacheBudget = budget;
+
+    /* apply budget to objects already in stack. */
+    unsigned stackSize = stack.get_num_elements();
+
+    for (unsigned idx = 0; idx < stackSize; idx++)
+    {
+        stack.at(idx)->setCacheBudget(budget);
+    }
+}
+
 void UIViewStack::setWakeupCallback(FunctionPointer& callback)
 {
     UIF_PRINTF("UIViewStack: set wakeup %p\r\n", callback.get_function());
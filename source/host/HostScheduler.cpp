@@ -0,0 +1,301 @@
+/* mbed
+ * Copyright (c) 2006-2015 ARM Limited
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#include "UIFramework/UIPlatform.h"
+
+#if UIF_HOST
+
+#include <stddef.h>
+
+namespace {
+
+typedef struct node {
+    uint32_t id;
+    uint64_t due;
+    uint64_t period;
+    uint32_t sequence;
+    mbed::util::Event callback;
+    struct node* next;
+} node_t;
+
+node_t* pending = NULL;
+
+uint64_t now = 0;
+uint64_t dispatchTime = HOST_SCHEDULER_DISPATCH_TIME_US;
+uint32_t nextId = 1;
+uint32_t nextSequence = 0;
+bool running = false;
+
+node_t* findNode(uint32_t id)
+{
+    for (node_t* node = pending; node != NULL; node = node->next)
+    {
+        if (node->id == id)
+        {
+            return node;
+        }
+    }
+
+    return NULL;
+}
+
+void removeNode(node_t* target)
+{
+    node_t** link = &pending;
+
+    while (*link != NULL)
+    {
+        if (*link == target)
+        {
+            *link = target->next;
+            return;
+        }
+
+        link = &((*link)->next);
+    }
+}
+
+/*  Find the callback to dispatch next: earliest due time, and earliest
+    posted for equal due times.
+*/
+node_t* findNext(void)
+{
+    node_t* found = NULL;
+
+    for (node_t* node = pending; node != NULL; node = node->next)
+    {
+        if ((found == NULL)
+            || (node->due < found->due)
+            || ((node->due == found->due) && ((int32_t)(node->sequence - found->sequence) < 0)))
+        {
+            found = node;
+        }
+    }
+
+    return found;
+}
+
+/*  Dispatch a single callback, advancing the clock to its due time.
+*/
+void dispatch(node_t* node)
+{
+    if (node->due > now)
+    {
+        now = node->due;
+    }
+
+    mbed::util::Event callback = node->callback;
+
+    if (node->period > 0)
+    {
+        node->due += node->period;
+        node->sequence = nextSequence++;
+    }
+    else
+    {
+        removeNode(node);
+        delete node;
+    }
+
+    callback.call();
+
+    now += dispatchTime;
+}
+
+} // namespace
+
+namespace minar {
+
+namespace platform {
+
+tick_t getTime(void)
+{
+    return (tick_t) now;
+}
+
+void advanceTime(tick_t ticks)
+{
+    now += ticks;
+}
+
+} // namespace platform
+
+CallbackAdder::CallbackAdder(uint32_t _id)
+    :   id(_id)
+{
+}
+
+CallbackAdder& CallbackAdder::delay(tick_t delay)
+{
+    node_t* node = findNode(id);
+
+    if (node)
+    {
+        node->due = now + delay;
+    }
+
+    return *this;
+}
+
+CallbackAdder& CallbackAdder::tolerance(tick_t tolerance)
+{
+    /* callbacks are always dispatched on time */
+    (void) tolerance;
+
+    return *this;
+}
+
+CallbackAdder& CallbackAdder::period(tick_t period)
+{
+    node_t* node = findNode(id);
+
+    if (node)
+    {
+        node->period = period;
+        node->due = now + period;
+    }
+
+    return *this;
+}
+
+callback_handle_t CallbackAdder::getHandle(void) const
+{
+    return (callback_handle_t)(uintptr_t) id;
+}
+
+CallbackAdder Scheduler::postCallback(const mbed::util::Event& callback)
+{
+    node_t* node = new node_t;
+
+    node->id = nextId++;
+    node->due = now;
+    node->period = 0;
+    node->sequence = nextSequence++;
+    node->callback = callback;
+    node->next = pending;
+
+    pending = node;
+
+    return CallbackAdder(node->id);
+}
+
+CallbackAdder Scheduler::postCallback(void (*callback)(void))
+{
+    mbed::util::FunctionPointer0<void> function(callback);
+
+    return postCallback(function.bind());
+}
+
+int Scheduler::cancelCallback(callback_handle_t handle)
+{
+    node_t* node = findNode((uint32_t)(uintptr_t) handle);
+
+    if (node)
+    {
+        removeNode(node);
+        delete node;
+
+        return 0;
+    }
+
+    return -1;
+}
+
+int Scheduler::start(void)
+{
+    running = true;
+
+    while (running && (pending != NULL))
+    {
+        dispatch(findNext());
+    }
+
+    return 0;
+}
+
+void Scheduler::stop(void)
+{
+    running = false;
+}
+
+uint32_t Scheduler::runUntil(tick_t time)
+{
+    uint64_t until = now + (tick_t)(time - (tick_t) now);
+    uint32_t dispatched = 0;
+
+    for (node_t* node = findNext(); (node != NULL) && (node->due <= until); node = findNext())
+    {
+        dispatch(node);
+        dispatched++;
+    }
+
+    if (until > now)
+    {
+        now = until;
+    }
+
+    return dispatched;
+}
+
+uint32_t Scheduler::getPendingCallbacks(void)
+{
+    uint32_t count = 0;
+
+    for (node_t* node = pending; node != NULL; node = node->next)
+    {
+        count++;
+    }
+
+    return count;
+}
+
+void Scheduler::setDispatchTime(tick_t time)
+{
+    dispatchTime = time;
+}
+
+void Scheduler::reset(void)
+{
+    while (pending != NULL)
+    {
+        node_t* node = pending;
+        pending = node->next;
+        delete node;
+    }
+
+    now = 0;
+    dispatchTime = HOST_SCHEDULER_DISPATCH_TIME_US;
+    running = false;
+}
+
+} // namespace minar
+
+/*  minar provides the program entry point on mbed targets and calls
+    app_start. Do the same on host, unless the program has its own main.
+*/
+extern void app_start(int argc, char* argv[]) __attribute__((weak));
+
+__attribute__((weak)) int main(int argc, char* argv[])
+{
+    if (app_start)
+    {
+        app_start(argc, argv);
+    }
+
+    return minar::Scheduler::start();
+}
+
+#endif // UIF_HOST
@@ -0,0 +1,252 @@
+/* mbed
+ * Copyright (c) 2006-2015 ARM Limited
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#include "UIFramework/host/UIHostDisplay.h"
+
+#if UIF_HOST
+
+#include <stdio.h>
+
+
+UIHostDisplay::UIHostDisplay(uint16_t _width, uint16_t _height, uint32_t _bufferCount)
+    :   UIDisplay(),
+        width(_width),
+        height(_height),
+        screen(_width, _height),
+        buffers(NULL),
+        bufferCount(_bufferCount),
+        nextBuffer(0),
+        busy(false),
+        lineTime(HOST_DISPLAY_LINE_TIME_US),
+        dumpPrefix(NULL),
+        frames(0),
+        lines(0),
+        pixelWrites(0),
+        overdraw(0),
+        lastOverdraw(0)
+{
+    if (bufferCount == 0)
+    {
+        bufferCount = 1;
+    }
+
+    buffers = new SharedPointer<FrameBuffer>[bufferCount];
+
+    for (uint32_t idx = 0; idx < bufferCount; idx++)
+    {
+        UIMemoryFrameBuffer* buffer = new UIMemoryFrameBuffer(width, height);
+
+        buffer->setOverdrawTracking(true);
+
+        buffers[idx] = SharedPointer<FrameBuffer>(buffer);
+    }
+}
+
+UIHostDisplay::~UIHostDisplay()
+{
+    delete[] buffers;
+}
+
+SharedPointer<FrameBuffer> UIHostDisplay::getFrameBuffer()
+{
+    SharedPointer<FrameBuffer> buffer = buffers[nextBuffer];
+
+    nextBuffer = (nextBuffer + 1) % bufferCount;
+
+    return buffer;
+}
+
+uint32_t UIHostDisplay::getBufferCount() const
+{
+    return bufferCount;
+}
+
+void UIHostDisplay::sendFrameBuffer(SharedPointer<FrameBuffer>& buffer,
+                                    FunctionPointer _onStart,
+                                    FunctionPointer _onFinish)
+{
+    transfer(buffer, NULL, _onStart, _onFinish);
+}
+
+void UIHostDisplay::sendFrameBufferLines(SharedPointer<FrameBuffer>& buffer,
+                                         const uint8_t* _lines,
+                                         FunctionPointer _onStart,
+                                         FunctionPointer _onFinish)
+{
+    transfer(buffer, _lines, _onStart, _onFinish);
+}
+
+bool UIHostDisplay::canSendLines() const
+{
+    return true;
+}
+
+/*  All buffers are handed out by this display, so lines are read from
+    their memory directly.
+*/
+const uint8_t* UIHostDisplay::getLine(SharedPointer<FrameBuffer>& buffer, uint16_t line) const
+{
+    UIMemoryFrameBuffer* memory = static_cast<UIMemoryFrameBuffer*>(buffer.get());
+
+    return memory->getData() + (line * memory->getStride());
+}
+
+/*  Copy the selected lines to the screen and complete the transfer after
+    the simulated transfer time. A NULL bitmap selects all lines.
+*/
+void UIHostDisplay::transfer(SharedPointer<FrameBuffer>& buffer,
+                             const uint8_t* selection,
+                             FunctionPointer _onStart,
+                             FunctionPointer _onFinish)
+{
+    MBED_ASSERT(!busy);
+
+    busy = true;
+    onFinish = _onFinish;
+
+    uint32_t count = 0;
+
+    for (uint16_t line = 0; (line < height) && (line < buffer->getHeight()); line++)
+    {
+        if ((selection == NULL) || (selection[line / 8] & (1 << (line % 8))))
+        {
+            for (uint16_t x = 0; (x < width) && (x < buffer->getWidth()); x++)
+            {
+                screen.drawPixel(x, line, buffer->getPixel(x, line));
+            }
+
+            count++;
+        }
+    }
+
+    frames++;
+    lines += count;
+
+    /* all buffers are handed out by this display */
+    UIMemoryFrameBuffer* memory = static_cast<UIMemoryFrameBuffer*>(buffer.get());
+
+    lastOverdraw = memory->getOverdraw();
+    overdraw += lastOverdraw;
+    pixelWrites += memory->getPixelWrites();
+
+    memory->resetOverdraw();
+
+    if (dumpPrefix)
+    {
+        char filename[256];
+
+        snprintf(filename, sizeof(filename), "%s%05lu.pbm", dumpPrefix, (unsigned long) frames);
+
+        writePBM(filename);
+    }
+
+    if (_onStart)
+    {
+        minar::Scheduler::postCallback(_onStart.bind());
+    }
+
+    minar::Scheduler::postCallback(this, &UIHostDisplay::transferDone)
+        .delay(count * lineTime);
+}
+
+void UIHostDisplay::transferDone()
+{
+    busy = false;
+
+    onFinish.call();
+}
+
+void UIHostDisplay::setLineTime(uint32_t lineTimeUs)
+{
+    lineTime = lineTimeUs;
+}
+
+void UIHostDisplay::setDumpPrefix(const char* prefix)
+{
+    dumpPrefix = prefix;
+}
+
+bool UIHostDisplay::writePBM(const char* filename) const
+{
+    FILE* file = fopen(filename, "wb");
+
+    if (file == NULL)
+    {
+        return false;
+    }
+
+    fprintf(file, "P4\n%u %u\n", width, height);
+
+    /* PBM rows are MSB first with 1 being black */
+    for (uint16_t y = 0; y < height; y++)
+    {
+        for (uint16_t x = 0; x < width; x += 8)
+        {
+            uint8_t byte = 0;
+
+            for (uint16_t bit = 0; bit < 8; bit++)
+            {
+                if (((x + bit) < width) && (screen.getPixel(x + bit, y) == 0))
+                {
+                    byte |= 0x80 >> bit;
+                }
+            }
+
+            fputc(byte, file);
+        }
+    }
+
+    fclose(file);
+
+    return true;
+}
+
+uint8_t UIHostDisplay::getPixel(uint16_t x, uint16_t y) const
+{
+    return screen.getPixel(x, y);
+}
+
+uint32_t UIHostDisplay::getFrames() const
+{
+    return frames;
+}
+
+uint32_t UIHostDisplay::getLines() const
+{
+    return lines;
+}
+
+bool UIHostDisplay::isBusy() const
+{
+    return busy;
+}
+
+uint32_t UIHostDisplay::getPixelWrites() const
+{
+    return pixelWrites;
+}
+
+uint32_t UIHostDisplay::getOverdraw() const
+{
+    return overdraw;
+}
+
+uint32_t UIHostDisplay::getLastOverdraw() const
+{
+    return lastOverdraw;
+}
+
+#endif // UIF_HOST
@@ -0,0 +1,102 @@
+/* mbed
+ * Copyright (c) 2006-2015 ARM Limited
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+
+#ifndef __UITEST_H__
+#define __UITEST_H__
+
+#include "UIFramework/UIView.h"
+
+#include <stdio.h>
+
+/*  Shared by the tests in this directory. A test defines TEST_NAME before
+    including this header, reports each expectation through check() and
+    calls finish() last to print the markers the test runner waits for.
+*/
+
+#ifndef TEST_NAME
+#define TEST_NAME "test"
+#endif
+
+static bool pass = true;
+
+static inline void check(bool condition, const char* name)
+{
+    if (!condition)
+    {
+        printf(TEST_NAME ": failed: %s\r\n", name);
+        pass = false;
+    }
+}
+
+static inline void finish(void)
+{
+    printf("{{%s}}\r\n", (pass) ? "success" : "failure");
+    printf("{{end}}\r\n");
+}
+
+/**
+ * @brief Fixture array of rows with the same height and width.
+ * @details Tests derive from it and only implement viewAtIndex, plus
+ *          whatever else their rows do differently.
+ */
+class UITestArray : public UIView::Array
+{
+public:
+    UITestArray(const char* _title, uint32_t _rows, uint32_t _rowHeight, uint32_t _width = 128)
+        :   title(_title),
+            rows(_rows),
+            rowHeight(_rowHeight),
+            width(_width)
+    {}
+
+    virtual uint32_t getSize(void) const
+    {
+        return rows;
+    }
+
+    virtual uint32_t heightAtIndex(uint32_t index) const
+    {
+        (void) index;
+
+        return rowHeight;
+    }
+
+    virtual uint32_t widthAtIndex(uint32_t index) const
+    {
+        (void) index;
+
+        return width;
+    }
+
+    virtual const char* getTitle(void) const
+    {
+        return title;
+    }
+
+    virtual uint32_t getLastIndex(void) const
+    {
+        return (rows > 0) ? rows - 1 : 0;
+    }
+
+protected:
+    const char* title;
+    uint32_t rows;
+    uint32_t rowHeight;
+    uint32_t width;
+};
+
+#endif // __UITEST_H__
@@ -0,0 +1,209 @@
+/* mbed
+ * Copyright (c) 2006-2015 ARM Limited
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+/*  Blit scroll test: a table that keeps its drawn rows and moves them while
+    scrolling must produce the same pixels as one that draws every row each
+    frame, while drawing only the rows scrolled into view and the cells that
+    changed. Prints the pixels drawn per frame during a scripted fling.
+*/
+
+#include "UIFramework/UIPlatform.h"
+
+#if UIF_HOST
+
+#include "UIFramework/UIMemoryFrameBuffer.h"
+#include "UIFramework/UITableKineticView.h"
+
+#include <stdio.h>
+
+#define TEST_NAME "blitscroll"
+#include "test/UITest.h"
+
+#define ROWS 200
+#define ROW_HEIGHT 22
+#define SIZE 128
+#define FRAMES 90
+
+/* changed during the fling, every fifth cell follows it */
+static uint32_t phase = 0;
+
+/*  Stripes that differ from row to row, so a row moved by the wrong
+    distance shows up in the comparison.
+*/
+class PatternView : public UIView
+{
+public:
+    PatternView(uint32_t _index)
+        :   UIView(),
+            index(_index),
+            drawnPhase(0)
+    {}
+
+    virtual uint32_t fillFrameBuffer(SharedPointer<FrameBuffer>& canvas, int16_t xOffset, int16_t yOffset)
+    {
+        (void) xOffset;
+
+        drawnPhase = phase;
+
+        uint8_t flip = ((index % 5) == 0) ? (phase % 2) : 0;
+        int32_t bar = (index * 7) % width;
+
+        for (int32_t y = 0; y < height; y++)
+        {
+            int32_t line = y + yOffset;
+
+            if ((line >= 0) && (line < canvas->getHeight()))
+            {
+                uint8_t color = ((y + index) / 3) % 2;
+
+                canvas->drawRectangle(0, bar, line, line + 1, color ^ flip);
+                canvas->drawRectangle(bar, width, line, line + 1, (color ^ flip) ^ 1);
+            }
+        }
+
+        return UINT32_MAX;
+    }
+
+    virtual bool isDirty(void)
+    {
+        return UIView::isDirty() || (((index % 5) == 0) && (drawnPhase != phase));
+    }
+
+private:
+    uint32_t index;
+    uint32_t drawnPhase;
+};
+
+class PatternArray : public UITestArray
+{
+public:
+    PatternArray()
+        :   UITestArray("Pattern", ROWS, ROW_HEIGHT, SIZE)
+    {}
+
+    virtual SharedPointer<UIView> viewAtIndex(uint32_t index) const
+    {
+        return SharedPointer<UIView>(new PatternView(index));
+    }
+
+    virtual uint32_t getUniformHeight(void) const
+    {
+        return ROW_HEIGHT;
+    }
+};
+
+static bool samePixels(UIMemoryFrameBuffer* a, UIMemoryFrameBuffer* b)
+{
+    for (uint16_t y = 0; y < SIZE; y++)
+    {
+        for (uint16_t x = 0; x < SIZE; x++)
+        {
+            if (a->getPixel(x, y) != b->getPixel(x, y))
+            {
+                return false;
+            }
+        }
+    }
+
+    return true;
+}
+
+void app_start(int, char *[])
+{
+    SharedPointer<UIView::Array> array(new PatternArray());
+
+    UITableKineticView* full = new UITableKineticView(array, SIZE, SIZE, 0);
+    UITableKineticView* blit = new UITableKineticView(array, SIZE, SIZE, 0);
+    SharedPointer<UIView> fullView(full);
+    SharedPointer<UIView> blitView(blit);
+
+    blit->setBlitScrolling(true);
+
+    UIMemoryFrameBuffer* fullBuffer = new UIMemoryFrameBuffer(SIZE, SIZE);
+    UIMemoryFrameBuffer* blitBuffer = new UIMemoryFrameBuffer(SIZE, SIZE);
+    SharedPointer<FrameBuffer> fullCanvas(fullBuffer);
+    SharedPointer<FrameBuffer> blitCanvas(blitBuffer);
+
+    uint32_t mismatches = 0;
+    uint32_t moving = 0;
+
+    for (uint32_t frame = 0; frame < FRAMES; frame++)
+    {
+        /* fling down, back up, and change some cells on the way */
+        if (frame == 5)
+        {
+            full->sliderReleasedWithSpeed(-90);
+            blit->sliderReleasedWithSpeed(-90);
+        }
+        else if (frame == 50)
+        {
+            full->sliderReleasedWithSpeed(60);
+            blit->sliderReleasedWithSpeed(60);
+        }
+
+        if ((frame % 20) == 10)
+        {
+            phase++;
+        }
+
+        int32_t before = full->getPixels();
+
+        fullView->fillFrameBuffer(fullCanvas, 0, 0);
+        blitView->fillFrameBuffer(blitCanvas, 0, 0);
+
+        if (full->getPixels() != before)
+        {
+            moving++;
+        }
+
+        if (!samePixels(fullBuffer, blitBuffer))
+        {
+            mismatches++;
+        }
+
+        /* as the framework does after sending a frame */
+        fullView->clearDirty();
+        blitView->clearDirty();
+
+        minar::Scheduler::runUntil(minar::platform::getTime() + 16000);
+    }
+
+    uint32_t fullPixels = full->getRenderedLines() * SIZE / FRAMES;
+    uint32_t blitPixels = blit->getRenderedLines() * SIZE / FRAMES;
+
+    printf("blitscroll: frames: %lu moving: %lu mismatches: %lu\r\n",
+           (unsigned long) FRAMES,
+           (unsigned long) moving,
+           (unsigned long) mismatches);
+    printf("blitscroll: pixels per frame: full: %lu blit: %lu\r\n",
+           (unsigned long) fullPixels,
+           (unsigned long) blitPixels);
+
+    check(moving > 20, "table scrolled");
+    check(mismatches == 0, "same pixels");
+    check(blitPixels * 2 < fullPixels, "fewer pixels drawn");
+
+    finish();
+}
+
+#else
+
+void app_start(int, char *[])
+{
+    /* host only */
+}
+
+#endif // UIF_HOST
@@ -0,0 +1,268 @@
+/* mbed
+ * Copyright (c) 2006-2015 ARM Limited
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+/*  Cache budget test: with a byte budget the cell cache must keep the
+    memory retained by its cells within the budget however heavy the
+    cells are, where a cache limited by cell count does not. Tables in a
+    UIViewStack share the budget, and a table going into the background
+    gives up its cells when the budget is exceeded. Cells kept in the pool
+    for reuse count against the budget too.
+*/
+
+#include "UIFramework/UIMemoryFrameBuffer.h"
+#include "UIFramework/UITableView.h"
+#include "UIFramework/UITextView.h"
+#include "UIFramework/UIViewStack.h"
+
+#include <stdio.h>
+
+#define TEST_NAME "cachebudget"
+#include "test/UITest.h"
+
+#define ROWS 200
+#define ROW_HEIGHT 20
+#define SIZE 128
+#define IMAGE_BYTES 2048
+#define BUDGET_BYTES 8192
+
+/*  Stands in for a cell holding a decoded image.
+*/
+class HeavyView : public UIView
+{
+public:
+    virtual uint32_t fillFrameBuffer(SharedPointer<FrameBuffer>& canvas, int16_t xOffset, int16_t yOffset)
+    {
+        (void) canvas;
+        (void) xOffset;
+        (void) yOffset;
+
+        return UINT32_MAX;
+    }
+
+    virtual uint32_t getRetainedBytes(void) const
+    {
+        return sizeof(HeavyView) + IMAGE_BYTES;
+    }
+};
+
+/*  Every fourth row is heavy, the rest are text.
+*/
+class MixedArray : public UITestArray
+{
+public:
+    MixedArray()
+        :   UITestArray("Mixed", ROWS, ROW_HEIGHT, SIZE)
+    {}
+
+    virtual SharedPointer<UIView> viewAtIndex(uint32_t index) const
+    {
+        if ((index % 4) == 0)
+        {
+            return SharedPointer<UIView>(new HeavyView());
+        }
+
+        return SharedPointer<UIView>(new UITextView("Text", &Font_Menu));
+    }
+};
+
+/*  Scroll through the table and return the most bytes retained by its
+    cache after a frame.
+*/
+static uint32_t scroll(UITableView* table)
+{
+    UIMemoryFrameBuffer* buffer = new UIMemoryFrameBuffer(SIZE, SIZE);
+    SharedPointer<FrameBuffer> canvas(buffer);
+
+    uint32_t most = 0;
+
+    for (uint32_t frame = 0; frame < 200; frame++)
+    {
+        table->fillFrameBuffer(canvas, 0, 0);
+        table->scrollPx(-9);
+
+        /* as it would be counted with a budget */
+        table->getCellCache().refresh();
+
+        uint32_t bytes = table->getCellCache().getRetainedBytes();
+
+        most = (bytes > most) ? bytes : most;
+    }
+
+    return most;
+}
+
+static void testBudget(void)
+{
+    SharedPointer<UIView::Array> array(new MixedArray());
+
+    /* count limited */
+    UITableView* counted = new UITableView(array);
+    SharedPointer<UIView> countedView(counted);
+
+    uint32_t countedBytes = scroll(counted);
+
+    /* byte limited, with room for more cells than the count limit */
+    UITableView* budgeted = new UITableView(array, 32);
+    SharedPointer<UIView> budgetedView(budgeted);
+    SharedPointer<UICacheBudget> budget(new UICacheBudget(BUDGET_BYTES));
+
+    budgetedView->setCacheBudget(budget);
+
+    uint32_t budgetedBytes = scroll(budgeted);
+
+    printf("cachebudget: most bytes retained: %u cells: %lu budget %lu: %lu peak: %lu trimmed: %lu\r\n",
+           DEFAULT_CACHE_SIZE,
+           (unsigned long) countedBytes,
+           (unsigned long) BUDGET_BYTES,
+           (unsigned long) budgetedBytes,
+           (unsigned long) budget->getPeak(),
+           (unsigned long) budgeted->getCellCache().getTrimmed());
+
+    check(countedBytes > BUDGET_BYTES, "count limit exceeds budget");
+    check(budgetedBytes <= BUDGET_BYTES, "within budget");
+    check(budget->getUsed() == budgeted->getCellCache().getRetainedBytes(), "budget accounted");
+}
+
+/*  Reusable cell that keeps its image while suspended, so the pool holds
+    on to it.
+*/
+#define HEAVY_CELL 1
+
+class PooledHeavyView : public HeavyView
+{
+public:
+    PooledHeavyView()
+    {
+        setReuseType(HEAVY_CELL);
+    }
+};
+
+class PooledArray : public MixedArray
+{
+public:
+    virtual SharedPointer<UIView> viewAtIndex(uint32_t index) const
+    {
+        if ((index % 4) == 0)
+        {
+            return SharedPointer<UIView>(new PooledHeavyView());
+        }
+
+        return MixedArray::viewAtIndex(index);
+    }
+
+    virtual SharedPointer<UIView> viewAtIndex(uint32_t index, UICellPool& pool) const
+    {
+        SharedPointer<UIView> cell;
+
+        if ((index % 4) == 0)
+        {
+            cell = pool.dequeue(HEAVY_CELL);
+        }
+
+        return (cell != NULL) ? cell : viewAtIndex(index);
+    }
+};
+
+/*  Cells in the pool count against the budget, and are dropped before
+    cached cells are evicted.
+*/
+static void testPool(void)
+{
+    SharedPointer<UIView::Array> array(new PooledArray());
+    UITableView* table = new UITableView(array);
+    SharedPointer<UIView> view(table);
+
+    /* room for the cached cells and some, not all, of the pooled ones */
+    SharedPointer<UICacheBudget> budget(new UICacheBudget(2 * BUDGET_BYTES));
+
+    view->setCacheBudget(budget);
+
+    UIMemoryFrameBuffer* buffer = new UIMemoryFrameBuffer(SIZE, SIZE);
+    SharedPointer<FrameBuffer> canvas(buffer);
+
+    bool accounted = true;
+    bool within = true;
+    uint32_t mostPooled = 0;
+
+    for (uint32_t frame = 0; frame < 200; frame++)
+    {
+        view->fillFrameBuffer(canvas, 0, 0);
+        table->scrollPx(-9);
+
+        uint32_t pooled = table->getCellPool().getRetainedBytes();
+
+        accounted = accounted && (budget->getUsed() == table->getCellCache().getRetainedBytes() + pooled);
+        within = within && (budget->getUsed() <= 2 * BUDGET_BYTES);
+        mostPooled = (pooled > mostPooled) ? pooled : mostPooled;
+    }
+
+    printf("cachebudget: pool: most bytes pooled: %lu reused: %lu dropped: %lu\r\n",
+           (unsigned long) mostPooled,
+           (unsigned long) table->getCellPool().getReused(),
+           (unsigned long) table->getCellPool().getDropped());
+
+    check(accounted, "pooled bytes accounted");
+    check(within, "pool within budget");
+    check(table->getCellPool().getReused() > 0, "pool still reused");
+}
+
+static void testStack(void)
+{
+    SharedPointer<UIView::Array> array(new MixedArray());
+    SharedPointer<UICacheBudget> budget(new UICacheBudget(BUDGET_BYTES));
+
+    UIViewStack* stack = new UIViewStack();
+    SharedPointer<UIView> stackView(stack);
+
+    stackView->setCacheBudget(budget);
+
+    UITableView* first = new UITableView(array, 32);
+    UITableView* second = new UITableView(array, 32);
+    SharedPointer<UIView> firstView(first);
+    SharedPointer<UIView> secondView(second);
+
+    UIMemoryFrameBuffer* buffer = new UIMemoryFrameBuffer(SIZE, SIZE);
+    SharedPointer<FrameBuffer> canvas(buffer);
+
+    stack->pushView(firstView);
+    scroll(first);
+
+    uint32_t before = first->getCellCache().getRetainedBytes();
+
+    /* suspends the first table */
+    stack->pushView(secondView);
+    scroll(second);
+
+    uint32_t after = first->getCellCache().getRetainedBytes();
+
+    printf("cachebudget: stack: first table: %lu before push %lu after, shared: %lu\r\n",
+           (unsigned long) before,
+           (unsigned long) after,
+           (unsigned long) budget->getUsed());
+
+    check(after < before, "background table gave up cells");
+    check(budget->getUsed() == after + second->getCellCache().getRetainedBytes(), "budget shared");
+    check(budget->getUsed() <= BUDGET_BYTES, "stack within budget");
+}
+
+void app_start(int, char *[])
+{
+    testBudget();
+    testPool();
+    testStack();
+
+    finish();
+}
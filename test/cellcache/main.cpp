@@ -0,0 +1,198 @@
+/* mbed
+ * Copyright (c) 2006-2015 ARM Limited
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+/*  Cell cache test: rows that map to the same set must not evict each other
+    while the set has room, the least recently used cell goes first, and
+    hits, misses, evictions and refetches are counted. A scrolling workload
+    reports the hit rate for a range of cache sizes.
+*/
+
+#include "UIFramework/UIPlatform.h"
+
+#if UIF_HOST
+
+#include "UIFramework/UICellCache.h"
+#include "UIFramework/UIMemoryFrameBuffer.h"
+#include "UIFramework/UITableView.h"
+
+#include <stdio.h>
+
+#define TEST_NAME "cellcache"
+#include "test/UITest.h"
+
+#define ROWS 100
+#define ROW_HEIGHT 20
+
+class BlankView : public UIView
+{
+public:
+    virtual uint32_t fillFrameBuffer(SharedPointer<FrameBuffer>& canvas, int16_t xOffset, int16_t yOffset)
+    {
+        (void) canvas;
+        (void) xOffset;
+        (void) yOffset;
+
+        return UINT32_MAX;
+    }
+};
+
+class BlankArray : public UITestArray
+{
+public:
+    BlankArray()
+        :   UITestArray("Blank", ROWS, ROW_HEIGHT)
+    {}
+
+    virtual SharedPointer<UIView> viewAtIndex(uint32_t index) const
+    {
+        (void) index;
+
+        return SharedPointer<UIView>(new BlankView());
+    }
+};
+
+static void testCache(void)
+{
+    SharedPointer<UIView> cells[5];
+
+    for (uint32_t idx = 0; idx < 5; idx++)
+    {
+        cells[idx] = SharedPointer<UIView>(new BlankView());
+    }
+
+    /* direct mapped: rows 0 and 4 share a slot */
+    UICellCache direct(4, 1);
+
+    direct.insert(0, cells[0]);
+    direct.insert(4, cells[1]);
+
+    check(direct.lookup(0) == NULL, "direct mapped collision");
+    check(direct.getEvictions() == 1, "direct mapped eviction");
+    check(direct.getMisses() == 1, "direct mapped miss");
+
+    /* fully associative: all four fit, the least recently used goes first */
+    UICellCache associative(4, 4);
+
+    associative.insert(0, cells[0]);
+    associative.insert(4, cells[1]);
+    associative.insert(8, cells[2]);
+    associative.insert(12, cells[3]);
+
+    check(associative.getEvictions() == 0, "associative no eviction");
+    check(associative.lookup(0) == cells[0], "associative hit");
+
+    associative.insert(16, cells[4]);
+
+    check(associative.getEvictions() == 1, "associative eviction");
+    check(associative.peek(0) == cells[0], "recently used kept");
+    check(associative.peek(4) == NULL, "least recently used evicted");
+
+    /* invalid cells are refetched */
+    cells[2]->invalidate();
+
+    check(associative.lookup(8) == NULL, "invalid cell");
+    check(associative.getRefetches() == 1, "refetch counted");
+    check(associative.getHits() == 1, "hits counted");
+
+    /* uneven sizes use every slot */
+    UICellCache uneven(10, 4);
+
+    check(uneven.getSize() == 10, "uneven size");
+    check(uneven.getWays() == 5, "uneven ways");
+}
+
+/*  Scroll down the table and back up, letting the prefetches run between
+    frames.
+*/
+static void workload(uint32_t size, uint32_t ways, uint32_t& hits, uint32_t& misses, uint32_t& evictions)
+{
+    SharedPointer<UIView::Array> array(new BlankArray());
+    UITableView table(array, size, ways);
+
+    table.setWidth(128);
+    table.setHeight(128);
+
+    UIMemoryFrameBuffer* buffer = new UIMemoryFrameBuffer(128, 128);
+    SharedPointer<FrameBuffer> canvas(buffer);
+
+    for (uint32_t frame = 0; frame < 400; frame++)
+    {
+        table.scrollPx((frame < 200) ? -7 : 7);
+        table.fillFrameBuffer(canvas, 0, 0);
+
+        minar::Scheduler::runUntil(minar::platform::getTime() + 1000);
+    }
+
+    UICellCache& cache = table.getCellCache();
+
+    hits = cache.getHits();
+    misses = cache.getMisses();
+    evictions = cache.getEvictions();
+}
+
+void app_start(int, char *[])
+{
+    testCache();
+
+    printf("cellcache: size ways hits misses evictions\r\n");
+
+    uint32_t directMisses = 0;
+    uint32_t associativeMisses = 0;
+
+    for (uint32_t size = 8; size <= 16; size += 2)
+    {
+        for (uint32_t ways = 1; ways <= 4; ways *= 4)
+        {
+            uint32_t hits = 0;
+            uint32_t misses = 0;
+            uint32_t evictions = 0;
+
+            workload(size, ways, hits, misses, evictions);
+
+            printf("cellcache: %4lu %4lu %4lu %6lu %9lu\r\n",
+                   (unsigned long) size,
+                   (unsigned long) ways,
+                   (unsigned long) hits,
+                   (unsigned long) misses,
+                   (unsigned long) evictions);
+
+            if (size == DEFAULT_CACHE_SIZE)
+            {
+                if (ways == 1)
+                {
+                    directMisses = misses;
+                }
+                else
+                {
+                    associativeMisses = misses;
+                }
+            }
+        }
+    }
+
+    check(associativeMisses <= directMisses, "associative cache misses less");
+
+    finish();
+}
+
+#else
+
+void app_start(int, char *[])
+{
+    /* host only */
+}
+
+#endif // UIF_HOST
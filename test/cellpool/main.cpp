@@ -0,0 +1,198 @@
+/* mbed
+ * Copyright (c) 2006-2015 ARM Limited
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+/*  Cell pool test: evicted cells are only kept when they have a reuse type
+    and nothing else holds them, and a table whose data source rebinds
+    pooled text cells draws the same pixels as one allocating a new cell
+    for every row, while creating far fewer views during a long scroll.
+*/
+
+#include "UIFramework/UIMemoryFrameBuffer.h"
+#include "UIFramework/UITableView.h"
+#include "UIFramework/UITextView.h"
+
+#include <stdio.h>
+
+#define TEST_NAME "cellpool"
+#include "test/UITest.h"
+
+#define ROWS 500
+#define ROW_HEIGHT 20
+#define SIZE 128
+#define TEXT_CELL 1
+
+static const char* labels[] = { "Alpha", "Bravo", "Charlie", "Delta", "Echo", "Foxtrot", "Golf" };
+
+/*  Text rows, either reusing pooled cells or creating a new one every time.
+*/
+class TextArray : public UITestArray
+{
+public:
+    TextArray(bool _reuse)
+        :   UITestArray("Text", ROWS, ROW_HEIGHT, SIZE),
+            reuse(_reuse),
+            created(0)
+    {}
+
+    virtual SharedPointer<UIView> viewAtIndex(uint32_t index) const
+    {
+        created++;
+
+        UITextView* text = new UITextView(labels[index % 7], &Font_Menu);
+        text->setReuseType(TEXT_CELL);
+
+        return SharedPointer<UIView>(text);
+    }
+
+    virtual SharedPointer<UIView> viewAtIndex(uint32_t index, UICellPool& pool) const
+    {
+        SharedPointer<UIView> cell;
+
+        if (reuse)
+        {
+            cell = pool.dequeue(TEXT_CELL);
+        }
+
+        if (cell == NULL)
+        {
+            return viewAtIndex(index);
+        }
+
+        /* only text cells are pooled under this type */
+        static_cast<UITextView*>(cell.get())->setText(labels[index % 7]);
+
+        return cell;
+    }
+
+    bool reuse;
+    mutable uint32_t created;
+};
+
+static void testPool(void)
+{
+    UICellPool pool(2);
+
+    SharedPointer<UIView> plain(new UITextView("Plain", &Font_Menu));
+    check(!pool.recycle(plain), "no reuse type");
+
+    UITextView* text = new UITextView("Text", &Font_Menu);
+    text->setReuseType(TEXT_CELL);
+    SharedPointer<UIView> held(text);
+    SharedPointer<UIView> other(held);
+
+    check(!pool.recycle(held), "referenced elsewhere");
+
+    other = SharedPointer<UIView>();
+    text->invalidate();
+
+    check(pool.recycle(held), "recycled");
+
+    held = SharedPointer<UIView>();
+
+    check(pool.dequeue(TEXT_CELL + 1) == NULL, "other type");
+
+    SharedPointer<UIView> cell = pool.dequeue(TEXT_CELL);
+
+    check(cell.get() == text, "dequeued");
+    check(cell->isValid() && cell->isDirty(), "prepared for reuse");
+    check(pool.getSize() == 0, "empty");
+
+    /* pooled cells count against a budget until dequeued or dropped */
+    SharedPointer<UICacheBudget> budget(new UICacheBudget(0));
+
+    pool.setBudget(budget);
+    pool.recycle(cell);
+
+    uint32_t bytes = text->getRetainedBytes();
+
+    cell = SharedPointer<UIView>();
+
+    check(budget->getUsed() == bytes, "pooled bytes budgeted");
+    check(pool.getRetainedBytes() == bytes, "pooled bytes counted");
+    check(pool.drop() && (budget->getUsed() == 0), "dropped bytes released");
+    check(!pool.drop(), "nothing left to drop");
+}
+
+static bool samePixels(UIMemoryFrameBuffer* a, UIMemoryFrameBuffer* b)
+{
+    for (uint16_t y = 0; y < SIZE; y++)
+    {
+        for (uint16_t x = 0; x < SIZE; x++)
+        {
+            if (a->getPixel(x, y) != b->getPixel(x, y))
+            {
+                return false;
+            }
+        }
+    }
+
+    return true;
+}
+
+/*  Scroll both tables through every row, a few pixels at a time.
+*/
+static void testScroll(void)
+{
+    TextArray* fresh = new TextArray(false);
+    TextArray* pooled = new TextArray(true);
+    SharedPointer<UIView::Array> freshArray(fresh);
+    SharedPointer<UIView::Array> pooledArray(pooled);
+
+    UITableView freshTable(freshArray);
+    UITableView pooledTable(pooledArray);
+
+    UIMemoryFrameBuffer* freshBuffer = new UIMemoryFrameBuffer(SIZE, SIZE);
+    UIMemoryFrameBuffer* pooledBuffer = new UIMemoryFrameBuffer(SIZE, SIZE);
+    SharedPointer<FrameBuffer> freshCanvas(freshBuffer);
+    SharedPointer<FrameBuffer> pooledCanvas(pooledBuffer);
+
+    uint32_t mismatches = 0;
+
+    for (uint32_t frame = 0; frame < (ROWS * ROW_HEIGHT) / 7; frame++)
+    {
+        freshTable.fillFrameBuffer(freshCanvas, 0, 0);
+        pooledTable.fillFrameBuffer(pooledCanvas, 0, 0);
+
+        if (!samePixels(freshBuffer, pooledBuffer))
+        {
+            mismatches++;
+        }
+
+        freshTable.scrollPx(-7);
+        pooledTable.scrollPx(-7);
+    }
+
+    UICellPool& pool = pooledTable.getCellPool();
+
+    printf("cellpool: views created: new: %lu pooled: %lu reused: %lu recycled: %lu mismatches: %lu\r\n",
+           (unsigned long) fresh->created,
+           (unsigned long) pooled->created,
+           (unsigned long) pool.getReused(),
+           (unsigned long) pool.getRecycled(),
+           (unsigned long) mismatches);
+
+    check(mismatches == 0, "same pixels");
+    check(fresh->created >= ROWS, "every row created");
+    check(pooled->created <= DEFAULT_CACHE_SIZE + DEFAULT_POOL_SIZE, "views reused");
+}
+
+void app_start(int, char *[])
+{
+    testPool();
+    testScroll();
+
+    finish();
+}
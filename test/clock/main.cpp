@@ -0,0 +1,95 @@
+/* mbed
+ * Copyright (c) 2006-2015 ARM Limited
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+/*  Clock test: intervals and animations must be unaffected by the wrap of
+    the microsecond counter. Runs on a virtual clock started just before the
+    wrap, so the result does not depend on the platform.
+*/
+
+#include "UIFramework/UIPlatform.h"
+
+#include "UIFramework/UIClock.h"
+#include "UIFramework/UIMemoryFrameBuffer.h"
+#include "UIFramework/UITextView.h"
+#include "UIFramework/UIViewStack.h"
+
+#include "uif-tools-1bit/fonts/fonts.h"
+
+#include <stdio.h>
+
+#define TEST_NAME "clock"
+#include "test/UITest.h"
+
+#define START_TIME (0xFFFFFFFF - 100000)
+
+void app_start(int, char *[])
+{
+    UIClock::setVirtualTime(START_TIME);
+
+    uint32_t start = UIClock::getTime();
+    uint32_t startMilliseconds = UIClock::getTimeInMilliseconds();
+
+    /* cross the wrap of the microsecond counter */
+    UIClock::advanceVirtualTime(150000);
+
+    uint32_t now = UIClock::getTime();
+
+    check(UIClock::elapsed(start) == 150000, "elapsed across wrap");
+    check(UIClock::elapsed(start, now) == 150000, "interval across wrap");
+    check(UIClock::isBefore(start, now), "order across wrap");
+    check(!UIClock::isBefore(now, start), "reverse order across wrap");
+    check(UIClock::hasPassed(start + 150000), "deadline across wrap");
+    check(!UIClock::hasPassed(start + 150001), "future deadline");
+    check(UIClock::getTimeInMilliseconds() - startMilliseconds == 150, "milliseconds across wrap");
+
+    /*  Push a view and step through the transition across the wrap. The
+        transition must finish after exactly the transition time.
+    */
+    UIClock::setVirtualTime(START_TIME);
+
+    UIViewStack* stack = new UIViewStack();
+    SharedPointer<UIView> root(stack);
+    SharedPointer<UIView> first(new UITextView("First", &Font_Menu));
+    SharedPointer<UIView> second(new UITextView("Second", &Font_Menu));
+
+    stack->setWidth(128);
+    stack->setHeight(128);
+    stack->setTransitionTime(250);
+    stack->pushView(first);
+    stack->pushView(second);
+
+    SharedPointer<FrameBuffer> canvas(new UIMemoryFrameBuffer(128, 128));
+
+    uint32_t animating = 0;
+
+    for (uint32_t step = 0; step < 20; step++)
+    {
+        if (stack->fillFrameBuffer(canvas, 0, 0) == 0)
+        {
+            animating++;
+        }
+
+        UIClock::advanceVirtualTime(20000);
+    }
+
+    /* frames at 0, 20, ..., 240 ms are part of the transition */
+    check(animating == 13, "transition length");
+
+    printf("clock: %s\r\n", (pass) ? "ok" : "failed");
+    finish();
+
+    UIClock::setSource(NULL);
+}
@@ -0,0 +1,209 @@
+/* mbed
+ * Copyright (c) 2006-2015 ARM Limited
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+/*  Benchmark: bytes sent to the screen per frame with and without dirty
+    line tracking. The screen shows a counter that changes once per second,
+    which is representative for a watch face. Three screens run side by
+    side: one with dirty line tracking, one without, and one that cannot
+    address individual lines and is always sent the entire frame.
+*/
+
+#include "UIFramework/UIPlatform.h"
+
+#if UIF_HOST
+
+#include "UIFramework/UIFramework.h"
+#include "UIFramework/UIMemoryFrameBuffer.h"
+#include "UIFramework/UITextMonitorView.h"
+#include "UIFramework/host/UIHostDisplay.h"
+
+#include "uif-tools-1bit/fonts/fonts.h"
+
+#include <stdio.h>
+
+#define TEST_NAME "dirty lines"
+#include "test/UITest.h"
+
+#define BENCHMARK_PERIOD_MS 10500
+#define SCREEN_SIZE 128
+
+/*  Screen that sends the entire frame buffer for every transfer.
+*/
+static unsigned int counter = 0;
+
+class FullFrameDisplay : public UIHostDisplay
+{
+public:
+    virtual bool canSendLines(void) const
+    {
+        return false;
+    }
+};
+
+/*  Counter on a white background. The monitor only draws the text, so the
+    background is cleared first to remove the previous value.
+*/
+class CounterView : public UIView
+{
+public:
+    CounterView()
+        :   UIView(),
+            monitor(new UITextMonitorView<unsigned int>(&counter, "%u", &Font_Menu, 100))
+    {}
+
+    virtual uint32_t fillFrameBuffer(SharedPointer<FrameBuffer>& canvas, int16_t xOffset, int16_t yOffset)
+    {
+        canvas->drawRectangle(0, canvas->getWidth(), 0, canvas->getHeight(), 1);
+
+        monitor->setWidth(width);
+        monitor->setHeight(height);
+
+        return monitor->fillFrameBuffer(canvas, xOffset, yOffset);
+    }
+
+    virtual bool isDirty()
+    {
+        return UIView::isDirty() || monitor->isDirty();
+    }
+
+    virtual void clearDirty()
+    {
+        UIView::clearDirty();
+        monitor->clearDirty();
+    }
+
+private:
+    SharedPointer<UIView> monitor;
+};
+
+typedef struct {
+    const char* name;
+    UIHostDisplay* display;
+    SharedPointer<UIView> view;
+    SharedPointer<UIFramework> framework;
+} screen_t;
+
+static UIHostDisplay trackedDisplay;
+static UIHostDisplay untrackedDisplay;
+static FullFrameDisplay fullFrameDisplay;
+
+static screen_t screens[3];
+
+static void incrementCounterTask()
+{
+    counter++;
+}
+
+static void setupScreen(screen_t& screen, const char* name, UIHostDisplay* display, bool tracking)
+{
+    screen.name = name;
+    screen.display = display;
+    screen.view = SharedPointer<UIView>(new CounterView());
+
+    screen.view->setWidth(SCREEN_SIZE);
+    screen.view->setHeight(SCREEN_SIZE);
+
+    screen.framework = SharedPointer<UIFramework>(new UIFramework(*display, screen.view));
+    screen.framework->setDirtyLineTracking(tracking);
+}
+
+/*  Print statistics and check them against what the screen received.
+*/
+static uint32_t reportScreen(screen_t& screen, UIMemoryFrameBuffer& reference)
+{
+    SharedPointer<UIFramework>& framework = screen.framework;
+
+    uint32_t frames = framework->getRenderedFrames();
+    uint32_t bytes = framework->getTransferredBytes();
+
+    printf("dirty lines %s: frames: %lu sent: %lu lines: %lu bytes: %lu bytes/frame: %lu\r\n",
+           screen.name,
+           (unsigned long) frames,
+           (unsigned long) framework->getTransferredFrames(),
+           (unsigned long) framework->getTransferredLines(),
+           (unsigned long) bytes,
+           (unsigned long) ((frames > 0) ? (bytes / frames) : 0));
+
+    check(framework->getTransferredFrames() == screen.display->getFrames(), "frames sent");
+    check(framework->getTransferredLines() == screen.display->getLines(), "lines sent");
+
+    uint32_t mismatches = 0;
+
+    for (uint16_t y = 0; y < SCREEN_SIZE; y++)
+    {
+        for (uint16_t x = 0; x < SCREEN_SIZE; x++)
+        {
+            if (screen.display->getPixel(x, y) != reference.getPixel(x, y))
+            {
+                mismatches++;
+            }
+        }
+    }
+
+    check(mismatches == 0, "screen content");
+
+    return bytes;
+}
+
+static void reportTask()
+{
+    /* what the screens should show */
+    UIMemoryFrameBuffer* reference = new UIMemoryFrameBuffer(SCREEN_SIZE, SCREEN_SIZE);
+    SharedPointer<FrameBuffer> canvas(reference);
+    SharedPointer<UIView> view(new CounterView());
+
+    view->setWidth(SCREEN_SIZE);
+    view->setHeight(SCREEN_SIZE);
+    view->fillFrameBuffer(canvas, 0, 0);
+
+    uint32_t trackedBytes = reportScreen(screens[0], *reference);
+    uint32_t untrackedBytes = reportScreen(screens[1], *reference);
+    uint32_t fullFrameBytes = reportScreen(screens[2], *reference);
+
+    check(trackedBytes < untrackedBytes, "fewer bytes with tracking");
+
+    /*  Unchanged frames are skipped on the full frame screen too, but every
+        frame that is sent is sent in full.
+    */
+    check(fullFrameBytes < untrackedBytes, "unchanged frames skipped");
+    check(fullFrameDisplay.getLines() == fullFrameDisplay.getFrames() * SCREEN_SIZE, "full frames sent");
+
+    finish();
+
+    minar::Scheduler::stop();
+}
+
+void app_start(int, char *[])
+{
+    minar::Scheduler::postCallback(incrementCounterTask)
+        .period(minar::milliseconds(1000));
+
+    minar::Scheduler::postCallback(reportTask)
+        .delay(minar::milliseconds(BENCHMARK_PERIOD_MS));
+
+    setupScreen(screens[0], "on", &trackedDisplay, true);
+    setupScreen(screens[1], "off", &untrackedDisplay, false);
+    setupScreen(screens[2], "full frame", &fullFrameDisplay, true);
+}
+
+#else
+
+void app_start(int, char *[])
+{
+    /* host only */
+}
+
+#endif // UIF_HOST
@@ -0,0 +1,460 @@
+/* mbed
+ * Copyright (c) 2006-2015 ARM Limited
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+/*  Grid test: a grid of a thousand cells only creates and draws the cells
+    that intersect the view, in both directions, and draws the same pixels
+    as the grid computed directly at every scroll position. Covers a 2D
+    grid with uniform and varying cell sizes, a horizontal list, and the
+    prefetch of the next column and row in the direction of scrolling.
+*/
+
+#include "UIFramework/UIPlatform.h"
+
+#if UIF_HOST
+
+#include "UIFramework/UIMemoryFrameBuffer.h"
+#include "UIFramework/UIGridView.h"
+
+#include <stdio.h>
+#include <vector>
+
+#define TEST_NAME "grid"
+#include "test/UITest.h"
+
+#define SIZE 128
+#define CELLS 1000
+#define COLUMNS 10
+#define CELL_WIDTH 40
+#define CELL_HEIGHT 30
+
+static uint32_t created = 0;
+
+/*  Draws a pattern that depends on the cell index and the position within
+    the cell, so misplaced or clipped cells show up in the comparison.
+*/
+static uint8_t patternPixel(uint32_t index, uint32_t x, uint32_t y)
+{
+    return (index + x / 4 + y / 3) & 1;
+}
+
+class PatternView : public UIView
+{
+public:
+    PatternView(uint32_t _index)
+        :   UIView(),
+            index(_index)
+    {
+        created++;
+    }
+
+    virtual uint32_t fillFrameBuffer(SharedPointer<FrameBuffer>& canvas, int16_t xOffset, int16_t yOffset)
+    {
+        for (int32_t y = 0; y < canvas->getHeight(); y++)
+        {
+            for (int32_t x = 0; x < canvas->getWidth(); x++)
+            {
+                int32_t localX = x - xOffset;
+                int32_t localY = y - yOffset;
+
+                if ((localX < (int32_t) width) && (localY < (int32_t) height))
+                {
+                    canvas->drawPixel(x, y, patternPixel(index, localX, localY));
+                }
+            }
+        }
+
+        return UINT32_MAX;
+    }
+
+private:
+    uint32_t index;
+};
+
+class PatternArray : public UIView::Array
+{
+public:
+    PatternArray(uint32_t _size, uint32_t _columns, bool _varying)
+        :   size(_size),
+            columns(_columns),
+            varying(_varying),
+            nextId(0)
+    {}
+
+    virtual uint32_t getSize(void) const
+    {
+        return size;
+    }
+
+    virtual SharedPointer<UIView> viewAtIndex(uint32_t index) const
+    {
+        return SharedPointer<UIView>(new PatternView(idAtIndex(index)));
+    }
+
+    /* pattern of the cell, the index until cells are inserted or deleted */
+    uint32_t idAtIndex(uint32_t index) const
+    {
+        return (ids.size() > 0) ? ids[index] : index;
+    }
+
+    void insert(uint32_t first, uint32_t count)
+    {
+        makeIds();
+
+        for (uint32_t index = first; index < first + count; index++)
+        {
+            ids.insert(ids.begin() + index, nextId++);
+        }
+
+        size += count;
+        notifyInserted(first, count);
+    }
+
+    void remove(uint32_t first, uint32_t count)
+    {
+        makeIds();
+
+        ids.erase(ids.begin() + first, ids.begin() + first + count);
+
+        size -= count;
+        notifyDeleted(first, count);
+    }
+
+    void update(uint32_t index)
+    {
+        makeIds();
+
+        ids[index] = nextId++;
+
+        notifyUpdated(index, 1);
+    }
+
+    /* every cell in a row has the height of the row */
+    virtual uint32_t heightAtIndex(uint32_t index) const
+    {
+        if (columns == 0)
+        {
+            return SIZE;
+        }
+
+        return (varying) ? CELL_HEIGHT - 6 + ((index / columns) % 3) * 5 : CELL_HEIGHT;
+    }
+
+    /* called with the column for grids */
+    virtual uint32_t widthAtIndex(uint32_t index) const
+    {
+        return (varying) ? CELL_WIDTH - 10 + (index % 4) * 7 : CELL_WIDTH;
+    }
+
+    virtual uint32_t getUniformHeight(void) const
+    {
+        return (varying || (columns == 0)) ? 0 : CELL_HEIGHT;
+    }
+
+    virtual const char* getTitle(void) const
+    {
+        return "Pattern";
+    }
+
+    uint32_t size;
+    uint32_t columns;
+    bool varying;
+
+private:
+    void makeIds(void)
+    {
+        for (uint32_t index = ids.size(); index < size; index++)
+        {
+            ids.push_back(index);
+        }
+
+        nextId = (nextId > size) ? nextId : size;
+    }
+
+    std::vector<uint32_t> ids;
+    uint32_t nextId;
+};
+
+/*  Compare the grid's pixels with the grid computed directly at the grid's
+    current position.
+*/
+static uint32_t mismatches(UIMemoryFrameBuffer* buffer, UIGridView* grid, const PatternArray& array)
+{
+    uint32_t columns = (array.columns > 0) ? array.columns : array.size;
+    uint32_t rows = (array.size + columns - 1) / columns;
+    uint32_t count = 0;
+
+    for (uint32_t y = 0; y < SIZE; y++)
+    {
+        uint32_t gridY = grid->getPositionY() + y;
+        uint32_t row = 0;
+        uint32_t top = 0;
+
+        while ((row < rows) && (top + array.heightAtIndex(row * columns) <= gridY))
+        {
+            top += array.heightAtIndex(row * columns);
+            row++;
+        }
+
+        for (uint32_t x = 0; x < SIZE; x++)
+        {
+            uint32_t gridX = grid->getPositionX() + x;
+            uint32_t column = 0;
+            uint32_t left = 0;
+
+            while ((column < columns) && (left + array.widthAtIndex(column) <= gridX))
+            {
+                left += array.widthAtIndex(column);
+                column++;
+            }
+
+            uint32_t index = row * columns + column;
+            uint8_t expected = 1;
+
+            if ((row < rows) && (column < columns) && (index < array.size))
+            {
+                expected = patternPixel(array.idAtIndex(index), gridX - left, gridY - top);
+            }
+
+            count += (buffer->getPixel(x, y) != expected) ? 1 : 0;
+        }
+    }
+
+    return count;
+}
+
+static void testGrid(bool varying, uint32_t size)
+{
+    PatternArray* patterns = new PatternArray(size, COLUMNS, varying);
+    SharedPointer<UIView::Array> array(patterns);
+    UIGridView* grid = new UIGridView(array, COLUMNS);
+    SharedPointer<UIView> view(grid);
+
+    UIMemoryFrameBuffer* buffer = new UIMemoryFrameBuffer(SIZE, SIZE);
+    SharedPointer<FrameBuffer> canvas(buffer);
+
+    created = 0;
+    view->fillFrameBuffer(canvas, 0, 0);
+
+    uint32_t first = created;
+    uint32_t errors = mismatches(buffer, grid, *patterns);
+
+    if (!varying)
+    {
+        /* 4 columns of 40 and 5 rows of 30 cover 128 x 128 */
+        check(first == 20, "only visible cells created");
+        check(grid->getRenderedCells() == 20, "only visible cells rendered");
+    }
+
+    static const int32_t steps[][2] = {
+        { -17, 0 }, { 0, -23 }, { -31, -29 }, { 13, 7 }, { -100, -250 }, { -100000, -100000 }, { 55, 66 }
+    };
+
+    for (uint32_t step = 0; step < sizeof(steps) / sizeof(steps[0]); step++)
+    {
+        grid->scrollPx(steps[step][0], steps[step][1]);
+        view->fillFrameBuffer(canvas, 0, 0);
+        view->clearDirty();
+
+        errors += mismatches(buffer, grid, *patterns);
+    }
+
+    printf("grid: %s: cells: %lu created: %lu first frame: %lu mismatches: %lu\r\n",
+           (varying) ? "varying" : "uniform",
+           (unsigned long) size,
+           (unsigned long) created,
+           (unsigned long) first,
+           (unsigned long) errors);
+
+    check(errors == 0, "grid pixels");
+    check(created < size / 4, "cells virtualized");
+    check(grid->getRows() == (size + COLUMNS - 1) / COLUMNS, "rows");
+    check(grid->getColumns() == COLUMNS, "columns");
+
+    /* scrolled to the far end and then back by 55, 66 */
+    uint32_t totalWidth = 0;
+
+    for (uint32_t column = 0; column < COLUMNS; column++)
+    {
+        totalWidth += patterns->widthAtIndex(column);
+    }
+
+    check(grid->getPositionX() == totalWidth - SIZE - 55, "clamped horizontally");
+}
+
+static void testHorizontalList(void)
+{
+    PatternArray* patterns = new PatternArray(500, 0, true);
+    SharedPointer<UIView::Array> array(patterns);
+    UIGridView* grid = new UIGridView(array);
+    SharedPointer<UIView> view(grid);
+
+    UIMemoryFrameBuffer* buffer = new UIMemoryFrameBuffer(SIZE, SIZE);
+    SharedPointer<FrameBuffer> canvas(buffer);
+
+    created = 0;
+    view->fillFrameBuffer(canvas, 0, 0);
+
+    uint32_t errors = mismatches(buffer, grid, *patterns);
+
+    for (uint32_t frame = 0; frame < 100; frame++)
+    {
+        grid->scrollPx(-37, -5);
+        view->fillFrameBuffer(canvas, 0, 0);
+        view->clearDirty();
+
+        errors += mismatches(buffer, grid, *patterns);
+    }
+
+    printf("grid: list: cells: %lu created: %lu position: %lu mismatches: %lu\r\n",
+           (unsigned long) patterns->size,
+           (unsigned long) created,
+           (unsigned long) grid->getPositionX(),
+           (unsigned long) errors);
+
+    check(grid->getRows() == 1, "list has one row");
+    check(grid->getColumns() == 500, "list has a column per cell");
+    check(grid->getPositionY() == 0, "list does not scroll vertically");
+    check(grid->getPositionX() == 3700, "list scrolled");
+    check(errors == 0, "list pixels");
+    check(created < 250, "list virtualized");
+}
+
+static void testPrefetch(void)
+{
+    PatternArray* patterns = new PatternArray(CELLS, COLUMNS, false);
+    SharedPointer<UIView::Array> array(patterns);
+    UIGridView* grid = new UIGridView(array, COLUMNS, 64);
+    SharedPointer<UIView> view(grid);
+
+    UIMemoryFrameBuffer* buffer = new UIMemoryFrameBuffer(SIZE, SIZE);
+    SharedPointer<FrameBuffer> canvas(buffer);
+
+    view->fillFrameBuffer(canvas, 0, 0);
+
+    /* columns 0 - 3 visible, column 4 is next to the right */
+    grid->scrollPx(-8, 0);
+    view->fillFrameBuffer(canvas, 0, 0);
+    minar::Scheduler::runUntil(minar::platform::getTime() + 16000);
+
+    bool right = true;
+
+    for (uint32_t row = 0; row < 5; row++)
+    {
+        right = right && (grid->getCellCache().peek(row * COLUMNS + 4) != NULL);
+    }
+
+    /* rows 0 - 4 visible, row 5 is next going down */
+    grid->scrollPx(0, -8);
+    view->fillFrameBuffer(canvas, 0, 0);
+    minar::Scheduler::runUntil(minar::platform::getTime() + 16000);
+
+    bool down = true;
+
+    for (uint32_t column = 0; column < 4; column++)
+    {
+        down = down && (grid->getCellCache().peek(5 * COLUMNS + column) != NULL);
+    }
+
+    /* the prefetched cells are drawn without new misses */
+    uint32_t before = created;
+
+    grid->scrollPx(-30, -20);
+    view->fillFrameBuffer(canvas, 0, 0);
+
+    printf("grid: prefetch: right: %d down: %d created on scroll: %lu\r\n",
+           right, down, (unsigned long) (created - before));
+
+    check(right, "next column prefetched");
+    check(down, "next row prefetched");
+    check(mismatches(buffer, grid, *patterns) == 0, "prefetched pixels");
+}
+
+/*  The grid listens to its array: cells inserted, deleted or updated are
+    shown without reloading the grid, and cached cells move with their
+    index instead of being created again.
+*/
+static void testChanges(void)
+{
+    PatternArray* patterns = new PatternArray(CELLS, COLUMNS, true);
+    SharedPointer<UIView::Array> array(patterns);
+    UIGridView* grid = new UIGridView(array, COLUMNS);
+    SharedPointer<UIView> view(grid);
+
+    UIMemoryFrameBuffer* buffer = new UIMemoryFrameBuffer(SIZE, SIZE);
+    SharedPointer<FrameBuffer> canvas(buffer);
+
+    grid->scrollPx(-20, -100);
+    view->fillFrameBuffer(canvas, 0, 0);
+    view->clearDirty();
+
+    uint32_t errors = 0;
+
+    /* before the visible cells, all of them move to the next cell */
+    created = 0;
+    patterns->insert(3, 1);
+    check(view->isDirty(), "insert marks grid");
+
+    view->fillFrameBuffer(canvas, 0, 0);
+    view->clearDirty();
+
+    uint32_t insertCreated = created;
+    errors += mismatches(buffer, grid, *patterns);
+
+    patterns->remove(0, 12);
+    view->fillFrameBuffer(canvas, 0, 0);
+    view->clearDirty();
+    errors += mismatches(buffer, grid, *patterns);
+
+    /* a visible cell with new content */
+    created = 0;
+    patterns->update(grid->getPositionY() / CELL_HEIGHT * COLUMNS + 2);
+    view->fillFrameBuffer(canvas, 0, 0);
+    view->clearDirty();
+
+    uint32_t updateCreated = created;
+    errors += mismatches(buffer, grid, *patterns);
+
+    printf("grid: changes: created on insert: %lu on update: %lu mismatches: %lu\r\n",
+           (unsigned long) insertCreated,
+           (unsigned long) updateCreated,
+           (unsigned long) errors);
+
+    check(errors == 0, "changed grid pixels");
+    check(grid->getRows() == (CELLS - 11 + COLUMNS - 1) / COLUMNS, "rows after changes");
+    check(insertCreated < 10, "insert reuses moved cells");
+    check(updateCreated == 1, "update fetches one cell");
+    check(array->hasListener(grid), "grid listens to array");
+}
+
+void app_start(int, char *[])
+{
+    testGrid(false, CELLS);
+    testGrid(true, CELLS - 5);
+    testHorizontalList();
+    testPrefetch();
+    testChanges();
+
+    finish();
+}
+
+#else
+
+void app_start(int, char *[])
+{
+    /* host only */
+}
+
+#endif // UIF_HOST
@@ -0,0 +1,502 @@
+/* mbed
+ * Copyright (c) 2006-2015 ARM Limited
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+/*  Row height index test: the table must scroll to the same rows as a
+    plain linear walk over the heights, and the number of height lookups
+    per scroll must not grow with the size of the table. Tables declaring a
+    uniform row height must behave the same without any lookups. The
+    benchmark scales the table from 10 to 1,000,000 rows.
+*/
+
+#include "UIFramework/UIPlatform.h"
+
+#include "UIFramework/UIHeightIndex.h"
+#include "UIFramework/UITableView.h"
+
+#include <stdio.h>
+
+#define TEST_NAME "heightindex"
+#include "test/UITest.h"
+
+#define TABLE_HEIGHT 128
+#define OPERATIONS 1000
+
+/*  Deterministic pseudo random numbers.
+*/
+static uint32_t seed = 1;
+
+static uint32_t nextRandom(uint32_t range)
+{
+    seed = seed * 1103515245 + 12345;
+
+    return ((seed >> 8) % range);
+}
+
+/*  Rows that count how often they are asked for their height. Rows vary
+    in height unless a fixed height is given, which is only declared as
+    uniform when asked to.
+*/
+class CountingArray : public UITestArray
+{
+public:
+    CountingArray(uint32_t _size, uint32_t _fixedHeight = 0, bool _declared = false)
+        :   UITestArray("Counting", _size, _fixedHeight),
+            fixedHeight(_fixedHeight),
+            declared(_declared),
+            lookups(0)
+    {}
+
+    virtual SharedPointer<UIView> viewAtIndex(uint32_t index) const
+    {
+        (void) index;
+
+        /* the table is never drawn */
+        return SharedPointer<UIView>();
+    }
+
+    virtual uint32_t heightAtIndex(uint32_t index) const
+    {
+        lookups++;
+
+        return (fixedHeight) ? fixedHeight : 8 + ((index * 7) % 13);
+    }
+
+    virtual uint32_t getUniformHeight(void) const
+    {
+        return (declared) ? fixedHeight : 0;
+    }
+
+    uint32_t fixedHeight;
+    bool declared;
+    mutable uint32_t lookups;
+};
+
+/*  Rows with heights that can be inserted and deleted.
+*/
+class EditableArray : public UITestArray
+{
+public:
+    EditableArray()
+        :   UITestArray("Editable", 0, 0),
+            lookups(0)
+    {}
+
+    virtual SharedPointer<UIView> viewAtIndex(uint32_t index) const
+    {
+        (void) index;
+
+        return SharedPointer<UIView>();
+    }
+
+    virtual uint32_t heightAtIndex(uint32_t index) const
+    {
+        lookups++;
+
+        return heights[index];
+    }
+
+    void insert(uint32_t first, uint32_t count, uint32_t height)
+    {
+        for (uint32_t idx = rows; idx > first; idx--)
+        {
+            heights[idx + count - 1] = heights[idx - 1];
+        }
+
+        for (uint32_t idx = first; idx < first + count; idx++)
+        {
+            heights[idx] = (height) ? height : 1 + nextRandom(30);
+        }
+
+        rows += count;
+    }
+
+    void remove(uint32_t first, uint32_t count)
+    {
+        for (uint32_t idx = first; idx + count < rows; idx++)
+        {
+            heights[idx] = heights[idx + count];
+        }
+
+        rows -= count;
+    }
+
+    uint32_t heights[2000];
+    mutable uint32_t lookups;
+};
+
+/*  Linear reference: the row at a pixel position and the offset into it.
+*/
+static uint32_t linearRow(const UIView::Array& array, uint32_t position, uint32_t& offset)
+{
+    uint32_t sum = 0;
+    uint32_t row = 0;
+
+    for (; row + 1 < array.getSize(); row++)
+    {
+        uint32_t height = array.heightAtIndex(row);
+
+        if (sum + height > position)
+        {
+            break;
+        }
+
+        sum += height;
+    }
+
+    offset = position - sum;
+
+    return row;
+}
+
+static void testIndex(void)
+{
+    CountingArray array(1000);
+    UIHeightIndex index;
+
+    index.build(array);
+
+    uint32_t heights[1000];
+    uint32_t total = 0;
+
+    for (uint32_t idx = 0; idx < 1000; idx++)
+    {
+        heights[idx] = array.heightAtIndex(idx);
+        total += heights[idx];
+    }
+
+    check(index.getTotalHeight() == total, "total height");
+
+    /* change some rows, including to zero height */
+    for (uint32_t idx = 0; idx < 200; idx++)
+    {
+        uint32_t row = nextRandom(1000);
+        uint32_t height = nextRandom(40);
+
+        index.setHeight(row, height);
+        heights[row] = height;
+    }
+
+    uint32_t position = 0;
+
+    for (uint32_t row = 0; row < 1000; row++)
+    {
+        check(index.getPosition(row) == position, "position");
+        check(index.getHeight(row) == heights[row], "height");
+
+        if (heights[row] > 0)
+        {
+            uint32_t offset = 0;
+
+            check(index.findRow(position + heights[row] - 1, &offset) == row, "find row");
+            check(offset == heights[row] - 1, "find offset");
+        }
+
+        position += heights[row];
+    }
+
+    uint32_t offset = 0;
+
+    check(index.findRow(position + 5, &offset) == 999, "find past end");
+    check(offset == position + 5 - index.getPosition(999), "offset past end");
+
+    /* uniform rows need no lookups until one of them changes */
+    CountingArray uniform(1000, 12, true);
+
+    index.build(uniform);
+
+    check(uniform.lookups == 0, "uniform build");
+    check(index.getUniformHeight() == 12, "uniform height");
+    check(index.findRow(12 * 500 + 3, &offset) == 500, "uniform find row");
+    check(offset == 3, "uniform find offset");
+
+    index.setHeight(10, 20);
+
+    check(index.getUniformHeight() == 0, "uniform changed");
+    check(index.getPosition(10) == 12 * 10, "changed position above");
+    check(index.getPosition(11) == 12 * 10 + 20, "changed position below");
+    check(index.getTotalHeight() == 12 * 999 + 20, "changed total");
+
+    /* rows that share a height without the array saying so need no tree */
+    CountingArray undeclared(1000, 12, false);
+
+    index.build(undeclared);
+
+    check(undeclared.lookups == 1000, "undeclared build");
+    check(index.getUniformHeight() == 12, "undeclared uniform height");
+    check(index.findRow(12 * 500 + 3, &offset) == 500, "undeclared find row");
+    check(offset == 3, "undeclared find offset");
+
+    index.setHeight(10, 20);
+
+    check(index.getPosition(11) == 12 * 10 + 20, "undeclared changed");
+}
+
+/*  Rows inserted and deleted anywhere must give the same index as building
+    it again, while only the new rows are read from the array.
+*/
+static void testChanges(void)
+{
+    EditableArray array;
+    UIHeightIndex index;
+
+    /* start out uniform, until a row of another height is added */
+    array.insert(0, 100, 12);
+    index.build(array);
+
+    for (uint32_t step = 0; step < 400; step++)
+    {
+        uint32_t size = array.getSize();
+        uint32_t action = nextRandom(4);
+        uint32_t first = (action == 0) ? size : nextRandom(size + 1);
+        uint32_t count = 1 + nextRandom(5);
+
+        array.lookups = 0;
+
+        if ((action < 3) || (size < 10))
+        {
+            if (size + count > 2000)
+            {
+                continue;
+            }
+
+            array.insert(first, count, (step < 50) ? 12 : 0);
+            index.insert(first, count, array);
+
+            /* leaving the uniform height reads the new rows once more */
+            check(array.lookups <= 2 * count, "insert reads new rows only");
+        }
+        else
+        {
+            if (first + count > size)
+            {
+                first = size - count;
+            }
+
+            array.remove(first, count);
+            index.remove(first, count);
+
+            check(array.lookups == 0, "remove reads no rows");
+        }
+
+        check(index.getSize() == array.getSize(), "size after change");
+
+        /* compare with a walk over the heights */
+        uint32_t position = 0;
+        bool same = true;
+
+        for (uint32_t row = 0; row < array.getSize(); row++)
+        {
+            same = same && (index.getPosition(row) == position);
+
+            uint32_t offset;
+
+            same = same && (index.findRow(position, &offset) == row) && (offset == 0);
+
+            position += array.heights[row];
+        }
+
+        same = same && (index.getTotalHeight() == position);
+
+        check(same, "positions after change");
+    }
+
+    check(index.getUniformHeight() == 0, "changes left uniform rows");
+}
+
+/*  A table declaring a uniform height must end up at the same rows as one
+    that has to ask for every height.
+*/
+static void testUniformTable(void)
+{
+    SharedPointer<UIView::Array> plainArray(new CountingArray(300, 14, false));
+    CountingArray* uniformArray = new CountingArray(300, 14, true);
+    SharedPointer<UIView::Array> uniformShared(uniformArray);
+
+    UITableView plain(plainArray);
+    UITableView uniform(uniformShared);
+
+    plain.setWidth(128);
+    plain.setHeight(TABLE_HEIGHT);
+    uniform.setWidth(128);
+    uniform.setHeight(TABLE_HEIGHT);
+
+    for (uint32_t idx = 0; idx < OPERATIONS; idx++)
+    {
+        if (idx % 8 == 0)
+        {
+            uint32_t row = nextRandom(300);
+
+            plain.setCenter(row);
+            uniform.setCenter(row);
+        }
+        else
+        {
+            int32_t pixels = (int32_t) nextRandom(1000) - 500;
+
+            plain.scrollPx(pixels);
+            plain.updateTable();
+            uniform.scrollPx(pixels);
+            uniform.updateTable();
+        }
+
+        check(plain.getPixels() == uniform.getPixels(), "uniform pixels");
+        check(plain.getFirstIndex() == uniform.getFirstIndex(), "uniform first row");
+        check(plain.getFirstOverflow() == uniform.getFirstOverflow(), "uniform overflow");
+        check(plain.getMiddleIndex() == uniform.getMiddleIndex(), "uniform middle row");
+        check(plain.getLastIndex() == uniform.getLastIndex(), "uniform last row");
+    }
+
+    check(uniformArray->lookups == 0, "uniform table lookups");
+}
+
+/*  Scroll a table at random and compare with the linear reference.
+*/
+static void testTable(void)
+{
+    CountingArray* array = new CountingArray(500);
+    SharedPointer<UIView::Array> shared(array);
+
+    UITableView table(shared);
+
+    table.setWidth(128);
+    table.setHeight(TABLE_HEIGHT);
+
+    uint32_t total = 0;
+
+    for (uint32_t idx = 0; idx < array->getSize(); idx++)
+    {
+        total += array->heightAtIndex(idx);
+    }
+
+    int32_t position = 0;
+
+    for (uint32_t idx = 0; idx < OPERATIONS; idx++)
+    {
+        int32_t pixels = (int32_t) nextRandom(2000) - 1000;
+
+        table.scrollPx(pixels);
+        table.updateTable();
+
+        /* positive pixels move towards the top of the table */
+        position -= pixels;
+
+        if (position > (int32_t) (total - TABLE_HEIGHT))
+        {
+            position = total - TABLE_HEIGHT;
+        }
+
+        if (position < 0)
+        {
+            position = 0;
+        }
+
+        uint32_t offset = 0;
+        uint32_t row = linearRow(*array, position, offset);
+
+        check(table.getPixels() == -position, "table pixels");
+        check(table.getFirstIndex() == row, "table row");
+        check(table.getFirstOverflow() == offset, "table overflow");
+    }
+
+    /* center on a row */
+    table.setCenter(250);
+
+    uint32_t offset = 0;
+    uint32_t center = -table.getPixels() + TABLE_HEIGHT / 2;
+
+    check(linearRow(*array, center, offset) == 250, "center row");
+}
+
+/*  Scroll a table at random and report how often the heights were read.
+*/
+static void benchmarkTable(CountingArray* array, const char* name)
+{
+    uint32_t rows = array->getSize();
+    SharedPointer<UIView::Array> shared(array);
+
+    UITableView table(shared);
+
+    table.setWidth(128);
+    table.setHeight(TABLE_HEIGHT);
+    table.getPixels();
+
+    uint32_t build = array->lookups;
+
+    array->lookups = 0;
+
+    for (uint32_t idx = 0; idx < OPERATIONS; idx++)
+    {
+        switch (idx % 4)
+        {
+            case 0:
+                table.setCenter(nextRandom(rows));
+                break;
+            case 1:
+                table.scrollPx((int32_t) nextRandom(4000) - 2000);
+                table.updateTable();
+                break;
+            case 2:
+                table.setPixels(-(int32_t) nextRandom(rows * 8));
+                break;
+            default:
+                table.getPixels();
+                table.getMiddleIndex();
+                table.getLastIndex();
+                break;
+        }
+    }
+
+    printf("heightindex: %-8s %7lu %7lu %lu\r\n",
+           name,
+           (unsigned long) rows,
+           (unsigned long) build,
+           (unsigned long) array->lookups);
+
+    if (array->getUniformHeight() > 0)
+    {
+        check((build == 0) && (array->lookups == 0), "uniform rows are never read");
+    }
+    else
+    {
+        check(build == rows, "build reads every row once");
+        check(array->lookups <= 10 * OPERATIONS, "lookups independent of rows");
+    }
+}
+
+/*  Height lookups after the index has been built. Only the rows on screen
+    are read, however long the table.
+*/
+static void benchmark(void)
+{
+    printf("heightindex: rows build lookups per %d operations\r\n", OPERATIONS);
+
+    for (uint32_t rows = 10; rows <= 1000000; rows *= 10)
+    {
+        benchmarkTable(new CountingArray(rows), "variable");
+        benchmarkTable(new CountingArray(rows, 16, true), "uniform");
+    }
+}
+
+void app_start(int, char *[])
+{
+    testIndex();
+    testChanges();
+    testTable();
+    testUniformTable();
+    benchmark();
+
+    finish();
+}
@@ -0,0 +1,192 @@
+/* mbed
+ * Copyright (c) 2006-2015 ARM Limited
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+/*  Host benchmark: a kinetic table inside a view stack, driven by a scripted
+    sequence of touch events on the virtual clock. Reports frame telemetry
+    and the amount of data sent to the simulated display.
+
+    Usage: host [frame prefix]
+    If a prefix is given every frame is written to <prefix>NNNNN.pbm.
+*/
+
+#include "UIFramework/UIPlatform.h"
+
+#if UIF_HOST
+
+#include "UIFramework/UIFramework.h"
+#include "UIFramework/UITableKineticView.h"
+#include "UIFramework/UITextView.h"
+#include "UIFramework/UIViewStack.h"
+#include "UIFramework/host/UIHostDisplay.h"
+
+#include "uif-tools-1bit/fonts/fonts.h"
+
+#include <stdio.h>
+
+#define NUMBER_OF_ROWS 100
+
+class TextArray : public UIView::Array
+{
+public:
+    TextArray(uint32_t _size)
+        :   size(_size)
+    {}
+
+    virtual uint32_t getSize(void) const
+    {
+        return size;
+    }
+
+    virtual SharedPointer<UIView> viewAtIndex(uint32_t index) const
+    {
+        char buffer[16];
+
+        snprintf(buffer, sizeof(buffer), "Row %lu", (unsigned long) index);
+
+        std::string text(buffer);
+
+        return SharedPointer<UIView>(new UITextView(text, &Font_Menu));
+    }
+
+    virtual uint32_t heightAtIndex(uint32_t index) const
+    {
+        (void) index;
+
+        return 30;
+    }
+
+    virtual uint32_t getUniformHeight(void) const
+    {
+        return 30;
+    }
+
+    virtual uint32_t widthAtIndex(uint32_t index) const
+    {
+        (void) index;
+
+        return 128;
+    }
+
+    virtual const char* getTitle(void) const
+    {
+        return "Rows";
+    }
+
+    virtual uint32_t getLastIndex(void) const
+    {
+        return size - 1;
+    }
+
+private:
+    uint32_t size;
+};
+
+static UIHostDisplay display;
+static SharedPointer<UIFramework> uiFramework;
+static UIViewStack* stack;
+static UITableKineticView* table;
+
+/* scripted input */
+static void pressTask()
+{
+    table->sliderPressed();
+    table->sliderChangedWithSpeed(-40);
+    table->sliderReleasedWithSpeed(-60);
+}
+
+static void pushTask()
+{
+    SharedPointer<UIView> view(new UITextView("Details", &Font_Menu));
+
+    stack->pushView(view);
+
+    uiFramework->wakeupTask();
+}
+
+static void popTask()
+{
+    stack->popView();
+
+    uiFramework->wakeupTask();
+}
+
+static void reportTask()
+{
+    const UIFrameTelemetry& telemetry = uiFramework->getTelemetry();
+
+    printf("frames: %lu unchanged: %lu dropped: %lu coalesced: %lu wakeups: %lu\r\n",
+           (unsigned long) telemetry.getFrames(),
+           (unsigned long) telemetry.getUnchangedFrames(),
+           (unsigned long) telemetry.getDroppedFrames(),
+           (unsigned long) telemetry.getCoalescedFrames(),
+           (unsigned long) telemetry.getWakeups());
+
+    printf("elided: %lu\r\n", (unsigned long) uiFramework->getElidedFrames());
+
+    printf("render max: %lu us transfer max: %lu us latency max: %lu us\r\n",
+           (unsigned long) telemetry.getMaximum(UIFrameTelemetry::HISTOGRAM_RENDER),
+           (unsigned long) telemetry.getMaximum(UIFrameTelemetry::HISTOGRAM_TRANSFER),
+           (unsigned long) telemetry.getMaximum(UIFrameTelemetry::HISTOGRAM_LATENCY));
+
+    printf("display: frames: %lu lines: %lu bytes: %lu\r\n",
+           (unsigned long) display.getFrames(),
+           (unsigned long) display.getLines(),
+           (unsigned long) uiFramework->getTransferredBytes());
+
+    printf("pixels: rendered lines: %lu writes: %lu overdraw: %lu\r\n",
+           (unsigned long) uiFramework->getRenderedLines(),
+           (unsigned long) display.getPixelWrites(),
+           (unsigned long) display.getOverdraw());
+
+    minar::Scheduler::stop();
+}
+
+void app_start(int argc, char* argv[])
+{
+    if (argc > 1)
+    {
+        display.setDumpPrefix(argv[1]);
+    }
+
+    SharedPointer<UIView::Array> array(new TextArray(NUMBER_OF_ROWS));
+
+    table = new UITableKineticView(array, 128, 128, 0);
+    SharedPointer<UIView> tableView(table);
+
+    stack = new UIViewStack();
+    SharedPointer<UIView> root(stack);
+
+    stack->setWidth(128);
+    stack->setHeight(128);
+    stack->pushView(tableView);
+
+    uiFramework = SharedPointer<UIFramework>(new UIFramework(display, root));
+    uiFramework->setDirtyLineTracking(true);
+
+    minar::Scheduler::postCallback(pressTask).delay(minar::milliseconds(500));
+    minar::Scheduler::postCallback(pushTask).delay(minar::milliseconds(3000));
+    minar::Scheduler::postCallback(popTask).delay(minar::milliseconds(4000));
+    minar::Scheduler::postCallback(reportTask).delay(minar::milliseconds(6000));
+}
+
+#else
+
+void app_start(int, char *[])
+{
+    /* host only */
+}
+
+#endif // UIF_HOST
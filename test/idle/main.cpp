@@ -0,0 +1,88 @@
+/* mbed
+ * Copyright (c) 2006-2015 ARM Limited
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+/*  Idle frame elision test: a watch face with a monitor that polls a
+    variable every second. The variable changes once, so only two frames
+    need rendering; every other wakeup must be elided.
+*/
+
+#include "UIFramework/UIPlatform.h"
+
+#if UIF_HOST
+
+#include "UIFramework/UIFramework.h"
+#include "UIFramework/UITextMonitorView.h"
+#include "UIFramework/host/UIHostDisplay.h"
+
+#include "uif-tools-1bit/fonts/fonts.h"
+
+#include <stdio.h>
+
+#define TEST_NAME "idle"
+#include "test/UITest.h"
+
+#define TEST_DURATION_MS 10000
+
+static UIHostDisplay display;
+static SharedPointer<UIFramework> uiFramework;
+static uint32_t seconds = 0;
+
+static void tickTask()
+{
+    seconds++;
+}
+
+static void reportTask()
+{
+    uint32_t rendered = uiFramework->getRenderedFrames();
+    uint32_t elided = uiFramework->getElidedFrames();
+
+    printf("idle: rendered: %lu elided: %lu transferred: %lu\r\n",
+           (unsigned long) rendered,
+           (unsigned long) elided,
+           (unsigned long) uiFramework->getTransferredFrames());
+
+    /* the initial frame and the one showing the changed value */
+    check(rendered == 2, "rendered frames");
+    check(elided >= (TEST_DURATION_MS / 1000) - 2, "elided frames");
+
+    finish();
+
+    minar::Scheduler::stop();
+}
+
+void app_start(int, char *[])
+{
+    SharedPointer<UIView> view(new UITextMonitorView<uint32_t>(&seconds, "%lu", &Font_Menu, 1000));
+
+    view->setWidth(128);
+    view->setHeight(128);
+
+    uiFramework = SharedPointer<UIFramework>(new UIFramework(display, view));
+    uiFramework->setIdleFrameElision(true);
+
+    minar::Scheduler::postCallback(tickTask).delay(minar::milliseconds(2500));
+    minar::Scheduler::postCallback(reportTask).delay(minar::milliseconds(TEST_DURATION_MS));
+}
+
+#else
+
+void app_start(int, char *[])
+{
+    /* host only */
+}
+
+#endif // UIF_HOST
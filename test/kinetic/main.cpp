@@ -0,0 +1,263 @@
+/* mbed
+ * Copyright (c) 2006-2015 ARM Limited
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+/*  Kinetic test: a fling must follow the same trajectory whatever the
+    frame rate. The physics are driven at several fixed and irregular
+    frame rates, with a stall, and must give the same offsets at the times
+    the runs have in common, through coasting, the rubber band and the snap
+    back. Two kinetic tables drawn at 16 ms and 48 ms, one with a stall,
+    must scroll and come to rest the same way. Prints the trajectory.
+*/
+
+#include "UIFramework/UIPlatform.h"
+
+#if UIF_HOST
+
+#include "UIFramework/UIKineticPhysics.h"
+#include "UIFramework/UIMemoryFrameBuffer.h"
+#include "UIFramework/UITableKineticView.h"
+
+#include <stdio.h>
+
+#define TEST_NAME "kinetic"
+#include "test/UITest.h"
+
+#define CHECKPOINT_US 48000
+#define CHECKPOINTS 40
+#define ROWS 300
+#define ROW_HEIGHT 20
+#define SIZE 128
+
+/*  Run a fling from the offset, with frames at the given times, snapping
+    back into the bounds when the table comes to rest outside them. The
+    offset is recorded at every checkpoint, all of which must be frames.
+*/
+static void trajectory(const uint32_t* frames, uint32_t count, int32_t offset, int32_t speed, int32_t* checkpoints)
+{
+    UIKineticPhysics physics;
+
+    physics.setBounds(0, -5000);
+    physics.fling(speed);
+
+    uint32_t time = 0;
+
+    for (uint32_t frame = 0; frame < count; frame++)
+    {
+        offset += physics.advance(frames[frame] - time, offset);
+        time = frames[frame];
+
+        if (!physics.isMoving() && (offset > 0))
+        {
+            physics.snap(-offset);
+            offset += physics.advance(0, offset);
+        }
+
+        if ((time % CHECKPOINT_US) == 0)
+        {
+            checkpoints[time / CHECKPOINT_US - 1] = offset;
+        }
+    }
+}
+
+/*  Frames every period, plus one at each checkpoint, skipping the frames
+    in [stallFrom, stallTo).
+*/
+static uint32_t makeFrames(uint32_t* frames, uint32_t period, uint32_t jitter, uint32_t stallFrom, uint32_t stallTo)
+{
+    uint32_t count = 0;
+    uint32_t time = 0;
+    uint32_t seed = 99;
+
+    while (time < CHECKPOINTS * CHECKPOINT_US)
+    {
+        uint32_t step = period;
+
+        if (jitter > 0)
+        {
+            seed = seed * 1103515245 + 12345;
+            step += (seed >> 8) % jitter;
+        }
+
+        uint32_t next = time + step;
+        uint32_t checkpoint = (time / CHECKPOINT_US + 1) * CHECKPOINT_US;
+
+        time = (next < checkpoint) ? next : checkpoint;
+
+        if ((time % CHECKPOINT_US == 0) || (time < stallFrom) || (time >= stallTo))
+        {
+            frames[count++] = time;
+        }
+    }
+
+    return count;
+}
+
+static void testPhysics(int32_t offset, int32_t speed, const char* name)
+{
+    static uint32_t frames[CHECKPOINTS * CHECKPOINT_US / 1000 + CHECKPOINTS];
+
+    int32_t reference[CHECKPOINTS];
+    int32_t other[CHECKPOINTS];
+
+    /* 1 ms frames integrate one step per frame */
+    uint32_t count = makeFrames(frames, 1000, 0, 0, 0);
+    trajectory(frames, count, offset, speed, reference);
+
+    static const uint32_t periods[][4] = {
+        /* period, jitter, stall from, stall to */
+        { 16000, 0, 0, 0 },
+        { 16667, 0, 0, 0 },
+        { 33333, 0, 0, 0 },
+        { 5000, 40000, 0, 0 },
+        { 16000, 0, 100000, 500000 },
+        { 997, 0, 0, 0 }
+    };
+
+    uint32_t mismatches = 0;
+
+    for (uint32_t run = 0; run < sizeof(periods) / sizeof(periods[0]); run++)
+    {
+        count = makeFrames(frames, periods[run][0], periods[run][1], periods[run][2], periods[run][3]);
+        trajectory(frames, count, offset, speed, other);
+
+        for (uint32_t checkpoint = 0; checkpoint < CHECKPOINTS; checkpoint++)
+        {
+            mismatches += (other[checkpoint] != reference[checkpoint]) ? 1 : 0;
+        }
+    }
+
+    printf("kinetic: %s:", name);
+
+    for (uint32_t checkpoint = 0; checkpoint < CHECKPOINTS; checkpoint += 4)
+    {
+        printf(" %ld", (long) reference[checkpoint]);
+    }
+
+    printf(" mismatches: %lu\r\n", (unsigned long) mismatches);
+
+    check(mismatches == 0, name);
+    check(reference[0] != offset, "fling moves");
+    check(reference[CHECKPOINTS - 1] == reference[CHECKPOINTS - 2], "fling comes to rest");
+    check((reference[CHECKPOINTS - 1] <= 0) && (reference[CHECKPOINTS - 1] >= -5000), "rest within bounds");
+}
+
+class RowView : public UIView
+{
+public:
+    virtual uint32_t fillFrameBuffer(SharedPointer<FrameBuffer>& canvas, int16_t xOffset, int16_t yOffset)
+    {
+        (void) xOffset;
+        (void) yOffset;
+
+        canvas->drawRectangle(0, canvas->getWidth(), 0, canvas->getHeight(), 0);
+
+        return UINT32_MAX;
+    }
+};
+
+class RowArray : public UITestArray
+{
+public:
+    RowArray()
+        :   UITestArray("Rows", ROWS, ROW_HEIGHT, SIZE)
+    {}
+
+    virtual SharedPointer<UIView> viewAtIndex(uint32_t index) const
+    {
+        (void) index;
+
+        return SharedPointer<UIView>(new RowView());
+    }
+};
+
+/*  One table drawn every 16 ms, the other every 48 ms and not at all for
+    a while after the fling. Both must be at the same offset whenever both
+    are drawn, and come to rest on the same row.
+*/
+static void testTables(void)
+{
+    SharedPointer<UIView::Array> array(new RowArray());
+
+    UITableKineticView* fast = new UITableKineticView(array, SIZE, SIZE, 0);
+    UITableKineticView* slow = new UITableKineticView(array, SIZE, SIZE, 0);
+    SharedPointer<UIView> fastView(fast);
+    SharedPointer<UIView> slowView(slow);
+
+    UIMemoryFrameBuffer* buffer = new UIMemoryFrameBuffer(SIZE, SIZE);
+    SharedPointer<FrameBuffer> canvas(buffer);
+
+    fastView->fillFrameBuffer(canvas, 0, 0);
+    slowView->fillFrameBuffer(canvas, 0, 0);
+
+    uint32_t start = minar::platform::getTime();
+
+    fast->sliderReleasedWithSpeed(-73);
+    slow->sliderReleasedWithSpeed(-73);
+
+    uint32_t mismatches = 0;
+    uint32_t moving = 0;
+    int32_t previous = fast->getPixels();
+
+    for (uint32_t frame = 1; frame <= 150; frame++)
+    {
+        minar::Scheduler::runUntil(start + frame * 16000);
+
+        fastView->fillFrameBuffer(canvas, 0, 0);
+        fastView->clearDirty();
+
+        /* skip frames 6 to 26 on the slow table */
+        if (((frame % 3) == 0) && ((frame < 6) || (frame > 26)))
+        {
+            slowView->fillFrameBuffer(canvas, 0, 0);
+            slowView->clearDirty();
+
+            mismatches += (fast->getPixels() != slow->getPixels()) ? 1 : 0;
+        }
+
+        moving += (fast->getPixels() != previous) ? 1 : 0;
+        previous = fast->getPixels();
+    }
+
+    printf("kinetic: tables: moving frames: %lu rest: %ld slow: %ld mismatches: %lu\r\n",
+           (unsigned long) moving,
+           (long) fast->getPixels(),
+           (long) slow->getPixels(),
+           (unsigned long) mismatches);
+
+    check(moving > 10, "table flung");
+    check(mismatches == 0, "same offsets at any frame rate");
+    check(((SIZE / 2 - fast->getPixels()) % ROW_HEIGHT) == ROW_HEIGHT / 2, "row snapped to the center");
+    check(!fastView->isDirty() && !slowView->isDirty(), "tables at rest");
+}
+
+void app_start(int, char *[])
+{
+    testPhysics(-2000, -90, "coast");
+    testPhysics(-200, 120, "rubber band");
+
+    testTables();
+
+    finish();
+}
+
+#else
+
+void app_start(int, char *[])
+{
+    /* host only */
+}
+
+#endif // UIF_HOST
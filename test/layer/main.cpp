@@ -0,0 +1,140 @@
+/* mbed
+ * Copyright (c) 2006-2015 ARM Limited
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+/*  Retained layer test: a view wrapped in a UILayerView must produce the
+    same pixels as the view itself, at any offset and with transparent
+    areas, while only being rendered again after it has been invalidated.
+*/
+
+#include "UIFramework/UIPlatform.h"
+
+#include "UIFramework/UILayerView.h"
+#include "UIFramework/UIMemoryFrameBuffer.h"
+
+#include <stdio.h>
+
+#define TEST_NAME "layer"
+#include "test/UITest.h"
+
+#define SIZE 32
+
+/*  Draws a frame and a diagonal, leaving the rest of the canvas untouched.
+*/
+class PatternView : public UIView
+{
+public:
+    PatternView()
+        :   UIView(),
+            renders(0)
+    {
+        width = SIZE;
+        height = SIZE;
+    }
+
+    virtual uint32_t fillFrameBuffer(SharedPointer<FrameBuffer>& canvas, int16_t xOffset, int16_t yOffset)
+    {
+        renders++;
+
+        for (uint16_t idx = 0; idx < width; idx++)
+        {
+            plot(canvas, idx + xOffset, yOffset);
+            plot(canvas, idx + xOffset, height - 1 + yOffset);
+            plot(canvas, idx + xOffset, idx + yOffset);
+        }
+
+        return UINT32_MAX;
+    }
+
+    void plot(SharedPointer<FrameBuffer>& canvas, int32_t x, int32_t y)
+    {
+        if ((x >= 0) && (y >= 0))
+        {
+            canvas->drawPixel(x, y, 0);
+        }
+    }
+
+    uint32_t renders;
+};
+
+static bool compare(UIView* reference, UIView* layer, int16_t xOffset, int16_t yOffset, uint8_t background)
+{
+    UIMemoryFrameBuffer* expected = new UIMemoryFrameBuffer(SIZE + 16, SIZE + 16);
+    UIMemoryFrameBuffer* actual = new UIMemoryFrameBuffer(SIZE + 16, SIZE + 16);
+    SharedPointer<FrameBuffer> expectedCanvas(expected);
+    SharedPointer<FrameBuffer> actualCanvas(actual);
+
+    expected->fill(background);
+    actual->fill(background);
+
+    reference->fillFrameBuffer(expectedCanvas, xOffset, yOffset);
+    layer->fillFrameBuffer(actualCanvas, xOffset, yOffset);
+
+    for (uint16_t y = 0; y < SIZE + 16; y++)
+    {
+        for (uint16_t x = 0; x < SIZE + 16; x++)
+        {
+            if (expected->getPixel(x, y) != actual->getPixel(x, y))
+            {
+                return false;
+            }
+        }
+    }
+
+    return true;
+}
+
+void app_start(int, char *[])
+{
+    PatternView reference;
+    PatternView* pattern = new PatternView();
+    SharedPointer<UIView> view(pattern);
+    UILayerView layer(view);
+
+    /* first frame: the view is new, so it is drawn directly */
+    check(compare(&reference, &layer, 0, 0, 1), "direct");
+    check(!layer.isRetained(), "not retained while changing");
+    layer.clearDirty();
+
+    /* second frame: captured on a white and a black background */
+    check(compare(&reference, &layer, 0, 0, 1), "capture");
+    check(layer.isRetained(), "retained");
+    check(pattern->renders == 3, "capture renders");
+
+    /* later frames are blitted, also with offsets and on black */
+    check(compare(&reference, &layer, 5, 3, 1), "offset");
+    check(compare(&reference, &layer, -7, 9, 0), "transparent");
+    check(pattern->renders == 3, "blit");
+
+    /* invalidate renders the view again */
+    pattern->invalidate();
+    check(layer.isDirty(), "dirty after invalidate");
+    check(compare(&reference, &layer, 2, 2, 0), "invalidated");
+    check(pattern->renders == 4, "render after invalidate");
+    check(!layer.isRetained(), "released after invalidate");
+    layer.clearDirty();
+
+    check(compare(&reference, &layer, 0, 0, 1), "recapture");
+    check(layer.isRetained() && (pattern->renders == 6), "retained again");
+
+    /* views that are not cacheable are always drawn directly */
+    pattern->setCacheable(false);
+    layer.clearDirty();
+    check(compare(&reference, &layer, 0, 0, 1), "not cacheable");
+    check(!layer.isRetained() && (pattern->renders == 7), "not retained");
+
+    printf("layer: %s\r\n", (pass) ? "ok" : "failed");
+    finish();
+}
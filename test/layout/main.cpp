@@ -0,0 +1,219 @@
+/* mbed
+ * Copyright (c) 2006-2015 ARM Limited
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+/*  Layout test: the rows a table finds at the top, middle and bottom of
+    the screen are kept between calls and only looked up again when the
+    scroll position crosses a row boundary or the heights change. They must
+    match the rows found by summing the heights from the top, during a
+    fling and after a row changes height. Prints the lookups per frame.
+*/
+
+#include "UIFramework/UIPlatform.h"
+
+#if UIF_HOST
+
+#include "UIFramework/UIMemoryFrameBuffer.h"
+#include "UIFramework/UITableKineticView.h"
+
+#include <stdio.h>
+
+#define TEST_NAME "layout"
+#include "test/UITest.h"
+
+#define ROWS 300
+#define SIZE 128
+#define FRAMES 120
+
+static uint32_t tallRow = ROWS;
+
+class BarView : public UIView
+{
+public:
+    virtual uint32_t fillFrameBuffer(SharedPointer<FrameBuffer>& canvas, int16_t xOffset, int16_t yOffset)
+    {
+        (void) xOffset;
+        (void) yOffset;
+
+        canvas->drawRectangle(0, canvas->getWidth(), 0, canvas->getHeight(), 0);
+
+        return UINT32_MAX;
+    }
+};
+
+class BarArray : public UITestArray
+{
+public:
+    BarArray(bool _uniform)
+        :   UITestArray("Bars", ROWS, 20, SIZE),
+            uniform(_uniform)
+    {}
+
+    virtual SharedPointer<UIView> viewAtIndex(uint32_t index) const
+    {
+        (void) index;
+
+        return SharedPointer<UIView>(new BarView());
+    }
+
+    virtual uint32_t heightAtIndex(uint32_t index) const
+    {
+        if (uniform)
+        {
+            return 20;
+        }
+
+        return (index == tallRow) ? 90 : 14 + (index % 5) * 3;
+    }
+
+    virtual uint32_t getUniformHeight(void) const
+    {
+        return (uniform) ? 20 : 0;
+    }
+
+    bool uniform;
+};
+
+/*  First row from the top row on with its bottom edge at or below the
+    distance from the top of the screen, summing every height.
+*/
+static uint32_t rowAtDistance(const UIView::Array& array, uint32_t position, uint32_t distance)
+{
+    uint32_t row = 0;
+    uint32_t top = 0;
+
+    while ((row + 1 < ROWS) && (top + array.heightAtIndex(row) <= position))
+    {
+        top += array.heightAtIndex(row);
+        row++;
+    }
+
+    uint32_t bottom = top + array.heightAtIndex(row);
+
+    while ((row + 1 < ROWS) && (bottom < position + distance))
+    {
+        row++;
+        bottom += array.heightAtIndex(row);
+    }
+
+    return row;
+}
+
+static bool rowsMatch(UITableView* table, const UIView::Array& array)
+{
+    uint32_t position = -table->getPixels();
+
+    return (table->getFirstIndex() == rowAtDistance(array, position, 0))
+        && (table->getMiddleIndex() == rowAtDistance(array, position, SIZE / 2))
+        && (table->getLastIndex() == rowAtDistance(array, position, SIZE));
+}
+
+static void testFling(bool uniform)
+{
+    BarArray* bars = new BarArray(uniform);
+    SharedPointer<UIView::Array> array(bars);
+    UITableKineticView* table = new UITableKineticView(array, SIZE, SIZE, 0);
+    SharedPointer<UIView> view(table);
+
+    UIMemoryFrameBuffer* buffer = new UIMemoryFrameBuffer(SIZE, SIZE);
+    SharedPointer<FrameBuffer> canvas(buffer);
+
+    uint32_t mismatches = 0;
+    uint32_t moving = 0;
+    uint32_t movingPasses = 0;
+    uint32_t stillPasses = 0;
+
+    tallRow = ROWS;
+
+    for (uint32_t frame = 0; frame < FRAMES; frame++)
+    {
+        if (frame == 5)
+        {
+            table->sliderReleasedWithSpeed(-80);
+        }
+        else if (frame == 60)
+        {
+            table->sliderReleasedWithSpeed(50);
+        }
+
+        int32_t before = table->getPixels();
+        uint32_t passes = table->getLayoutPasses();
+
+        view->fillFrameBuffer(canvas, 0, 0);
+        view->clearDirty();
+
+        /* asked for again, as the application would */
+        table->getMiddleIndex();
+        table->getLastIndex();
+
+        passes = table->getLayoutPasses() - passes;
+
+        /* the first frame lays out the rows for the first time */
+        if (frame > 0)
+        {
+            if (table->getPixels() != before)
+            {
+                moving++;
+                movingPasses += passes;
+            }
+            else
+            {
+                stillPasses += passes;
+            }
+        }
+
+        mismatches += rowsMatch(table, *bars) ? 0 : 1;
+
+        minar::Scheduler::runUntil(minar::platform::getTime() + 16000);
+    }
+
+    /* a row on screen grows, the kept rows are out of date */
+    tallRow = table->getFirstIndex() + 1;
+    table->reloadRow(tallRow);
+
+    bool reloaded = rowsMatch(table, *bars);
+
+    printf("layout: %s: frames: %lu moving: %lu lookups per moving frame: %lu.%02lu still: %lu mismatches: %lu\r\n",
+           (uniform) ? "uniform" : "varying",
+           (unsigned long) FRAMES,
+           (unsigned long) moving,
+           (unsigned long) (movingPasses / moving),
+           (unsigned long) ((movingPasses * 100 / moving) % 100),
+           (unsigned long) stillPasses,
+           (unsigned long) mismatches);
+
+    check(moving > 20, "table scrolled");
+    check(mismatches == 0, "rows match");
+    check(reloaded, "rows match after height change");
+    check(stillPasses == 0, "no lookups while still");
+    check(movingPasses <= 2 * moving, "at most one lookup per row slot");
+}
+
+void app_start(int, char *[])
+{
+    testFling(false);
+    testFling(true);
+
+    finish();
+}
+
+#else
+
+void app_start(int, char *[])
+{
+    /* host only */
+}
+
+#endif // UIF_HOST
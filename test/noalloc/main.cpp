@@ -0,0 +1,343 @@
+/* mbed
+ * Copyright (c) 2006-2015 ARM Limited
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+/*  Allocation test: once the cells are cached, drawing a frame must not
+    touch the heap. Tables and view stacks draw their children through
+    reusable sub canvases instead of sub frame buffers, which is also
+    checked to give the same pixels, and to stay within a parent that
+    does not clip.
+*/
+
+#include "UIFramework/UIPlatform.h"
+
+#if UIF_HOST
+
+#include "UIFramework/UIImageView.h"
+#include "UIFramework/UIMemoryFrameBuffer.h"
+#include "UIFramework/UISubCanvas.h"
+#include "UIFramework/UITableView.h"
+#include "UIFramework/UIViewStack.h"
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <new>
+
+#define TEST_NAME "noalloc"
+#include "test/UITest.h"
+
+/*  Count heap allocations while a frame is being drawn.
+*/
+static bool counting = false;
+static uint32_t allocations = 0;
+
+void* operator new(size_t size)
+{
+    if (counting)
+    {
+        allocations++;
+    }
+
+    void* pointer = malloc((size) ? size : 1);
+
+    if (pointer == NULL)
+    {
+        throw std::bad_alloc();
+    }
+
+    return pointer;
+}
+
+void* operator new[](size_t size)
+{
+    return operator new(size);
+}
+
+/*  The deletes hand the memory back through one out of line function, so
+    the compiler does not see free() called on memory from operator new
+    after inlining them into their callers.
+*/
+static void release(void* pointer) __attribute__((noinline));
+
+static void release(void* pointer)
+{
+    free(pointer);
+}
+
+void operator delete(void* pointer) throw()
+{
+    release(pointer);
+}
+
+void operator delete[](void* pointer) throw()
+{
+    release(pointer);
+}
+
+void operator delete(void* pointer, size_t) throw()
+{
+    release(pointer);
+}
+
+void operator delete[](void* pointer, size_t) throw()
+{
+    release(pointer);
+}
+
+/*  24 x 20 checkerboard image, 4 bytes per row.
+*/
+static uint8_t checkerData[4 * 20];
+
+static const struct CompBuf checker = {
+    checkerData,
+    (uint8_t*) Comp_Fill_Ones,
+    0,
+    4,
+    24,
+    20
+};
+
+class CheckerArray : public UITestArray
+{
+public:
+    CheckerArray()
+        :   UITestArray("Checkers", 30, 16)
+    {}
+
+    virtual SharedPointer<UIView> viewAtIndex(uint32_t index) const
+    {
+        (void) index;
+
+        return SharedPointer<UIView>(new UIImageView(&checker));
+    }
+
+    virtual uint32_t heightAtIndex(uint32_t index) const
+    {
+        return 16 + (index % 3) * 4;
+    }
+};
+
+/*  Frame buffer that counts drawing outside its extent instead of clipping,
+    like the buffers of some displays.
+*/
+class StrictFrameBuffer : public UIMemoryFrameBuffer
+{
+public:
+    StrictFrameBuffer(uint16_t width, uint16_t height)
+        :   UIMemoryFrameBuffer(width, height),
+            outside(0)
+    {}
+
+    virtual void drawPixel(uint16_t x, uint16_t y, uint8_t color)
+    {
+        count(x, x + 1, y, y + 1);
+        UIMemoryFrameBuffer::drawPixel(x, y, color);
+    }
+
+    virtual void drawRectangle(uint16_t x0, uint16_t x1, uint16_t y0, uint16_t y1, uint8_t color)
+    {
+        count(x0, x1, y0, y1);
+        UIMemoryFrameBuffer::drawRectangle(x0, x1, y0, y1, color);
+    }
+
+    virtual bool drawImage(const struct CompBuf& image, int16_t x, int16_t y, uint8_t rotation)
+    {
+        count(x, x + image.width_bits, y, y + image.height_strides);
+        return UIMemoryFrameBuffer::drawImage(image, x, y, rotation);
+    }
+
+    uint32_t outside;
+
+private:
+    void count(int32_t x0, int32_t x1, int32_t y0, int32_t y1)
+    {
+        if ((x0 < 0) || (y0 < 0) || (x1 > getWidth()) || (y1 > getHeight()))
+        {
+            outside++;
+        }
+    }
+};
+
+static uint32_t countMismatches(UIMemoryFrameBuffer& first, UIMemoryFrameBuffer& second)
+{
+    uint32_t mismatches = 0;
+
+    for (uint16_t y = 0; y < first.getHeight(); y++)
+    {
+        for (uint16_t x = 0; x < first.getWidth(); x++)
+        {
+            if (first.getPixel(x, y) != second.getPixel(x, y))
+            {
+                mismatches++;
+            }
+        }
+    }
+
+    return mismatches;
+}
+
+/*  Draw the image through a sub frame buffer and through a sub canvas
+    covering the same window and compare the results.
+*/
+static void compareWindow(int16_t x, int16_t y, uint16_t width, uint16_t height,
+                          int16_t xOffset, int16_t yOffset)
+{
+    UIImageView reference(&checker);
+    UIImageView view(&checker);
+
+    UIMemoryFrameBuffer* referenceBuffer = new UIMemoryFrameBuffer(64, 48);
+    UIMemoryFrameBuffer* viewBuffer = new UIMemoryFrameBuffer(64, 48);
+    SharedPointer<FrameBuffer> referenceRoot(referenceBuffer);
+    SharedPointer<FrameBuffer> viewRoot(viewBuffer);
+
+    SharedPointer<FrameBuffer> referenceCanvas = referenceRoot->getFrameBuffer(x, y, width, height);
+    reference.fillFrameBuffer(referenceCanvas, xOffset, yOffset);
+
+    UISubCanvas* window = new UISubCanvas();
+    SharedPointer<FrameBuffer> viewCanvas(window);
+
+    window->setWindow(viewBuffer, x, y, width, height);
+    view.fillFrameBuffer(viewCanvas, xOffset, yOffset);
+
+    check(countMismatches(*referenceBuffer, *viewBuffer) == 0, "window pixels");
+}
+
+/*  Draw the view and return the number of allocations it took.
+*/
+static uint32_t draw(SharedPointer<UIView>& view, SharedPointer<FrameBuffer>& canvas, int16_t yOffset)
+{
+    allocations = 0;
+    counting = true;
+
+    view->fillFrameBuffer(canvas, 0, yOffset);
+
+    counting = false;
+
+    return allocations;
+}
+
+/*  Let the prefetch callbacks posted by the last frame run.
+*/
+static void settle(void)
+{
+    minar::Scheduler::runUntil(minar::platform::getTime() + 10000);
+}
+
+void app_start(int, char *[])
+{
+    for (uint32_t idx = 0; idx < sizeof(checkerData); idx++)
+    {
+        checkerData[idx] = ((idx / 4) % 2) ? 0x0F : 0xF0;
+    }
+
+    /* windows cut off on every side */
+    compareWindow(0, 0, 64, 48, 0, 0);
+    compareWindow(30, 10, 16, 8, 0, 0);
+    compareWindow(0, -5, 64, 20, 0, -5);
+    compareWindow(-10, 0, 64, 48, -10, 0);
+    compareWindow(50, 40, 20, 20, 0, 0);
+
+    /* view tree */
+    SharedPointer<UIView::Array> array(new CheckerArray());
+
+    /*  The last visible row runs past the bottom of the table, whose cell
+        windows must be cut off at the edge of the parent.
+    */
+    {
+        SharedPointer<UIView> table(new UITableView(array));
+
+        table->setWidth(128);
+        table->setHeight(100);
+
+        StrictFrameBuffer* strict = new StrictFrameBuffer(128, 100);
+        SharedPointer<FrameBuffer> strictCanvas(strict);
+
+        table->fillFrameBuffer(strictCanvas, 0, 0);
+        settle();
+        table->fillFrameBuffer(strictCanvas, 0, 0);
+        settle();
+
+        check(strict->outside == 0, "window inside parent");
+
+        UISubCanvas* window = new UISubCanvas();
+        SharedPointer<FrameBuffer> windowCanvas(window);
+
+        window->setWindow(strict, 100, 90, 64, 64);
+
+        check((window->getWidth() == 28) && (window->getHeight() == 10), "window clamped");
+    }
+
+    UITableView* first = new UITableView(array);
+    UITableView* second = new UITableView(array);
+    SharedPointer<UIView> firstView(first);
+    SharedPointer<UIView> secondView(second);
+
+    first->setPixels(-7);
+    second->setPixels(-23);
+
+    UIViewStack* stack = new UIViewStack();
+    SharedPointer<UIView> root(stack);
+
+    root->setWidth(128);
+    root->setHeight(128);
+    stack->pushView(firstView);
+
+    UIMemoryFrameBuffer* buffer = new UIMemoryFrameBuffer(128, 128);
+    SharedPointer<FrameBuffer> canvas(buffer);
+
+    UISubCanvas* band = new UISubCanvas();
+    SharedPointer<FrameBuffer> bandCanvas(band);
+
+    /* warm up: fill the cell caches */
+    root->fillFrameBuffer(canvas, 0, 0);
+    settle();
+    secondView->fillFrameBuffer(canvas, 0, 0);
+    settle();
+
+    uint32_t fullFrame = draw(root, canvas, 0);
+    settle();
+
+    band->setWindow(buffer, 0, 40, 128, 30);
+    uint32_t bandFrame = draw(root, bandCanvas, -40);
+    band->clearWindow();
+    settle();
+
+    /* half way through a transition */
+    stack->pushView(secondView);
+    minar::platform::advanceTime(stack->getTransitionTime() * 1000 / 2);
+
+    uint32_t transitionFrame = draw(root, canvas, 0);
+    settle();
+
+    printf("noalloc: allocations: full: %lu band: %lu transition: %lu\r\n",
+           (unsigned long) fullFrame,
+           (unsigned long) bandFrame,
+           (unsigned long) transitionFrame);
+
+    check(fullFrame == 0, "full frame");
+    check(bandFrame == 0, "band frame");
+    check(transitionFrame == 0, "transition frame");
+
+    finish();
+}
+
+#else
+
+void app_start(int, char *[])
+{
+    /* host only */
+}
+
+#endif // UIF_HOST
@@ -0,0 +1,158 @@
+/* mbed
+ * Copyright (c) 2006-2015 ARM Limited
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+/*  Overdraw test: a table whose cells draw every pixel of their row. When
+    the cells are declared opaque the table must not draw the background
+    underneath them, without changing the result.
+*/
+
+#include "UIFramework/UIPlatform.h"
+
+#if UIF_HOST
+
+#include "UIFramework/UIMemoryFrameBuffer.h"
+#include "UIFramework/UITableView.h"
+
+#include <stdio.h>
+
+#define TEST_NAME "overdraw"
+#include "test/UITest.h"
+
+#define ROW_HEIGHT 20
+
+/*  Stripes covering the whole cell.
+*/
+class StripeView : public UIView
+{
+public:
+    StripeView(bool _opaque)
+        :   UIView()
+    {
+        setOpaque(_opaque);
+    }
+
+    virtual uint32_t fillFrameBuffer(SharedPointer<FrameBuffer>& canvas, int16_t xOffset, int16_t yOffset)
+    {
+        (void) xOffset;
+
+        for (int32_t y = 0; y < height; y++)
+        {
+            int32_t line = y + yOffset;
+
+            if ((line >= 0) && (line < canvas->getHeight()))
+            {
+                canvas->drawRectangle(0, width, line, line + 1, (y / 2) % 2);
+            }
+        }
+
+        return UINT32_MAX;
+    }
+};
+
+class StripeArray : public UITestArray
+{
+public:
+    StripeArray(bool _opaque)
+        :   UITestArray("Stripes", 20, ROW_HEIGHT),
+            opaque(_opaque)
+    {}
+
+    virtual SharedPointer<UIView> viewAtIndex(uint32_t index) const
+    {
+        (void) index;
+
+        return SharedPointer<UIView>(new StripeView(opaque));
+    }
+
+private:
+    bool opaque;
+};
+
+static UIMemoryFrameBuffer* render(bool opaque, uint32_t& overdraw)
+{
+    SharedPointer<UIView::Array> array(new StripeArray(opaque));
+    UITableView table(array);
+
+    table.setWidth(128);
+    table.setHeight(128);
+    table.setPixels(-7);
+
+    UIMemoryFrameBuffer* buffer = new UIMemoryFrameBuffer(128, 128);
+    SharedPointer<FrameBuffer> canvas(buffer);
+
+    buffer->setOverdrawTracking(true);
+    table.fillFrameBuffer(canvas, 0, 0);
+
+    overdraw = buffer->getOverdraw();
+
+    /* keep the buffer alive after the canvas goes out of scope */
+    UIMemoryFrameBuffer* copy = new UIMemoryFrameBuffer(128, 128);
+
+    for (uint16_t y = 0; y < 128; y++)
+    {
+        for (uint16_t x = 0; x < 128; x++)
+        {
+            copy->drawPixel(x, y, buffer->getPixel(x, y));
+        }
+    }
+
+    return copy;
+}
+
+void app_start(int, char *[])
+{
+    uint32_t transparentOverdraw = 0;
+    uint32_t opaqueOverdraw = 0;
+
+    UIMemoryFrameBuffer* transparent = render(false, transparentOverdraw);
+    UIMemoryFrameBuffer* opaque = render(true, opaqueOverdraw);
+
+    uint32_t mismatches = 0;
+
+    for (uint16_t y = 0; y < 128; y++)
+    {
+        for (uint16_t x = 0; x < 128; x++)
+        {
+            if (transparent->getPixel(x, y) != opaque->getPixel(x, y))
+            {
+                mismatches++;
+            }
+        }
+    }
+
+    printf("overdraw: transparent cells: %lu opaque cells: %lu mismatches: %lu\r\n",
+           (unsigned long) transparentOverdraw,
+           (unsigned long) opaqueOverdraw,
+           (unsigned long) mismatches);
+
+    check(transparentOverdraw == 128 * 128, "transparent cells overdraw");
+    check(opaqueOverdraw == 0, "opaque cells overdraw");
+    check(mismatches == 0, "opaque cells render the same");
+
+    finish();
+
+    delete transparent;
+    delete opaque;
+}
+
+#else
+
+void app_start(int, char *[])
+{
+    /* host only */
+}
+
+#endif // UIF_HOST
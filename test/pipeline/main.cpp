@@ -0,0 +1,299 @@
+/* mbed
+ * Copyright (c) 2006-2015 ARM Limited
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+/*  Pipelining test: simulated displays with slow transfers while animated
+    views request new frames as fast as possible. With more than one buffer
+    in the pool, frames must be rendered while the previous frame is being
+    transferred and transfers must run back to back. Every frame that
+    reaches the screen must show the next step of the animation, and must
+    not change while it is being sent.
+
+    One display hands out the same buffer objects every time. The other
+    behaves like the MatrixLCD driver: it hands out the buffer that is not
+    being sent, wrapped in a new object every time.
+*/
+
+#include "UIFramework/UIPlatform.h"
+
+#if UIF_HOST
+
+#include "UIFramework/UIFramework.h"
+#include "UIFramework/UIMemoryFrameBuffer.h"
+#include "UIFramework/host/UIHostDisplay.h"
+
+#include <stdio.h>
+
+#define TEST_NAME "pipeline"
+#include "test/UITest.h"
+
+#define TRANSFER_TIME_MS 40
+#define TEST_DURATION_MS 2000
+#define NUMBER_OF_BUFFERS 2
+#define SCREEN_SIZE 128
+#define BAR_HEIGHT 8
+
+/*  The bar is the first black line.
+*/
+static int32_t findBar(FrameBuffer& buffer)
+{
+    int32_t bar = 0;
+
+    while ((bar < SCREEN_SIZE) && buffer.getPixel(0, bar))
+    {
+        bar++;
+    }
+
+    return bar;
+}
+
+/*  Display with simulated transfer time that checks the animation step
+    shown by each frame it receives, at the start and at the end of the
+    transfer.
+*/
+class PipelineDisplay : public UIHostDisplay
+{
+public:
+    PipelineDisplay()
+        :   UIHostDisplay(SCREEN_SIZE, SCREEN_SIZE, NUMBER_OF_BUFFERS),
+            position(-1),
+            skipped(0),
+            torn(0)
+    {
+        setLineTime((TRANSFER_TIME_MS * 1000) / SCREEN_SIZE);
+    }
+
+    virtual void sendFrameBuffer(SharedPointer<FrameBuffer>& buffer,
+                                 FunctionPointer onStart,
+                                 FunctionPointer onFinish)
+    {
+        startFrame(buffer, onFinish);
+        sent(buffer);
+        UIHostDisplay::sendFrameBuffer(buffer, onStart, FunctionPointer(this, &PipelineDisplay::finishFrame));
+    }
+
+    virtual void sendFrameBufferLines(SharedPointer<FrameBuffer>& buffer,
+                                      const uint8_t* lines,
+                                      FunctionPointer onStart,
+                                      FunctionPointer onFinish)
+    {
+        startFrame(buffer, onFinish);
+        sent(buffer);
+        UIHostDisplay::sendFrameBufferLines(buffer, lines, onStart, FunctionPointer(this, &PipelineDisplay::finishFrame));
+    }
+
+    int32_t position;
+    uint32_t skipped;
+    uint32_t torn;
+
+protected:
+    virtual void sent(SharedPointer<FrameBuffer>& buffer)
+    {
+        (void) buffer;
+    }
+
+private:
+    void startFrame(SharedPointer<FrameBuffer>& buffer, FunctionPointer onFinish)
+    {
+        int32_t bar = findBar(*buffer);
+
+        if ((position >= 0) && (bar != (position + 1) % (SCREEN_SIZE - BAR_HEIGHT)))
+        {
+            skipped++;
+        }
+
+        position = bar;
+        sending = buffer;
+        finish = onFinish;
+    }
+
+    /*  Frames rendered meanwhile must have gone into another buffer.
+    */
+    void finishFrame(void)
+    {
+        if (findBar(*sending) != position)
+        {
+            torn++;
+        }
+
+        sending = SharedPointer<FrameBuffer>();
+
+        finish.call();
+    }
+
+    SharedPointer<FrameBuffer> sending;
+    FunctionPointer finish;
+};
+
+/*  Double buffered display that hands out the buffer not being sent, or
+    not sent last, in a new object every time.
+*/
+class WrappingDisplay : public PipelineDisplay
+{
+public:
+    WrappingDisplay()
+        :   PipelineDisplay(),
+            front(0)
+    {
+        for (uint32_t idx = 0; idx < NUMBER_OF_BUFFERS; idx++)
+        {
+            memory[idx] = PipelineDisplay::getFrameBuffer();
+        }
+    }
+
+    virtual SharedPointer<FrameBuffer> getFrameBuffer(void)
+    {
+        SharedPointer<FrameBuffer>& back = memory[(front + 1) % NUMBER_OF_BUFFERS];
+
+        return back->getFrameBuffer(0, 0, back->getWidth(), back->getHeight());
+    }
+
+protected:
+    virtual void sent(SharedPointer<FrameBuffer>& buffer)
+    {
+        uint8_t* data = static_cast<UIMemoryFrameBuffer*>(buffer.get())->getData();
+
+        for (uint32_t idx = 0; idx < NUMBER_OF_BUFFERS; idx++)
+        {
+            if (static_cast<UIMemoryFrameBuffer*>(memory[idx].get())->getData() == data)
+            {
+                front = idx;
+            }
+        }
+    }
+
+private:
+    SharedPointer<FrameBuffer> memory[NUMBER_OF_BUFFERS];
+    uint32_t front;
+};
+
+/*  View that changes every frame and never stops animating. Counts how many
+    frames were rendered while the display was busy transferring.
+*/
+class AnimatedView : public UIView
+{
+public:
+    AnimatedView(UIHostDisplay& _display)
+        :   UIView(),
+            display(_display),
+            position(0),
+            overlap(0)
+    {}
+
+    virtual uint32_t fillFrameBuffer(SharedPointer<FrameBuffer>& canvas, int16_t xOffset, int16_t yOffset)
+    {
+        (void) xOffset;
+        (void) yOffset;
+
+        if (display.isBusy())
+        {
+            overlap++;
+        }
+
+        canvas->drawRectangle(0, canvas->getWidth(), 0, canvas->getHeight(), 1);
+        canvas->drawRectangle(0, canvas->getWidth(), position, position + BAR_HEIGHT, 0);
+
+        position = (position + 1) % (canvas->getHeight() - BAR_HEIGHT);
+
+        return 0;
+    }
+
+    UIHostDisplay& display;
+    uint16_t position;
+    uint32_t overlap;
+};
+
+typedef struct {
+    const char* name;
+    PipelineDisplay* display;
+    AnimatedView* animation;
+    SharedPointer<UIFramework> framework;
+} pipeline_t;
+
+static PipelineDisplay fixedDisplay;
+static WrappingDisplay wrappingDisplay;
+
+static pipeline_t pipelines[2];
+
+static void setupPipeline(pipeline_t& pipeline, const char* name, PipelineDisplay* display)
+{
+    pipeline.name = name;
+    pipeline.display = display;
+    pipeline.animation = new AnimatedView(*display);
+
+    SharedPointer<UIView> view(pipeline.animation);
+
+    view->setWidth(SCREEN_SIZE);
+    view->setHeight(SCREEN_SIZE);
+
+    pipeline.framework = SharedPointer<UIFramework>(new UIFramework(*display, view, 0, NUMBER_OF_BUFFERS));
+
+    /* every transfer is a full frame and takes TRANSFER_TIME_MS */
+    pipeline.framework->setDirtyLineTracking(false);
+}
+
+static void reportPipeline(pipeline_t& pipeline)
+{
+    uint32_t frames = pipeline.framework->getRenderedFrames();
+    uint32_t expected = TEST_DURATION_MS / TRANSFER_TIME_MS;
+
+    printf("pipeline %s: buffers: %lu frames: %lu transfers: %lu overlapped: %lu skipped: %lu torn: %lu expected: %lu\r\n",
+           pipeline.name,
+           (unsigned long) pipeline.framework->getBufferCount(),
+           (unsigned long) frames,
+           (unsigned long) pipeline.display->getFrames(),
+           (unsigned long) pipeline.animation->overlap,
+           (unsigned long) pipeline.display->skipped,
+           (unsigned long) pipeline.display->torn,
+           (unsigned long) expected);
+
+    /*  With a pool of two buffers every render after the first overlaps a
+        transfer, and the screen is kept busy all the time. Every rendered
+        frame reaches the screen in order and intact.
+    */
+    check(pipeline.framework->getBufferCount() == NUMBER_OF_BUFFERS, "buffer count");
+    check(pipeline.animation->overlap + 1 >= frames, "renders overlap transfers");
+    check(pipeline.display->getFrames() + 1 >= expected, "screen kept busy");
+    check(pipeline.display->skipped == 0, "no skipped frames");
+    check(pipeline.display->torn == 0, "no torn frames");
+}
+
+static void reportTask()
+{
+    reportPipeline(pipelines[0]);
+    reportPipeline(pipelines[1]);
+
+    finish();
+
+    minar::Scheduler::stop();
+}
+
+void app_start(int, char *[])
+{
+    setupPipeline(pipelines[0], "fixed", &fixedDisplay);
+    setupPipeline(pipelines[1], "wrapping", &wrappingDisplay);
+
+    minar::Scheduler::postCallback(reportTask)
+        .delay(minar::milliseconds(TEST_DURATION_MS));
+}
+
+#else
+
+void app_start(int, char *[])
+{
+    /* host only */
+}
+
+#endif // UIF_HOST
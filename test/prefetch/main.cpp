@@ -0,0 +1,210 @@
+/* mbed
+ * Copyright (c) 2006-2015 ARM Limited
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+/*  Prefetch test: while a kinetic table is flung, rows must be fetched
+    ahead in the direction of motion so they are cached by the time they
+    scroll into view, each scheduler slot must stay within its time budget,
+    and a table never has more than one prefetch task queued.
+*/
+
+#include "UIFramework/UIPlatform.h"
+
+#if UIF_HOST
+
+#include "UIFramework/UIMemoryFrameBuffer.h"
+#include "UIFramework/UITableKineticView.h"
+
+#include <stdio.h>
+
+#define TEST_NAME "prefetch"
+#include "test/UITest.h"
+
+#define ROWS 300
+#define ROW_HEIGHT 24
+#define CACHE_SIZE 16
+
+class BlankView : public UIView
+{
+public:
+    virtual uint32_t fillFrameBuffer(SharedPointer<FrameBuffer>& canvas, int16_t xOffset, int16_t yOffset)
+    {
+        (void) canvas;
+        (void) xOffset;
+        (void) yOffset;
+
+        return UINT32_MAX;
+    }
+};
+
+/*  Creating a cell takes the given amount of virtual time.
+*/
+class SlowArray : public UITestArray
+{
+public:
+    SlowArray(uint32_t _cost)
+        :   UITestArray("Slow", ROWS, ROW_HEIGHT),
+            cost(_cost),
+            fetches(0)
+    {}
+
+    virtual SharedPointer<UIView> viewAtIndex(uint32_t index) const
+    {
+        (void) index;
+
+        fetches++;
+        minar::platform::advanceTime(cost);
+
+        return SharedPointer<UIView>(new BlankView());
+    }
+
+    uint32_t cost;
+    mutable uint32_t fetches;
+};
+
+static void testQueue(void)
+{
+    UIPrefetchQueue queue(4);
+
+    check(queue.push(10), "push");
+    check(!queue.push(10), "duplicate");
+    check(queue.push(11) && queue.push(12) && queue.push(13), "fill");
+    check(!queue.push(14), "full");
+    check(queue.getDepth() == 4, "depth");
+
+    queue.retain(11, 13);
+
+    check(queue.getDepth() == 2, "retain");
+    check(queue.getDropped() == 2, "dropped");
+
+    uint32_t row = 0;
+
+    check(queue.pop(row) && (row == 11), "pop order");
+    check(queue.pop(row) && (row == 12), "pop order");
+    check(!queue.pop(row), "empty");
+    check(queue.getDuplicates() == 1, "duplicates");
+    check(queue.getMaxDepth() == 4, "max depth");
+}
+
+/*  Fling the table down and count the rows that were not cached when
+    they were drawn. Prefetches run between frames, which are one kinetic
+    frame time apart as the fling is integrated over time.
+*/
+static uint32_t fling(uint32_t prefetchRows)
+{
+    SharedPointer<UIView::Array> array(new SlowArray(0));
+    UITableKineticView* table = new UITableKineticView(array, 128, 128, 0, CACHE_SIZE);
+    SharedPointer<UIView> view(table);
+
+    table->setPrefetchBudget(prefetchRows, DEFAULT_PREFETCH_TIME_MS);
+
+    UIMemoryFrameBuffer* buffer = new UIMemoryFrameBuffer(128, 128);
+    SharedPointer<FrameBuffer> canvas(buffer);
+
+    view->fillFrameBuffer(canvas, 0, 0);
+    minar::Scheduler::runUntil(minar::platform::getTime() + 1000);
+
+    table->getCellCache().resetStatistics();
+    table->getPrefetchQueue().resetStatistics();
+    table->sliderReleasedWithSpeed(-120);
+
+    uint32_t maxPending = 0;
+
+    for (uint32_t frame = 0; frame < 40; frame++)
+    {
+        view->fillFrameBuffer(canvas, 0, 0);
+
+        if (minar::Scheduler::getPendingCallbacks() > maxPending)
+        {
+            maxPending = minar::Scheduler::getPendingCallbacks();
+        }
+
+        minar::Scheduler::runUntil(minar::platform::getTime() + KINETIC_FRAME_US);
+    }
+
+    UICellCache& cache = table->getCellCache();
+    UIPrefetchQueue& queue = table->getPrefetchQueue();
+
+    printf("prefetch: rows: %lu queued: %lu max depth: %lu dropped: %lu wasted: %lu tasks: %lu\r\n",
+           (unsigned long) prefetchRows,
+           (unsigned long) queue.getPushed(),
+           (unsigned long) queue.getMaxDepth(),
+           (unsigned long) queue.getDropped(),
+           (unsigned long) cache.getWastedPrefetches(),
+           (unsigned long) maxPending);
+
+    check(maxPending <= 1, "one prefetch task");
+
+    return cache.getMisses() + cache.getRefetches();
+}
+
+/*  With cells taking 1.5 ms to create, a 2 ms slot fetches two rows and
+    leaves the rest of the window to the next slot.
+*/
+static void testTimeBudget(void)
+{
+    SlowArray* slow = new SlowArray(1500);
+    SharedPointer<UIView::Array> array(slow);
+    UITableView table(array, CACHE_SIZE);
+
+    table.setWidth(128);
+    table.setHeight(128);
+    table.setPrefetchBudget(8, 2);
+    table.setScrollVelocity(-60);
+
+    UIMemoryFrameBuffer* buffer = new UIMemoryFrameBuffer(128, 128);
+    SharedPointer<FrameBuffer> canvas(buffer);
+
+    table.fillFrameBuffer(canvas, 0, 0);
+
+    uint32_t before = slow->fetches;
+
+    minar::Scheduler::runUntil(minar::platform::getTime());
+
+    check(slow->fetches - before == 2, "rows per slot");
+    check(minar::Scheduler::getPendingCallbacks() > 0, "rest left for next slot");
+
+    /* the remaining slots finish the window */
+    minar::Scheduler::runUntil(minar::platform::getTime() + 100000);
+
+    check(minar::Scheduler::getPendingCallbacks() == 0, "window finished");
+}
+
+void app_start(int, char *[])
+{
+    testQueue();
+
+    uint32_t single = fling(1);
+    uint32_t window = fling(DEFAULT_PREFETCH_ROWS);
+
+    printf("prefetch: fling misses: one row: %lu velocity window: %lu\r\n",
+           (unsigned long) single,
+           (unsigned long) window);
+
+    check(window < single, "window reduces misses");
+
+    testTimeBudget();
+
+    finish();
+}
+
+#else
+
+void app_start(int, char *[])
+{
+    /* host only */
+}
+
+#endif // UIF_HOST
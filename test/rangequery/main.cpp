@@ -0,0 +1,191 @@
+/* mbed
+ * Copyright (c) 2006-2015 ARM Limited
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+/*  Range query test: the default bulk queries on UIView::Array must match
+    the single index ones, the height index must be built with one bulk
+    query, and a table drawing a screen of uncached rows must fetch them in
+    batches rather than one virtual call per row.
+*/
+
+#include "UIFramework/UIMemoryFrameBuffer.h"
+#include "UIFramework/UITableView.h"
+
+#include <stdio.h>
+
+#define TEST_NAME "rangequery"
+#include "test/UITest.h"
+
+#define ROWS 100
+#define SIZE 128
+
+class BlankView : public UIView
+{
+public:
+    virtual uint32_t fillFrameBuffer(SharedPointer<FrameBuffer>& canvas, int16_t xOffset, int16_t yOffset)
+    {
+        (void) canvas;
+        (void) xOffset;
+        (void) yOffset;
+
+        return UINT32_MAX;
+    }
+};
+
+/*  Rows of varying height, counting how the table asks for them.
+*/
+class CountingArray : public UITestArray
+{
+public:
+    CountingArray(bool _bulk)
+        :   UITestArray("Counting", ROWS, 10, SIZE),
+            bulk(_bulk),
+            singleViews(0),
+            rangeViews(0),
+            singleHeights(0),
+            rangeHeights(0)
+    {}
+
+    virtual SharedPointer<UIView> viewAtIndex(uint32_t index) const
+    {
+        (void) index;
+
+        singleViews++;
+
+        return SharedPointer<UIView>(new BlankView());
+    }
+
+    virtual uint32_t heightAtIndex(uint32_t index) const
+    {
+        singleHeights++;
+
+        return 10 + (index % 4) * 5;
+    }
+
+    virtual uint32_t widthAtIndex(uint32_t index) const
+    {
+        return SIZE - index;
+    }
+
+    virtual void viewsInRange(uint32_t first, uint32_t last, SharedPointer<UIView>* views, UICellPool& pool) const
+    {
+        if (!bulk)
+        {
+            UIView::Array::viewsInRange(first, last, views, pool);
+            return;
+        }
+
+        rangeViews++;
+
+        for (uint32_t index = first; index < last; index++)
+        {
+            views[index - first] = SharedPointer<UIView>(new BlankView());
+        }
+    }
+
+    virtual void heightsInRange(uint32_t first, uint32_t last, uint32_t* heights) const
+    {
+        if (!bulk)
+        {
+            UIView::Array::heightsInRange(first, last, heights);
+            return;
+        }
+
+        rangeHeights++;
+
+        for (uint32_t index = first; index < last; index++)
+        {
+            heights[index - first] = 10 + (index % 4) * 5;
+        }
+    }
+
+    bool bulk;
+    mutable uint32_t singleViews;
+    mutable uint32_t rangeViews;
+    mutable uint32_t singleHeights;
+    mutable uint32_t rangeHeights;
+};
+
+static void testDefaults(void)
+{
+    CountingArray array(false);
+
+    uint32_t heights[ROWS];
+    uint32_t widths[ROWS];
+    SharedPointer<UIView> views[4];
+    UICellPool pool;
+
+    array.heightsInRange(0, ROWS, heights);
+    array.widthsInRange(10, 20, widths);
+    array.viewsInRange(50, 54, views, pool);
+
+    bool same = true;
+
+    for (uint32_t index = 0; index < ROWS; index++)
+    {
+        same = same && (heights[index] == 10 + (index % 4) * 5);
+    }
+
+    for (uint32_t index = 10; index < 20; index++)
+    {
+        same = same && (widths[index - 10] == SIZE - index);
+    }
+
+    check(same, "default heights and widths");
+    check((views[0] != NULL) && (views[3] != NULL), "default views");
+    check(array.singleViews == 4, "default views per index");
+}
+
+/*  Draw a screen of rows, then scroll a screen further and draw again.
+*/
+static void testTable(bool bulk)
+{
+    CountingArray* counting = new CountingArray(bulk);
+    SharedPointer<UIView::Array> array(counting);
+    UITableView table(array, 32);
+
+    UIMemoryFrameBuffer* buffer = new UIMemoryFrameBuffer(SIZE, SIZE);
+    SharedPointer<FrameBuffer> canvas(buffer);
+
+    table.fillFrameBuffer(canvas, 0, 0);
+    table.scrollPx(-(SIZE + 7));
+    table.fillFrameBuffer(canvas, 0, 0);
+
+    uint32_t calls = counting->singleViews + counting->rangeViews;
+
+    printf("rangequery: %s: view calls: %lu height calls: %lu\r\n",
+           (bulk) ? "bulk" : "default",
+           (unsigned long) calls,
+           (unsigned long) (counting->singleHeights + counting->rangeHeights));
+
+    if (bulk)
+    {
+        check(counting->rangeHeights == 1, "index built with one query");
+        check(counting->singleHeights == 0, "no heights per row");
+        check(counting->singleViews == 0, "no views per row");
+        check(calls <= 2 * ((SIZE / 10 + FETCH_BATCH_ROWS) / FETCH_BATCH_ROWS + 1), "views fetched in batches");
+    }
+
+    check(table.getFirstIndex() > 0, "scrolled");
+}
+
+void app_start(int, char *[])
+{
+    testDefaults();
+    testTable(false);
+    testTable(true);
+
+    finish();
+}
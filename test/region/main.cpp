@@ -0,0 +1,150 @@
+/* mbed
+ * Copyright (c) 2006-2015 ARM Limited
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+/*  Partial rendering test: a table where one row shows a seconds counter.
+    Once the pool buffers have been filled, every update may only render the
+    lines of that row, and the screen must still match a full render. The
+    table uses blit scrolling, whose retained rows must survive the bands.
+*/
+
+#include "UIFramework/UIPlatform.h"
+
+#if UIF_HOST
+
+#include "UIFramework/UIFramework.h"
+#include "UIFramework/UIMemoryFrameBuffer.h"
+#include "UIFramework/UITableView.h"
+#include "UIFramework/UITextMonitorView.h"
+#include "UIFramework/UITextView.h"
+#include "UIFramework/host/UIHostDisplay.h"
+
+#include "uif-tools-1bit/fonts/fonts.h"
+
+#include <stdio.h>
+
+#define TEST_NAME "region"
+#include "test/UITest.h"
+
+#define ROW_HEIGHT 30
+#define COUNTER_ROW 1
+#define TEST_DURATION_MS 10000
+
+static uint32_t seconds = 0;
+
+class CounterArray : public UITestArray
+{
+public:
+    CounterArray()
+        :   UITestArray("Counter", 10, ROW_HEIGHT)
+    {}
+
+    virtual SharedPointer<UIView> viewAtIndex(uint32_t index) const
+    {
+        if (index == COUNTER_ROW)
+        {
+            return SharedPointer<UIView>(new UITextMonitorView<uint32_t>(&seconds, "%lu", &Font_Menu, 500));
+        }
+
+        return SharedPointer<UIView>(new UITextView("Row", &Font_Menu));
+    }
+};
+
+static UIHostDisplay display;
+static SharedPointer<UIFramework> uiFramework;
+static SharedPointer<UIView> root;
+static UITableView* table;
+
+static void tickTask()
+{
+    seconds++;
+}
+
+static void reportTask()
+{
+    uint32_t frames = uiFramework->getRenderedFrames();
+    uint32_t lines = uiFramework->getRenderedLines();
+
+    /* compare the screen with a full render of the tree */
+    UIMemoryFrameBuffer* reference = new UIMemoryFrameBuffer(128, 128);
+    SharedPointer<FrameBuffer> canvas(reference);
+
+    root->fillFrameBuffer(canvas, 0, 0);
+
+    uint32_t mismatches = 0;
+
+    for (uint16_t y = 0; y < 128; y++)
+    {
+        for (uint16_t x = 0; x < 128; x++)
+        {
+            if (reference->getPixel(x, y) != display.getPixel(x, y))
+            {
+                mismatches++;
+            }
+        }
+    }
+
+    printf("region: frames: %lu lines: %lu lines/frame: %lu table lines: %lu mismatches: %lu\r\n",
+           (unsigned long) frames,
+           (unsigned long) lines,
+           (unsigned long) ((frames > 0) ? lines / frames : 0),
+           (unsigned long) table->getRenderedLines(),
+           (unsigned long) mismatches);
+
+    /*  The first frame into each of the pool buffers is a full render,
+        after that only the counter row is rendered. The table draws its
+        retained rows once, and then only the counter row.
+    */
+    uint32_t pool = uiFramework->getBufferCount();
+    check(frames > pool, "frames rendered");
+    check(lines <= (pool * 128) + ((frames - pool) * ROW_HEIGHT), "lines rendered");
+    check(table->getRenderedLines() <= 128 + ((frames - 1) * ROW_HEIGHT), "table lines rendered");
+    check(mismatches == 0, "bands render the same");
+
+    finish();
+
+    minar::Scheduler::stop();
+}
+
+void app_start(int, char *[])
+{
+    SharedPointer<UIView::Array> array(new CounterArray());
+
+    /* the retained rows of blit scrolling must stay valid for bands */
+    table = new UITableView(array);
+    table->setBlitScrolling(true);
+
+    root = SharedPointer<UIView>(table);
+    root->setWidth(128);
+    root->setHeight(128);
+
+    uiFramework = SharedPointer<UIFramework>(new UIFramework(display, root));
+
+    /* every view in the tree marks itself dirty when it changes */
+    uiFramework->setIdleFrameElision(true);
+    uiFramework->setPartialRendering(true);
+
+    minar::Scheduler::postCallback(tickTask).period(minar::milliseconds(1000));
+    minar::Scheduler::postCallback(reportTask).delay(minar::milliseconds(TEST_DURATION_MS));
+}
+
+#else
+
+void app_start(int, char *[])
+{
+    /* host only */
+}
+
+#endif // UIF_HOST
@@ -0,0 +1,483 @@
+/* mbed
+ * Copyright (c) 2006-2015 ARM Limited
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+/*  Row change test: rows inserted, deleted and updated in the table-object
+    are passed on to the table through UIView::Array::Listener. Changes
+    above the screen must keep the same rows on screen without fetching or
+    drawing anything, changes on screen must only fetch the changed rows,
+    and the table must draw the same pixels as a new table at the same
+    position. Cached cells must stay with their rows through random
+    changes.
+*/
+
+#include "UIFramework/UIPlatform.h"
+
+#if UIF_HOST
+
+#include "UIFramework/UIMemoryFrameBuffer.h"
+#include "UIFramework/UITableView.h"
+
+#include <stdio.h>
+#include <vector>
+
+#define TEST_NAME "rowchanges"
+#include "test/UITest.h"
+
+#define ROWS 100
+#define SIZE 128
+
+static uint32_t created = 0;
+
+static uint32_t heightOf(uint32_t id)
+{
+    return 14 + (id % 3) * 5;
+}
+
+/*  Stripes that depend on the row's id, so a cell left at the wrong row
+    shows up in the comparison.
+*/
+class IdView : public UIView
+{
+public:
+    IdView(uint32_t _id)
+        :   UIView(),
+            id(_id)
+    {
+        created++;
+    }
+
+    virtual uint32_t fillFrameBuffer(SharedPointer<FrameBuffer>& canvas, int16_t xOffset, int16_t yOffset)
+    {
+        (void) xOffset;
+
+        int32_t bar = (id * 7) % width;
+
+        for (int32_t y = 0; y < height; y++)
+        {
+            int32_t line = y + yOffset;
+
+            if ((line >= 0) && (line < canvas->getHeight()))
+            {
+                uint8_t color = ((y + id) / 3) % 2;
+
+                canvas->drawRectangle(0, bar, line, line + 1, color);
+                canvas->drawRectangle(bar, width, line, line + 1, color ^ 1);
+            }
+        }
+
+        return UINT32_MAX;
+    }
+
+    uint32_t getId(void) const
+    {
+        return id;
+    }
+
+private:
+    uint32_t id;
+};
+
+class IdArray : public UIView::Array
+{
+public:
+    IdArray()
+        :   nextId(ROWS)
+    {
+        for (uint32_t row = 0; row < ROWS; row++)
+        {
+            ids.push_back(row);
+        }
+    }
+
+    void insert(uint32_t first, uint32_t count)
+    {
+        for (uint32_t row = first; row < first + count; row++)
+        {
+            ids.insert(ids.begin() + row, nextId++);
+        }
+
+        notifyInserted(first, count);
+    }
+
+    void remove(uint32_t first, uint32_t count)
+    {
+        ids.erase(ids.begin() + first, ids.begin() + first + count);
+
+        notifyDeleted(first, count);
+    }
+
+    void update(uint32_t row)
+    {
+        ids[row] = nextId++;
+
+        notifyUpdated(row, 1);
+    }
+
+    virtual uint32_t getSize(void) const
+    {
+        return ids.size();
+    }
+
+    virtual SharedPointer<UIView> viewAtIndex(uint32_t index) const
+    {
+        return SharedPointer<UIView>(new IdView(ids[index]));
+    }
+
+    virtual uint32_t heightAtIndex(uint32_t index) const
+    {
+        return heightOf(ids[index]);
+    }
+
+    virtual uint32_t widthAtIndex(uint32_t index) const
+    {
+        (void) index;
+
+        return SIZE;
+    }
+
+    virtual const char* getTitle(void) const
+    {
+        return "Ids";
+    }
+
+    std::vector<uint32_t> ids;
+    uint32_t nextId;
+};
+
+static bool samePixels(UIMemoryFrameBuffer* a, UIMemoryFrameBuffer* b)
+{
+    for (uint16_t y = 0; y < SIZE; y++)
+    {
+        for (uint16_t x = 0; x < SIZE; x++)
+        {
+            if (a->getPixel(x, y) != b->getPixel(x, y))
+            {
+                return false;
+            }
+        }
+    }
+
+    return true;
+}
+
+/*  Draw a new table at the same position. The new table listens to the
+    array alongside the first one until it is destroyed.
+*/
+static bool matchesNewTable(SharedPointer<UIView::Array>& array, UITableView* table, UIMemoryFrameBuffer* buffer)
+{
+    bool same;
+
+    {
+        UITableView* reference = new UITableView(array);
+        SharedPointer<UIView> view(reference);
+
+        UIMemoryFrameBuffer* referenceBuffer = new UIMemoryFrameBuffer(SIZE, SIZE);
+        SharedPointer<FrameBuffer> canvas(referenceBuffer);
+
+        view->fillFrameBuffer(canvas, 0, 0);
+        reference->setPixels(table->getPixels());
+        view->fillFrameBuffer(canvas, 0, 0);
+
+        same = samePixels(buffer, referenceBuffer);
+    }
+
+    return same;
+}
+
+/*  Cached cells must belong to the row they are cached for.
+*/
+static bool cacheMatches(UITableView* table, IdArray* ids)
+{
+    UICellCache& cache = table->getCellCache();
+
+    for (uint32_t row = 0; row < ids->getSize(); row++)
+    {
+        SharedPointer<UIView>& cell = cache.peek(row);
+
+        if ((cell != NULL) && (static_cast<IdView*>(cell.get())->getId() != ids->ids[row]))
+        {
+            return false;
+        }
+    }
+
+    return true;
+}
+
+static void testChanges(void)
+{
+    IdArray* ids = new IdArray();
+    SharedPointer<UIView::Array> array(ids);
+    UITableView* table = new UITableView(array);
+    SharedPointer<UIView> view(table);
+
+    table->setBlitScrolling(true);
+
+    check(array->hasListener(table), "table listens to array");
+
+    /* a second table on the same array is told about the same changes */
+    UITableView* second = new UITableView(array);
+    SharedPointer<UIView> secondView(second);
+    UIMemoryFrameBuffer* secondBuffer = new UIMemoryFrameBuffer(SIZE, SIZE);
+    SharedPointer<FrameBuffer> secondCanvas(secondBuffer);
+
+    secondView->fillFrameBuffer(secondCanvas, 0, 0);
+
+    check(array->hasListener(second), "second table listens to array");
+
+    UIMemoryFrameBuffer* buffer = new UIMemoryFrameBuffer(SIZE, SIZE);
+    UIMemoryFrameBuffer* before = new UIMemoryFrameBuffer(SIZE, SIZE);
+    SharedPointer<FrameBuffer> canvas(buffer);
+    SharedPointer<FrameBuffer> beforeCanvas(before);
+
+    view->fillFrameBuffer(canvas, 0, 0);
+    table->setPixels(-500);
+    view->fillFrameBuffer(canvas, 0, 0);
+    view->clearDirty();
+
+    /* insert above the screen */
+    uint32_t top = table->getFirstIndex();
+    uint32_t overflow = table->getFirstOverflow();
+    SharedPointer<UIView> topCell = table->getCellCache().peek(top);
+
+    view->fillFrameBuffer(beforeCanvas, 0, 0);
+    view->clearDirty();
+
+    ids->insert(5, 3);
+
+    bool dirty = view->isDirty();
+
+    created = 0;
+    uint32_t lines = table->getRenderedLines();
+    view->fillFrameBuffer(canvas, 0, 0);
+    view->clearDirty();
+
+    printf("rowchanges: insert above: top %lu -> %lu created: %lu lines drawn: %lu\r\n",
+           (unsigned long) top,
+           (unsigned long) table->getFirstIndex(),
+           (unsigned long) created,
+           (unsigned long) (table->getRenderedLines() - lines));
+
+    check(table->getFirstIndex() == top + 3, "insert above moves top row");
+    check(table->getFirstOverflow() == overflow, "insert above keeps overflow");
+    check(table->getCellCache().peek(top + 3) == topCell, "insert above moves cached cell");
+    check(!dirty, "insert above leaves table clean");
+    check(created == 0, "insert above fetches nothing");
+    check(table->getRenderedLines() == lines, "insert above draws nothing");
+    check(samePixels(buffer, before), "insert above keeps pixels");
+    check(matchesNewTable(array, table, buffer), "insert above pixels");
+
+    /* delete above the screen */
+    top = table->getFirstIndex();
+    created = 0;
+    lines = table->getRenderedLines();
+
+    ids->remove(2, 4);
+    view->fillFrameBuffer(canvas, 0, 0);
+    view->clearDirty();
+
+    check(table->getFirstIndex() == top - 4, "delete above moves top row");
+    check(created == 0, "delete above fetches nothing");
+    check(table->getRenderedLines() == lines, "delete above draws nothing");
+    check(samePixels(buffer, before), "delete above keeps pixels");
+    check(matchesNewTable(array, table, buffer), "delete above pixels");
+
+    /* insert on screen, only the new rows are fetched */
+    top = table->getFirstIndex();
+    created = 0;
+
+    ids->insert(top + 2, 2);
+    check(view->isDirty(), "insert on screen marks table");
+    view->fillFrameBuffer(canvas, 0, 0);
+    view->clearDirty();
+
+    check(created == 2, "insert on screen fetches new rows");
+    check(matchesNewTable(array, table, buffer), "insert on screen pixels");
+
+    /* update a row on screen, possibly changing its height */
+    created = 0;
+
+    ids->update(top + 1);
+    view->fillFrameBuffer(canvas, 0, 0);
+    view->clearDirty();
+
+    check(created == 1, "update fetches the row");
+    check(matchesNewTable(array, table, buffer), "update pixels");
+
+    /* delete the top row */
+    ids->remove(top - 1, 3);
+    view->fillFrameBuffer(canvas, 0, 0);
+    view->clearDirty();
+
+    check(table->getFirstIndex() == top - 1, "delete top row shows the next");
+    check(matchesNewTable(array, table, buffer), "delete top row pixels");
+
+    /* delete at the end while showing the last rows */
+    table->setPixels(-100000);
+    view->fillFrameBuffer(canvas, 0, 0);
+    view->clearDirty();
+
+    ids->remove(ids->getSize() - 10, 10);
+    view->fillFrameBuffer(canvas, 0, 0);
+    view->clearDirty();
+
+    check(table->getLastIndex() == ids->getSize() - 1, "delete at end keeps table full");
+    check(matchesNewTable(array, table, buffer), "delete at end pixels");
+    check(cacheMatches(table, ids), "cells with their rows");
+
+    second->setPixels(table->getPixels());
+    secondView->fillFrameBuffer(secondCanvas, 0, 0);
+
+    check(cacheMatches(second, ids), "second table cells with their rows");
+    check(samePixels(buffer, secondBuffer), "second table pixels");
+
+    secondView = SharedPointer<UIView>();
+
+    check(array->hasListener(table), "first table still listens");
+    ids->update(0);
+}
+
+/*  Listeners are unlinked by whichever of the two is destroyed first, and
+    copies of an array or a listener are not registered.
+*/
+class CountingListener : public UIView::Array::Listener
+{
+public:
+    CountingListener() : changes(0) { }
+
+    virtual void rowsInserted(uint32_t, uint32_t) { changes++; }
+    virtual void rowsDeleted(uint32_t, uint32_t) { changes++; }
+    virtual void rowsUpdated(uint32_t, uint32_t) { changes++; }
+
+    uint32_t changes;
+};
+
+static void testListeners(void)
+{
+    CountingListener first;
+    CountingListener* second = new CountingListener();
+
+    {
+        IdArray ids;
+
+        ids.addListener(&first);
+        ids.addListener(second);
+        ids.addListener(second);
+
+        IdArray copy(ids);
+        CountingListener listenerCopy(first);
+
+        check(!copy.hasListener(&first), "array copy has no listeners");
+        check(!ids.hasListener(&listenerCopy), "listener copy is not registered");
+
+        ids.update(0);
+        check((first.changes == 1) && (second->changes == 1), "both listeners told once");
+
+        /* a dangling node would be called here */
+        delete second;
+
+        ids.update(0);
+        check(first.changes == 2, "remaining listener still told");
+    }
+
+    /* the array is gone, the listener may join another one */
+    IdArray other;
+
+    other.addListener(&first);
+    check(other.hasListener(&first), "listener moves to another array");
+
+    other.removeListener(&first);
+    check(!other.hasListener(&first), "listener removed");
+}
+
+static void testRandomChanges(void)
+{
+    IdArray* ids = new IdArray();
+    SharedPointer<UIView::Array> array(ids);
+    UITableView* table = new UITableView(array, 24, 2);
+    SharedPointer<UIView> view(table);
+
+    UIMemoryFrameBuffer* buffer = new UIMemoryFrameBuffer(SIZE, SIZE);
+    SharedPointer<FrameBuffer> canvas(buffer);
+
+    uint32_t seed = 4321;
+    uint32_t errors = 0;
+    uint32_t fetched = 0;
+
+    for (uint32_t step = 0; step < 500; step++)
+    {
+        seed = seed * 1103515245 + 12345;
+        uint32_t random = seed >> 8;
+        uint32_t size = ids->getSize();
+        uint32_t row = random % size;
+        uint32_t count = 1 + (random >> 8) % 4;
+
+        switch ((random >> 12) % 4)
+        {
+            case 0:
+                ids->insert(row, count);
+                break;
+            case 1:
+                if (size > 40)
+                {
+                    ids->remove(row, (row + count <= size) ? count : size - row);
+                }
+                break;
+            case 2:
+                ids->update(row);
+                break;
+            default:
+                table->scrollPx(-((int32_t) ((random >> 16) % 64)) + 24);
+                break;
+        }
+
+        created = 0;
+        view->fillFrameBuffer(canvas, 0, 0);
+        view->clearDirty();
+        fetched += created;
+
+        errors += cacheMatches(table, ids) ? 0 : 1;
+
+        if ((step % 50) == 0)
+        {
+            errors += matchesNewTable(array, table, buffer) ? 0 : 1;
+        }
+    }
+
+    printf("rowchanges: random: rows: %lu fetched in 500 steps: %lu errors: %lu\r\n",
+           (unsigned long) ids->getSize(),
+           (unsigned long) fetched,
+           (unsigned long) errors);
+
+    check(errors == 0, "random changes");
+}
+
+void app_start(int, char *[])
+{
+    testChanges();
+    testRandomChanges();
+    testListeners();
+
+    finish();
+}
+
+#else
+
+void app_start(int, char *[])
+{
+    /* host only */
+}
+
+#endif // UIF_HOST
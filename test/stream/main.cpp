@@ -0,0 +1,259 @@
+/* mbed
+ * Copyright (c) 2006-2015 ARM Limited
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+/*  Stream test: a table scrolls through a file of a million records read
+    through UIStreamArray. Records must read back exactly, in any order,
+    and the heap must not grow with the distance scrolled. Prints the index
+    size and the block reads per frame.
+*/
+
+#include "UIFramework/UIPlatform.h"
+
+#if UIF_HOST
+
+#include "UIFramework/UIFileSource.h"
+#include "UIFramework/UIMemoryFrameBuffer.h"
+#include "UIFramework/UIStreamArray.h"
+#include "UIFramework/UITableView.h"
+#include "UIFramework/UITextView.h"
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <new>
+
+#define TEST_NAME "stream"
+#include "test/UITest.h"
+
+#define RECORDS 1000000
+#define ROW_HEIGHT 16
+#define SIZE 128
+#define RECORD_LENGTH 64
+#define WARMUP_FRAMES 50
+#define JUMP_ROWS 997
+#define TOLERANCE_BYTES 4096
+
+/*  Track the bytes allocated through new, with the size kept in front of
+    each allocation.
+*/
+#define HEADER 16
+
+static uint32_t liveBytes = 0;
+
+void* operator new(size_t size)
+{
+    uint8_t* pointer = (uint8_t*) malloc(size + HEADER);
+
+    if (pointer == NULL)
+    {
+        throw std::bad_alloc();
+    }
+
+    *(size_t*) pointer = size;
+    liveBytes += size;
+
+    return pointer + HEADER;
+}
+
+void* operator new[](size_t size)
+{
+    return operator new(size);
+}
+
+void operator delete(void* pointer) throw()
+{
+    if (pointer != NULL)
+    {
+        uint8_t* block = (uint8_t*) pointer - HEADER;
+
+        liveBytes -= *(size_t*) block;
+        free(block);
+    }
+}
+
+void operator delete[](void* pointer) throw()
+{
+    operator delete(pointer);
+}
+
+void operator delete(void* pointer, size_t) throw()
+{
+    operator delete(pointer);
+}
+
+void operator delete[](void* pointer, size_t) throw()
+{
+    operator delete(pointer);
+}
+
+/*  Records vary in length, some end in "\r\n", and a few are longer than
+    the record buffer.
+*/
+static void formatRecord(uint32_t record, char* buffer)
+{
+    uint32_t padding = (record % 97 == 0) ? 80 : record % 23;
+    uint32_t length = sprintf(buffer, "%07lu message", (unsigned long) record);
+
+    for (uint32_t idx = 0; idx < padding; idx++)
+    {
+        buffer[length++] = 'a' + (idx % 26);
+    }
+
+    buffer[length] = '\0';
+}
+
+static FILE* writeRecords(void)
+{
+    FILE* file = tmpfile();
+    char buffer[128];
+
+    for (uint32_t record = 0; record < RECORDS; record++)
+    {
+        formatRecord(record, buffer);
+        fputs(buffer, file);
+        fputs((record % 1000 == 0) ? "\r\n" : "\n", file);
+    }
+
+    return file;
+}
+
+static bool readsBack(UIStreamArray* array, uint32_t record)
+{
+    char expected[128];
+    char actual[RECORD_LENGTH];
+
+    formatRecord(record, expected);
+    expected[RECORD_LENGTH - 1] = '\0';
+
+    array->getRecord(record, actual, sizeof(actual));
+
+    return (strcmp(expected, actual) == 0);
+}
+
+static void testRecords(UIStreamArray* array)
+{
+    bool sequential = true;
+    bool random = true;
+
+    for (uint32_t record = 0; record < 5000; record++)
+    {
+        sequential = sequential && readsBack(array, record);
+    }
+
+    uint32_t scanned = array->getScannedRecords();
+    uint32_t seed = 12345;
+
+    for (uint32_t lookup = 0; lookup < 1000; lookup++)
+    {
+        seed = seed * 1103515245 + 12345;
+
+        random = random && readsBack(array, (seed >> 8) % RECORDS);
+    }
+
+    scanned = array->getScannedRecords() - scanned;
+
+    printf("stream: records: %lu index bytes: %lu scanned per random lookup: %lu\r\n",
+           (unsigned long) array->getSize(),
+           (unsigned long) array->getIndexBytes(),
+           (unsigned long) (scanned / 1000));
+
+    check(array->getSize() == RECORDS, "record count");
+    check(array->getIndexBytes() == ((RECORDS + DEFAULT_STREAM_INDEX_STRIDE - 1) / DEFAULT_STREAM_INDEX_STRIDE) * 4, "index size");
+    check(sequential, "sequential records");
+    check(random, "random records");
+    check(readsBack(array, RECORDS - 1), "last record");
+    check(scanned < 1000 * DEFAULT_STREAM_INDEX_STRIDE, "lookups bounded by stride");
+}
+
+static void testTable(SharedPointer<UIView::Array>& array, UIStreamArray* stream)
+{
+    UITableView* table = new UITableView(array);
+    SharedPointer<UIView> view(table);
+
+    UIMemoryFrameBuffer* buffer = new UIMemoryFrameBuffer(SIZE, SIZE);
+    SharedPointer<FrameBuffer> canvas(buffer);
+
+    uint32_t warmupPeak = 0;
+    uint32_t peak = 0;
+    uint32_t frames = 0;
+    uint32_t reads = stream->getBlockReads();
+
+    /*  Jump most of a thousand rows per frame, with a few frames of smooth
+        scrolling after each jump, until the end of the file.
+    */
+    while (table->getLastIndex() < RECORDS - 1)
+    {
+        int32_t step = ((frames % 8) == 0) ? JUMP_ROWS * ROW_HEIGHT : 5;
+
+        table->scrollPx(-step);
+        view->fillFrameBuffer(canvas, 0, 0);
+        view->clearDirty();
+        minar::Scheduler::runUntil(minar::platform::getTime() + 16000);
+
+        if (frames < WARMUP_FRAMES)
+        {
+            warmupPeak = (liveBytes > warmupPeak) ? liveBytes : warmupPeak;
+        }
+        else
+        {
+            peak = (liveBytes > peak) ? liveBytes : peak;
+        }
+
+        frames++;
+
+        if (frames > 20000)
+        {
+            break;
+        }
+    }
+
+    reads = stream->getBlockReads() - reads;
+
+    printf("stream: frames: %lu last row: %lu heap after warmup: %lu peak: %lu block reads per frame: %lu\r\n",
+           (unsigned long) frames,
+           (unsigned long) table->getLastIndex(),
+           (unsigned long) warmupPeak,
+           (unsigned long) peak,
+           (unsigned long) (reads / frames));
+
+    check(table->getLastIndex() == RECORDS - 1, "scrolled to the end");
+    check(peak <= warmupPeak + TOLERANCE_BYTES, "heap constant while scrolling");
+}
+
+void app_start(int, char *[])
+{
+    UIFileSource* file = new UIFileSource(writeRecords());
+    SharedPointer<UIStreamArray::Source> source(file);
+
+    UIStreamArray* stream = new UIStreamArray(source, &Font_Menu, ROW_HEIGHT, SIZE, "Log");
+    SharedPointer<UIView::Array> array(stream);
+
+    check(file->isOpen(), "file open");
+
+    testRecords(stream);
+    testTable(array, stream);
+
+    finish();
+}
+
+#else
+
+void app_start(int, char *[])
+{
+    /* host only */
+}
+
+#endif // UIF_HOST
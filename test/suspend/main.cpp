@@ -0,0 +1,306 @@
+/* mbed
+ * Copyright (c) 2006-2015 ARM Limited
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+/*  Suspend test: cells that tick on their own, like an animation or a
+    clock, must stop once they scroll out of a table, start again when they
+    scroll back, and all stop while the table itself is suspended or covered
+    by another view in a stack. Prints the wakeups per minute in each case.
+    Text views must draw the same after their bitmap was released by suspend.
+*/
+
+#include "UIFramework/UIPlatform.h"
+
+#if UIF_HOST
+
+#include "UIFramework/UIMemoryFrameBuffer.h"
+#include "UIFramework/UITableView.h"
+#include "UIFramework/UITextView.h"
+#include "UIFramework/UIViewStack.h"
+
+#include <stdio.h>
+
+#define TEST_NAME "suspend"
+#include "test/UITest.h"
+
+#define ROWS 60
+#define ROW_HEIGHT 20
+#define SIZE 128
+#define VISIBLE_ROWS ((SIZE + ROW_HEIGHT - 1) / ROW_HEIGHT)
+#define TICK_MS 250
+#define MINUTE_US 60000000
+
+static uint32_t wakeups = 0;
+static uint32_t ticking = 0;
+
+/*  Asks for a redraw every TICK_MS while not suspended.
+*/
+class TickerView : public UIView
+{
+public:
+    TickerView()
+        :   UIView(),
+            handle(NULL)
+    {
+        start();
+    }
+
+    virtual ~TickerView()
+    {
+        stop();
+    }
+
+    virtual uint32_t fillFrameBuffer(SharedPointer<FrameBuffer>& canvas, int16_t xOffset, int16_t yOffset)
+    {
+        (void) xOffset;
+        (void) yOffset;
+
+        canvas->drawRectangle(0, canvas->getWidth(), 0, canvas->getHeight(), 0);
+
+        return UINT32_MAX;
+    }
+
+    virtual void suspend(void)
+    {
+        stop();
+    }
+
+    virtual void resume(void)
+    {
+        start();
+    }
+
+private:
+    void tick(void)
+    {
+        wakeups++;
+        markDirty();
+    }
+
+    void start(void)
+    {
+        if (handle == NULL)
+        {
+            handle = minar::Scheduler::postCallback(this, &TickerView::tick)
+                        .period(minar::milliseconds(TICK_MS))
+                        .getHandle();
+            ticking++;
+        }
+    }
+
+    void stop(void)
+    {
+        if (handle != NULL)
+        {
+            minar::Scheduler::cancelCallback(handle);
+            handle = NULL;
+            ticking--;
+        }
+    }
+
+    minar::callback_handle_t handle;
+};
+
+class TickerArray : public UITestArray
+{
+public:
+    TickerArray()
+        :   UITestArray("Ticker", ROWS, ROW_HEIGHT, SIZE)
+    {}
+
+    virtual SharedPointer<UIView> viewAtIndex(uint32_t index) const
+    {
+        (void) index;
+
+        return SharedPointer<UIView>(new TickerView());
+    }
+};
+
+static uint32_t wakeupsPerMinute(void)
+{
+    uint32_t before = wakeups;
+
+    minar::Scheduler::runUntil(minar::platform::getTime() + MINUTE_US);
+
+    return wakeups - before;
+}
+
+static void testTable(void)
+{
+    SharedPointer<UIView::Array> array(new TickerArray());
+    UITableView* table = new UITableView(array);
+    SharedPointer<UIView> view(table);
+
+    UIMemoryFrameBuffer* buffer = new UIMemoryFrameBuffer(SIZE, SIZE);
+    SharedPointer<FrameBuffer> canvas(buffer);
+
+    view->fillFrameBuffer(canvas, 0, 0);
+
+    uint32_t top = wakeupsPerMinute();
+
+    /* scroll three screens down, a few pixels per frame */
+    for (uint32_t frame = 0; frame < (3 * SIZE) / 4; frame++)
+    {
+        table->scrollPx(-4);
+        view->fillFrameBuffer(canvas, 0, 0);
+        minar::Scheduler::runUntil(minar::platform::getTime() + 16000);
+    }
+
+    uint32_t cached = 0;
+
+    for (uint32_t slot = 0; slot < table->getCellCache().getSize(); slot++)
+    {
+        cached += (table->getCellCache().getSlot(slot) != NULL) ? 1 : 0;
+    }
+
+    uint32_t scrolled = wakeupsPerMinute();
+    uint32_t active = ticking;
+    uint32_t shown = table->getLastIndex() - table->getFirstIndex() + 1;
+
+    view->suspend();
+
+    uint32_t suspended = wakeupsPerMinute();
+
+    view->resume();
+    view->fillFrameBuffer(canvas, 0, 0);
+
+    uint32_t resumed = wakeupsPerMinute();
+
+    printf("suspend: wakeups per minute: top: %lu scrolled: %lu suspended: %lu resumed: %lu\r\n",
+           (unsigned long) top,
+           (unsigned long) scrolled,
+           (unsigned long) suspended,
+           (unsigned long) resumed);
+    printf("suspend: cells cached: %lu ticking: %lu visible: %lu\r\n",
+           (unsigned long) cached,
+           (unsigned long) active,
+           (unsigned long) shown);
+
+    /* only the visible rows tick, not the prefetched or pooled ones */
+    uint32_t limit = shown * (60000 / TICK_MS);
+
+    check(cached > shown + 2, "cache holds hidden rows");
+    check(active == shown, "hidden cells suspended");
+    check(scrolled <= limit, "hidden cells quiet");
+    check(suspended == 0, "table suspended");
+    check(resumed >= VISIBLE_ROWS * (60000 / TICK_MS), "visible cells resumed");
+}
+
+/*  Draw the stack until its transition is over.
+*/
+static void runTransition(SharedPointer<UIView>& stack, SharedPointer<FrameBuffer>& canvas)
+{
+    for (uint32_t frame = 0; frame < 30; frame++)
+    {
+        stack->fillFrameBuffer(canvas, 0, 0);
+        minar::Scheduler::runUntil(minar::platform::getTime() + 16000);
+    }
+}
+
+/*  A table pushed under another view is drawn during the transition, which
+    resumes its visible cells. They must be quiet again once it is over.
+*/
+static void testStack(void)
+{
+    uint32_t before = ticking;
+
+    SharedPointer<UIView::Array> array(new TickerArray());
+    SharedPointer<UIView> table(new UITableView(array));
+    SharedPointer<UIView> text(new UITextView("Details", &Font_Menu));
+
+    UIViewStack* stack = new UIViewStack();
+    SharedPointer<UIView> view(stack);
+
+    view->setWidth(SIZE);
+    view->setHeight(SIZE);
+
+    UIMemoryFrameBuffer* buffer = new UIMemoryFrameBuffer(SIZE, SIZE);
+    SharedPointer<FrameBuffer> canvas(buffer);
+
+    stack->pushView(table);
+    view->fillFrameBuffer(canvas, 0, 0);
+
+    uint32_t shown = ticking - before;
+
+    stack->pushView(text);
+    runTransition(view, canvas);
+
+    uint32_t pushed = ticking - before;
+
+    stack->popView();
+    runTransition(view, canvas);
+
+    uint32_t popped = ticking - before;
+
+    printf("suspend: stack: ticking: shown: %lu pushed: %lu popped: %lu\r\n",
+           (unsigned long) shown,
+           (unsigned long) pushed,
+           (unsigned long) popped);
+
+    check(shown > 0, "table in stack ticks");
+    check(pushed == 0, "table under pushed view suspended");
+    check(popped == shown, "table resumed after pop");
+}
+
+static bool samePixels(UIMemoryFrameBuffer* a, UIMemoryFrameBuffer* b)
+{
+    for (uint16_t y = 0; y < SIZE; y++)
+    {
+        for (uint16_t x = 0; x < SIZE; x++)
+        {
+            if (a->getPixel(x, y) != b->getPixel(x, y))
+            {
+                return false;
+            }
+        }
+    }
+
+    return true;
+}
+
+static void testText(void)
+{
+    SharedPointer<UIView> text(new UITextView("Suspended", &Font_Menu));
+
+    UIMemoryFrameBuffer* before = new UIMemoryFrameBuffer(SIZE, SIZE);
+    UIMemoryFrameBuffer* after = new UIMemoryFrameBuffer(SIZE, SIZE);
+    SharedPointer<FrameBuffer> beforeCanvas(before);
+    SharedPointer<FrameBuffer> afterCanvas(after);
+
+    text->fillFrameBuffer(beforeCanvas, 0, 0);
+    text->suspend();
+    text->resume();
+    text->fillFrameBuffer(afterCanvas, 0, 0);
+
+    check(samePixels(before, after), "text drawn after suspend");
+}
+
+void app_start(int, char *[])
+{
+    testTable();
+    testStack();
+    testText();
+
+    finish();
+}
+
+#else
+
+void app_start(int, char *[])
+{
+    /* host only */
+}
+
+#endif // UIF_HOST
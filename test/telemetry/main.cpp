@@ -0,0 +1,327 @@
+/* mbed
+ * Copyright (c) 2006-2015 ARM Limited
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+/*  Telemetry test: frames are classified as unchanged, coalesced or
+    dropped, and their times land in the right histogram buckets. The
+    counters are checked directly on UIFrameTelemetry, then through
+    UIFramework on the host display with views of known render time.
+*/
+
+#include "UIFramework/UIPlatform.h"
+
+#if UIF_HOST
+
+#include "UIFramework/UIFramework.h"
+#include "UIFramework/UIFrameTelemetry.h"
+#include "UIFramework/host/UIHostDisplay.h"
+
+#include <stdio.h>
+
+#define TEST_NAME "telemetry"
+#include "test/UITest.h"
+
+#define SIZE 128
+#define LINE_TIME_US 100
+#define RENDER_TIME_US 5000
+#define ANIMATION_MS 20
+#define BLOCKED_MS 200
+
+static UIFrameTelemetry::frame_t makeFrame(uint32_t renderTime, uint32_t transferTime, uint8_t flags)
+{
+    UIFrameTelemetry::frame_t frame;
+
+    frame.sequence = 0;
+    frame.renderTime = renderTime;
+    frame.transferTime = transferTime;
+    frame.latency = renderTime + transferTime;
+    frame.callInterval = UINT32_MAX;
+    frame.wakeups = 1;
+    frame.flags = flags;
+
+    return frame;
+}
+
+/*  Bucket n counts values below (1 << n) ms, from (1 << (n - 1)) ms up.
+*/
+static void testHistogram(void)
+{
+    UIFrameTelemetry telemetry;
+
+    static const uint32_t times[] = { 0, 999, 1000, 1999, 2000, 5000, 3000000 };
+    static const uint32_t buckets[] = { 0, 0, 1, 1, 2, 3, TELEMETRY_HISTOGRAM_BUCKETS - 1 };
+
+    for (uint32_t idx = 0; idx < sizeof(times) / sizeof(times[0]); idx++)
+    {
+        UIFrameTelemetry::frame_t frame = makeFrame(times[idx], 0, 0);
+
+        telemetry.addFrame(frame);
+    }
+
+    bool placed = true;
+
+    for (uint32_t bucket = 0; bucket < TELEMETRY_HISTOGRAM_BUCKETS; bucket++)
+    {
+        uint32_t expected = 0;
+
+        for (uint32_t idx = 0; idx < sizeof(buckets) / sizeof(buckets[0]); idx++)
+        {
+            expected += (buckets[idx] == bucket) ? 1 : 0;
+        }
+
+        placed = placed && (telemetry.getHistogram(UIFrameTelemetry::HISTOGRAM_RENDER, bucket) == expected);
+    }
+
+    check(placed, "render times bucketed");
+    check(telemetry.getMaximum(UIFrameTelemetry::HISTOGRAM_RENDER) == 3000000, "render maximum");
+    check(telemetry.getHistogram(UIFrameTelemetry::HISTOGRAM_RENDER, TELEMETRY_HISTOGRAM_BUCKETS) == 0, "bucket out of range");
+
+    /* unchanged frames are not transferred */
+    UIFrameTelemetry::frame_t sent = makeFrame(0, 12000, 0);
+    UIFrameTelemetry::frame_t unchanged = makeFrame(0, 50000, UIFrameTelemetry::FRAME_UNCHANGED);
+
+    telemetry.reset();
+    telemetry.addFrame(sent);
+    telemetry.addFrame(unchanged);
+
+    check(telemetry.getHistogram(UIFrameTelemetry::HISTOGRAM_TRANSFER, 4) == 1, "transfer bucketed");
+    check(telemetry.getHistogram(UIFrameTelemetry::HISTOGRAM_TRANSFER, 6) == 0, "unchanged not in transfer");
+    check(telemetry.getMaximum(UIFrameTelemetry::HISTOGRAM_TRANSFER) == 12000, "transfer maximum");
+    check(telemetry.getMaximum(UIFrameTelemetry::HISTOGRAM_LATENCY) == 50000, "latency maximum");
+}
+
+static void testCounters(void)
+{
+    UIFrameTelemetry telemetry;
+
+    static const uint8_t flags[] = {
+        0,
+        UIFrameTelemetry::FRAME_COALESCED,
+        UIFrameTelemetry::FRAME_DROPPED | UIFrameTelemetry::FRAME_COALESCED,
+        UIFrameTelemetry::FRAME_UNCHANGED,
+        UIFrameTelemetry::FRAME_DROPPED
+    };
+
+    for (uint32_t idx = 0; idx < sizeof(flags) / sizeof(flags[0]); idx++)
+    {
+        UIFrameTelemetry::frame_t frame = makeFrame(1000, 1000, flags[idx]);
+
+        telemetry.addFrame(frame);
+        telemetry.addWakeup();
+    }
+
+    check(telemetry.getFrames() == 5, "frames counted");
+    check(telemetry.getCoalescedFrames() == 2, "coalesced counted");
+    check(telemetry.getDroppedFrames() == 2, "dropped counted");
+    check(telemetry.getUnchangedFrames() == 1, "unchanged counted");
+    check(telemetry.getWakeups() == 5, "wakeups counted");
+
+    telemetry.reset();
+
+    check((telemetry.getFrames() == 0) && (telemetry.getDroppedFrames() == 0), "reset counters");
+    check(telemetry.getMaximum(UIFrameTelemetry::HISTOGRAM_RENDER) == 0, "reset maximum");
+}
+
+/*  The ring keeps the last TELEMETRY_RING_SIZE frames, newest first.
+*/
+static void testRing(void)
+{
+    UIFrameTelemetry telemetry;
+    UIFrameTelemetry::frame_t frame;
+
+    check(!telemetry.getFrame(0, frame), "empty ring");
+
+    for (uint32_t idx = 0; idx < TELEMETRY_RING_SIZE + 8; idx++)
+    {
+        frame = makeFrame(idx, 0, 0);
+        telemetry.addFrame(frame);
+    }
+
+    bool ordered = true;
+
+    for (uint32_t age = 0; age < TELEMETRY_RING_SIZE; age++)
+    {
+        uint32_t sequence = TELEMETRY_RING_SIZE + 8 - 1 - age;
+
+        ordered = ordered
+               && telemetry.getFrame(age, frame)
+               && (frame.sequence == sequence)
+               && (frame.renderTime == sequence);
+    }
+
+    check(ordered, "ring wraps around");
+    check(!telemetry.getFrame(TELEMETRY_RING_SIZE, frame), "overwritten frames gone");
+}
+
+static void blockTask()
+{
+    minar::platform::advanceTime(minar::milliseconds(BLOCKED_MS));
+}
+
+/*  Fills the canvas with one color, taking RENDER_TIME_US to do so. The
+    color changes with every frame while animating. When asked, it blocks
+    the scheduler once after the frame has been sent, before the next one.
+*/
+class TimedView : public UIView
+{
+public:
+    TimedView()
+        :   UIView(),
+            color(0),
+            animating(false),
+            block(false)
+    {}
+
+    virtual uint32_t fillFrameBuffer(SharedPointer<FrameBuffer>& canvas, int16_t xOffset, int16_t yOffset)
+    {
+        (void) xOffset;
+        (void) yOffset;
+
+        if (animating)
+        {
+            color ^= 1;
+        }
+
+        canvas->drawRectangle(0, canvas->getWidth(), 0, canvas->getHeight(), color);
+
+        minar::platform::advanceTime(RENDER_TIME_US);
+
+        /* the transfer takes SIZE * LINE_TIME_US, the next frame is due ANIMATION_MS after it */
+        if (block)
+        {
+            block = false;
+
+            minar::Scheduler::postCallback(blockTask)
+                .delay(minar::milliseconds(15));
+        }
+
+        return (animating) ? ANIMATION_MS : UINT32_MAX;
+    }
+
+    uint8_t color;
+    bool animating;
+    bool block;
+};
+
+static UIHostDisplay display;
+
+static void run(uint32_t milliseconds)
+{
+    minar::Scheduler::runUntil(minar::platform::getTime() + minar::milliseconds(milliseconds));
+}
+
+static void testFramework(void)
+{
+    TimedView* timed = new TimedView();
+    SharedPointer<UIView> view(timed);
+
+    view->setWidth(SIZE);
+    view->setHeight(SIZE);
+
+    display.setLineTime(LINE_TIME_US);
+
+    UIFramework* framework = new UIFramework(display, view);
+    SharedPointer<UIFramework> owner(framework);
+
+    framework->setDirtyLineTracking(true);
+
+    const UIFrameTelemetry& telemetry = framework->getTelemetry();
+    UIFrameTelemetry::frame_t frame;
+
+    /* first frame */
+    run(100);
+
+    check(telemetry.getFrames() == 1, "first frame");
+
+    /* three wakeups for an unchanged view, served by one frame */
+    framework->wakeupTask();
+    framework->wakeupTask();
+    framework->wakeupTask();
+    run(100);
+
+    check(telemetry.getFrames() == 2, "one frame for three wakeups");
+    check(telemetry.getFrame(0, frame) && (frame.wakeups == 3), "wakeups recorded");
+    check(frame.flags == (UIFrameTelemetry::FRAME_COALESCED | UIFrameTelemetry::FRAME_UNCHANGED), "coalesced and unchanged");
+
+    /* animate, with the scheduler blocked once in the middle */
+    timed->animating = true;
+    framework->wakeupTask();
+    run(10 * ANIMATION_MS);
+
+    uint32_t before = telemetry.getFrames();
+
+    timed->block = true;
+    run(BLOCKED_MS + 10 * ANIMATION_MS);
+
+    timed->animating = false;
+    run(10 * ANIMATION_MS);
+
+    uint32_t frames = telemetry.getFrames();
+    uint32_t unchanged = telemetry.getUnchangedFrames();
+
+    /* every frame takes RENDER_TIME_US, every changed frame sends all lines */
+    uint32_t transfer = SIZE * LINE_TIME_US;
+    uint32_t transferred = 0;
+
+    for (uint32_t bucket = 0; bucket < TELEMETRY_HISTOGRAM_BUCKETS; bucket++)
+    {
+        transferred += telemetry.getHistogram(UIFrameTelemetry::HISTOGRAM_TRANSFER, bucket);
+    }
+
+    printf("telemetry: frames: %lu animated: %lu unchanged: %lu coalesced: %lu dropped: %lu\r\n",
+           (unsigned long) frames,
+           (unsigned long) (frames - 2),
+           (unsigned long) unchanged,
+           (unsigned long) telemetry.getCoalescedFrames(),
+           (unsigned long) telemetry.getDroppedFrames());
+    printf("telemetry: max render: %lu us transfer: %lu us latency: %lu us\r\n",
+           (unsigned long) telemetry.getMaximum(UIFrameTelemetry::HISTOGRAM_RENDER),
+           (unsigned long) telemetry.getMaximum(UIFrameTelemetry::HISTOGRAM_TRANSFER),
+           (unsigned long) telemetry.getMaximum(UIFrameTelemetry::HISTOGRAM_LATENCY));
+
+    check(before > 4, "animation frames");
+    check(frames > before + 4, "animation after block");
+    check(telemetry.getDroppedFrames() == 1, "blocked frame dropped");
+    check(telemetry.getCoalescedFrames() == 1, "coalesced frame");
+    /* the repeated frame, and the first one after the animation stopped */
+    check(unchanged == 2, "unchanged frames");
+
+    /* 5 ms is in [4, 8) ms, 12.8 ms in [8, 16) ms */
+    check(telemetry.getHistogram(UIFrameTelemetry::HISTOGRAM_RENDER, 3) == frames, "render bucket");
+    check(telemetry.getHistogram(UIFrameTelemetry::HISTOGRAM_TRANSFER, 4) == frames - unchanged, "transfer bucket");
+    check(transferred == frames - unchanged, "unchanged not transferred");
+    check(telemetry.getMaximum(UIFrameTelemetry::HISTOGRAM_RENDER) >= RENDER_TIME_US, "render maximum");
+    check(telemetry.getMaximum(UIFrameTelemetry::HISTOGRAM_TRANSFER) >= transfer, "transfer maximum");
+    check(telemetry.getMaximum(UIFrameTelemetry::HISTOGRAM_LATENCY) >= RENDER_TIME_US + transfer, "latency maximum");
+}
+
+void app_start(int, char *[])
+{
+    testHistogram();
+    testCounters();
+    testRing();
+    testFramework();
+
+    finish();
+}
+
+#else
+
+void app_start(int, char *[])
+{
+    /* host only */
+}
+
+#endif // UIF_HOST
@@ -15,6 +15,10 @@
  */
 
 
+#include "UIFramework/UIPlatform.h"
+
+#if !UIF_HOST
+
 #include "mbed-drivers/mbed.h"
 
 #include "UIFramework/UIFramework.h"
@@ -52,3 +56,12 @@ void app_start(int, char *[])
 
     uiFramework = SharedPointer<UIFramework>(new UIFramework(lcd, view));
 }
+
+#else
+
+void app_start(int, char *[])
+{
+    /* requires the LCD and the mbed scheduler */
+}
+
+#endif // !UIF_HOST